@@ -87,6 +87,7 @@ LOCAL_C_INCLUDES := \
 	external/icu4c/common \
 	external/icu4c/i18n \
 	external/jpeg \
+	external/libpng \
 	external/libxml2/include \
 	external/libxslt \
 	external/hyphenation \
@@ -102,6 +103,7 @@ LOCAL_C_INCLUDES := \
 	external/skia/src/images \
 	external/skia/src/ports \
 	external/sqlite/dist \
+	external/webp/include \
 	frameworks/base/core/jni/android/graphics \
 	frameworks/base/include
 
@@ -310,6 +312,7 @@ LOCAL_SHARED_LIBRARIES := \
 	libgui \
 	libicuuc \
 	libicui18n \
+	libjpeg \
 	liblog \
 	libmedia \
 	libnativehelper \
@@ -336,7 +339,7 @@ LOCAL_CFLAGS += -DSUPPORT_COMPLEX_SCRIPTS=1
 endif
 
 # Build the list of static libraries
-LOCAL_STATIC_LIBRARIES := libxml2 libxslt libhyphenation libv8
+LOCAL_STATIC_LIBRARIES := libxml2 libxslt libhyphenation libv8 libpng libwebp-decode
 
 ifeq ($(ENABLE_AUTOFILL),true)
 LOCAL_SHARED_LIBRARIES += libexpat
@@ -413,3 +416,6 @@ include $(WEBKIT_PATH)/android/wds/client/Android.mk
 
 # Build the webkit merge tool.
 include $(BASE_PATH)/Tools/android/webkitmerge/Android.mk
+
+# Build the MemoryCache trace simulator.
+include $(BASE_PATH)/Tools/android/memorycachesim/Android.mk
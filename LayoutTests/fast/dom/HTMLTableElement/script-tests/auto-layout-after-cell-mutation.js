@@ -0,0 +1,76 @@
+description('Tests that the column widths of an auto layout table are the same after a cell is changed as when the changed table is laid out from scratch.');
+
+var tables = [
+    '<tr><td>a</td><td>bb</td><td>ccc</td></tr><tr><td>dddd</td><td>e</td><td>ff</td></tr>',
+    '<tr><td>a</td><td colspan="2">bb cc</td></tr><tr><td>dddd</td><td>e</td><td>ff</td></tr>',
+    '<tr><td style="width: 30%">a</td><td>bb</td><td>ccc</td></tr><tr><td>dddd</td><td>e</td><td>ff</td></tr>'
+];
+
+// Each mutation is applied once to a table that was laid out before, and once
+// to the same table before it is first laid out.
+var mutations = [
+    function(table) { table.rows[0].cells[0].firstChild.data = 'a much longer first cell'; },
+    function(table) { table.rows[1].cells[0].firstChild.data = 'd'; },
+    function(table) { table.rows[0].cells[1].innerHTML = '<div style="width: 120px"></div>'; },
+    function(table) { table.rows[1].cells[1].style.width = '50%'; },
+    function(table) { table.rows[1].cells[2].style.width = '90px'; },
+    function(table) { table.rows[0].cells[0].style.whiteSpace = 'nowrap'; table.rows[0].cells[0].firstChild.data = 'no wrap here'; },
+    function(table) { table.rows[0].cells[0].firstChild.data = ''; }
+];
+
+var container = document.createElement('div');
+document.body.appendChild(container);
+
+function createTable(html, width)
+{
+    var table = document.createElement('table');
+    table.innerHTML = html;
+    if (width)
+        table.style.width = width;
+    return table;
+}
+
+function columnWidths(table)
+{
+    var widths = [table.offsetWidth];
+    for (var r = 0; r < table.rows.length; ++r) {
+        for (var c = 0; c < table.rows[r].cells.length; ++c)
+            widths.push(table.rows[r].cells[c].offsetWidth);
+    }
+    return widths.join(',');
+}
+
+var incremental;
+var fresh;
+
+function check(html, width, mutate)
+{
+    container.innerHTML = '';
+    var table = createTable(html, width);
+    container.appendChild(table);
+    table.offsetWidth;
+    mutate(table);
+    incremental = columnWidths(table);
+
+    container.innerHTML = '';
+    table = createTable(html, width);
+    mutate(table);
+    container.appendChild(table);
+    fresh = columnWidths(table);
+
+    shouldBe('incremental', 'fresh');
+}
+
+var widths = ['', '200px', '600px'];
+for (var t = 0; t < tables.length; ++t) {
+    for (var w = 0; w < widths.length; ++w) {
+        debug('Table ' + t + (widths[w] ? ' at ' + widths[w] : ' at its preferred width') + ':');
+        for (var m = 0; m < mutations.length; ++m)
+            check(tables[t], widths[w], mutations[m]);
+        debug('');
+    }
+}
+
+document.body.removeChild(container);
+
+var successfullyParsed = true;
@@ -0,0 +1,74 @@
+description('Tests that querySelector and querySelectorAll see DOM changes made between repeated queries.');
+
+var container = document.createElement('div');
+container.innerHTML = '<p class="a" id="p1"></p><div><p class="a b" id="p2"></p><span class="b" id="s1"></span></div><p id="p3"></p>';
+document.body.appendChild(container);
+var inner = container.getElementsByTagName('div')[0];
+
+function ids(list)
+{
+    var result = [];
+    for (var i = 0; i < list.length; ++i)
+        result.push(list[i].id);
+    return result.join(',');
+}
+
+// The second of two queries without a change in between may use indexes.
+function query(selector, root)
+{
+    root = root || document;
+    var first = ids(root.querySelectorAll(selector));
+    var second = ids(root.querySelectorAll(selector));
+    return first == second ? first : 'mismatch: ' + first + ' / ' + second;
+}
+
+function queryFirst(selector)
+{
+    var first = document.querySelector(selector);
+    var second = document.querySelector(selector);
+    if (first != second)
+        return 'mismatch';
+    return first ? first.id : 'null';
+}
+
+shouldBeEqualToString("query('.a')", "p1,p2");
+shouldBeEqualToString("query('p.b')", "p2");
+shouldBeEqualToString("query('div .b')", "p2,s1");
+shouldBeEqualToString("query('p')", "p1,p2,p3");
+shouldBeEqualToString("query('.a', inner)", "p2");
+shouldBeEqualToString("query('.missing')", "");
+shouldBeEqualToString("query('.a, span')", "p1,p2,s1");
+shouldBeEqualToString("queryFirst('.b')", "p2");
+shouldBeEqualToString("queryFirst('p')", "p1");
+
+debug('');
+debug('After changing the class of an element:');
+document.getElementById('p3').className = 'a';
+shouldBeEqualToString("query('.a')", "p1,p2,p3");
+document.getElementById('p1').className = '';
+shouldBeEqualToString("query('.a')", "p2,p3");
+shouldBeEqualToString("queryFirst('.a')", "p2");
+
+debug('');
+debug('After setting the value of an empty class attribute node:');
+document.getElementById('p1').getAttributeNode('class').value = 'a';
+shouldBeEqualToString("query('.a')", "p1,p2,p3");
+shouldBeEqualToString("queryFirst('.a')", "p1");
+
+debug('');
+debug('After adding and removing elements:');
+var added = document.createElement('p');
+added.id = 'p4';
+added.className = 'b';
+container.insertBefore(added, container.firstChild);
+shouldBeEqualToString("query('.b')", "p4,p2,s1");
+shouldBeEqualToString("queryFirst('p')", "p4");
+container.removeChild(inner);
+shouldBeEqualToString("query('.b')", "p4");
+shouldBeEqualToString("query('p')", "p4,p1,p3");
+shouldBeEqualToString("query('.b', inner)", "p2,s1");
+
+document.body.removeChild(container);
+shouldBeEqualToString("query('.b')", "");
+
+var successfullyParsed = true;
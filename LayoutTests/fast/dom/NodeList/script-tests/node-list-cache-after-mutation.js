@@ -0,0 +1,83 @@
+description('Tests that live node lists stay correct when the DOM is mutated after their length and items have been cached.');
+
+var container = document.createElement('div');
+document.body.appendChild(container);
+
+var spans = container.getElementsByTagName('span');
+var children = container.childNodes;
+shouldBe("spans.length", "0");
+shouldBe("children.length", "0");
+
+debug('');
+debug('Appending to the end of the list:');
+var first = document.createElement('span');
+container.appendChild(first);
+shouldBe("spans.length", "1");
+shouldBe("spans[0]", "first");
+shouldBe("children.length", "1");
+
+var inner = document.createElement('div');
+inner.innerHTML = '<span></span><b><span></span></b>';
+container.appendChild(inner);
+shouldBe("spans.length", "3");
+shouldBe("spans[2]", "inner.lastChild.firstChild");
+shouldBe("children.length", "2");
+
+debug('');
+debug('Appending to a child that is followed by other nodes:');
+var last = document.createElement('span');
+container.appendChild(last);
+shouldBe("spans[3]", "last");
+var middle = document.createElement('span');
+inner.appendChild(middle);
+shouldBe("spans.length", "5");
+shouldBe("spans[3]", "middle");
+shouldBe("spans[4]", "last");
+shouldBe("children.length", "3");
+
+debug('');
+debug('Inserting and removing:');
+var before = document.createElement('span');
+container.insertBefore(before, first);
+shouldBe("spans[0]", "before");
+shouldBe("spans.length", "6");
+container.removeChild(inner);
+shouldBe("spans.length", "3");
+shouldBe("spans[1]", "first");
+shouldBe("children.length", "3");
+
+debug('');
+debug('Changing text:');
+var text = document.createTextNode('text');
+container.appendChild(text);
+shouldBe("children.length", "4");
+text.data = 'changed';
+shouldBe("children.length", "4");
+shouldBe("children[3]", "text");
+
+debug('');
+debug('Changing attributes:');
+var classList = container.getElementsByClassName('a');
+var nameList = document.getElementsByName('n');
+shouldBe("classList.length", "0");
+shouldBe("nameList.length", "0");
+first.setAttribute('title', 'a');
+shouldBe("classList.length", "0");
+first.className = 'a';
+shouldBe("classList.length", "1");
+shouldBe("classList[0]", "first");
+last.className = 'b a';
+shouldBe("classList.length", "2");
+first.className = 'b';
+shouldBe("classList.length", "1");
+shouldBe("classList[0]", "last");
+first.setAttribute('name', 'm');
+shouldBe("nameList.length", "0");
+first.setAttribute('name', 'n');
+shouldBe("nameList.length", "1");
+first.removeAttribute('name');
+shouldBe("nameList.length", "0");
+
+document.body.removeChild(container);
+
+var successfullyParsed = true;
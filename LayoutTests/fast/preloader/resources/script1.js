@@ -0,0 +1,2 @@
+// Blocks the parser while the preload scanner looks ahead.
+var script1Loaded = true;
@@ -0,0 +1 @@
+var script2Loaded = true;
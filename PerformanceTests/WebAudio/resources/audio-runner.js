@@ -0,0 +1,143 @@
+// Runner for offline Web Audio rendering benchmarks.
+//
+// Each test builds a graph on an offline AudioContext, renders a fixed
+// number of seconds into an AudioBuffer as fast as possible and reports the
+// wall clock time of the render, the average time spent per 128 frame render
+// quantum and the real-time factor (seconds of audio rendered per second of
+// wall clock time). Like the parser tests, the first run is a warm-up and is
+// not counted.
+
+var sampleRate = 44100;
+var renderQuantumSize = 128;
+
+function log(text) {
+    document.getElementById("log").innerHTML += text + "\n";
+    window.scrollTo(0, document.body.height);
+}
+
+function computeAverage(values) {
+    var sum = 0;
+    for (var i = 0; i < values.length; i++)
+        sum += values[i];
+    return sum / values.length;
+}
+
+function computeMedian(values) {
+    values = values.slice(0);
+    values.sort(function(a, b) { return a - b; });
+    var len = values.length;
+    if (len % 2)
+        return values[(len-1)/2];
+    return (values[len/2-1] + values[len/2]) / 2;
+}
+
+function computeMin(values) {
+    var min = values.length ? values[0] : 0;
+    for (var i = 1; i < values.length; i++) {
+        if (min > values[i])
+            min = values[i];
+    }
+    return min;
+}
+
+function computeMax(values) {
+    var max = values.length ? values[0] : 0;
+    for (var i = 1; i < values.length; i++) {
+        if (max < values[i])
+            max = values[i];
+    }
+    return max;
+}
+
+function computeStdev(values) {
+    var average = computeAverage(values);
+    var sumOfSquaredDeviations = 0;
+    for (var i = 0; i < values.length; ++i) {
+        var deviation = values[i] - average;
+        sumOfSquaredDeviations += deviation * deviation;
+    }
+    return Math.sqrt(sumOfSquaredDeviations / values.length);
+}
+
+// Returns a buffer of white noise, used as a source signal and as a synthetic
+// impulse response so that the tests do not depend on decoding audio files.
+function createNoiseBuffer(context, numberOfChannels, seconds, decay) {
+    var length = Math.floor(seconds * sampleRate);
+    var buffer = context.createBuffer(numberOfChannels, length, sampleRate);
+    for (var channel = 0; channel < numberOfChannels; ++channel) {
+        var data = buffer.getChannelData(channel);
+        for (var i = 0; i < length; ++i) {
+            var envelope = decay ? Math.pow(1 - i / length, decay) : 1;
+            data[i] = (2 * Math.random() - 1) * envelope;
+        }
+    }
+    return buffer;
+}
+
+function createLoopingSource(context, buffer) {
+    var source = context.createBufferSource();
+    source.buffer = buffer;
+    source.looping = true;
+    return source;
+}
+
+// Renders |renderSeconds| of audio |runCount| times (plus one warm-up run).
+// |buildGraph| is called with a fresh offline context for every run and must
+// connect its nodes to context.destination and schedule its sources.
+function startRendering(runCount, renderSeconds, buildGraph) {
+    var frames = Math.floor(renderSeconds * sampleRate);
+    var quanta = Math.ceil(frames / renderQuantumSize);
+    var completedRuns = -1; // Discard any runs < 0.
+    var times = [];
+
+    if (!window.webkitAudioContext) {
+        log("FAIL: webkitAudioContext is not available");
+        return;
+    }
+
+    if (window.layoutTestController) {
+        layoutTestController.dumpAsText();
+        layoutTestController.waitUntilDone();
+    }
+
+    function finish() {
+        var averageTime = computeAverage(times);
+        log("");
+        log("avg " + averageTime);
+        log("median " + computeMedian(times));
+        log("stdev " + computeStdev(times));
+        log("min " + computeMin(times));
+        log("max " + computeMax(times));
+        log("");
+        log("ms per render quantum " + (averageTime / quanta).toFixed(4));
+        log("real-time factor " + (renderSeconds * 1000 / averageTime).toFixed(2) + "x");
+        if (window.layoutTestController)
+            layoutTestController.notifyDone();
+    }
+
+    function run() {
+        var context = new webkitAudioContext(2, frames, sampleRate);
+        buildGraph(context);
+
+        var start;
+        context.oncomplete = function(event) {
+            var time = new Date() - start;
+            completedRuns++;
+            if (completedRuns <= 0)
+                log("Ignoring warm-up run (" + time + ")");
+            else {
+                times.push(time);
+                log(time);
+            }
+            if (completedRuns < runCount)
+                window.setTimeout(run, 0);
+            else
+                finish();
+        };
+        start = new Date();
+        context.startRendering();
+    }
+
+    log("Rendering " + renderSeconds + "s of audio " + runCount + " times (" + quanta + " render quanta per run)");
+    run();
+}
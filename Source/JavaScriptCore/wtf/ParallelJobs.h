@@ -0,0 +1,113 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ParallelJobs_h
+#define ParallelJobs_h
+
+#include "Assertions.h"
+#include "Noncopyable.h"
+#include "UnusedParam.h"
+#include "Vector.h"
+
+#if ENABLE(PARALLEL_JOBS)
+#include "ParallelJobsGeneric.h"
+#endif
+
+// Runs one function over a set of independent parameter blocks, spreading the
+// blocks over a small pool of worker threads. The calling thread runs the first
+// block itself and returns once every block is done, so callers can treat
+// execute() as an ordinary synchronous call.
+//
+// Usage:
+//
+//     struct RowRange {
+//         int startY;
+//         int endY;
+//     };
+//
+//     static void processRows(RowRange* range) { ... }
+//
+//     ParallelJobs<RowRange> parallelJobs(&processRows, requestedJobCount);
+//     for (size_t i = 0; i < parallelJobs.numberOfJobs(); ++i)
+//         parallelJobs.parameter(i) = ...;
+//     parallelJobs.execute();
+//
+// The requested count is clamped to the number of cores. numberOfJobs() may
+// be less than that when the pool is busy, and is always 1 when parallel jobs
+// are disabled, so the partitioning must be done after construction.
+
+namespace WTF {
+
+template<typename Type>
+class ParallelJobs {
+    WTF_MAKE_NONCOPYABLE(ParallelJobs);
+public:
+    typedef void (*WorkerFunction)(Type*);
+
+    ParallelJobs(WorkerFunction function, int requestedJobNumber)
+#if ENABLE(PARALLEL_JOBS)
+        : m_parallelEnvironment(reinterpret_cast<ParallelEnvironment::ThreadFunction>(function), sizeof(Type), requestedJobNumber)
+        , m_threadFunction(function)
+    {
+        m_parameters.grow(m_parallelEnvironment.numberOfJobs());
+    }
+#else
+        : m_threadFunction(function)
+    {
+        UNUSED_PARAM(requestedJobNumber);
+        m_parameters.grow(1);
+    }
+#endif
+
+    size_t numberOfJobs() const { return m_parameters.size(); }
+
+    Type& parameter(size_t i)
+    {
+        ASSERT(i < m_parameters.size());
+        return m_parameters[i];
+    }
+
+    void execute()
+    {
+#if ENABLE(PARALLEL_JOBS)
+        m_parallelEnvironment.execute(m_parameters.data());
+#else
+        m_threadFunction(m_parameters.data());
+#endif
+    }
+
+private:
+#if ENABLE(PARALLEL_JOBS)
+    ParallelEnvironment m_parallelEnvironment;
+#endif
+    WorkerFunction m_threadFunction;
+    Vector<Type> m_parameters;
+};
+
+} // namespace WTF
+
+using WTF::ParallelJobs;
+
+#endif // ParallelJobs_h
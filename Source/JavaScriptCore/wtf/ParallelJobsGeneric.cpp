@@ -0,0 +1,177 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#if ENABLE(PARALLEL_JOBS)
+
+#include "ParallelJobs.h"
+
+#include "StdLibExtras.h"
+#include <algorithm>
+#include <unistd.h>
+
+namespace WTF {
+
+// Only called with the thread pool mutex held.
+static int maxNumberOfParallelThreads()
+{
+    static int maxThreads = 0;
+    if (!maxThreads) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        maxThreads = cores > 0 ? static_cast<int>(cores) : 1;
+    }
+    return maxThreads;
+}
+
+static Mutex& threadPoolMutex()
+{
+    AtomicallyInitializedStatic(Mutex&, mutex = *new Mutex);
+    return mutex;
+}
+
+static Vector<RefPtr<ParallelEnvironment::ThreadPrivate> >& threadPool()
+{
+    DEFINE_STATIC_LOCAL(Vector<RefPtr<ParallelEnvironment::ThreadPrivate> >, pool, ());
+    return pool;
+}
+
+ParallelEnvironment::ParallelEnvironment(ThreadFunction threadFunction, size_t sizeOfParameter, int requestedJobNumber)
+    : m_threadFunction(threadFunction)
+    , m_sizeOfParameter(sizeOfParameter)
+{
+    MutexLocker locker(threadPoolMutex());
+
+    int maxThreads = maxNumberOfParallelThreads();
+    requestedJobNumber = std::max(1, std::min(requestedJobNumber, maxThreads));
+
+    // The calling thread always runs one of the jobs.
+    size_t maxNumberOfNewThreads = requestedJobNumber - 1;
+
+    Vector<RefPtr<ThreadPrivate> >& pool = threadPool();
+    for (int i = 0; i < maxThreads && m_threads.size() < maxNumberOfNewThreads; ++i) {
+        if (pool.size() < static_cast<size_t>(i) + 1)
+            pool.append(ThreadPrivate::create());
+
+        if (pool[i]->tryLockFor(this))
+            m_threads.append(pool[i]);
+    }
+
+    m_numberOfJobs = m_threads.size() + 1;
+}
+
+ParallelEnvironment::~ParallelEnvironment()
+{
+    for (size_t i = 0; i < m_threads.size(); ++i)
+        m_threads[i]->release(this);
+}
+
+void ParallelEnvironment::execute(void* parameters)
+{
+    unsigned char* currentParameter = static_cast<unsigned char*>(parameters);
+    size_t i;
+    for (i = 0; i < m_threads.size(); ++i) {
+        currentParameter += m_sizeOfParameter;
+        m_threads[i]->execute(m_threadFunction, currentParameter);
+    }
+
+    (*m_threadFunction)(parameters);
+
+    for (i = 0; i < m_threads.size(); ++i)
+        m_threads[i]->waitForFinish();
+}
+
+bool ParallelEnvironment::ThreadPrivate::tryLockFor(ParallelEnvironment* parent)
+{
+    if (!m_mutex.tryLock())
+        return false;
+
+    if (m_parent) {
+        m_mutex.unlock();
+        return false;
+    }
+
+    if (!m_threadID) {
+        m_threadID = createThread(&ParallelEnvironment::ThreadPrivate::workerThread, this, "WTF: ParallelJobs");
+        if (m_threadID)
+            detachThread(m_threadID);
+    }
+
+    if (m_threadID)
+        m_parent = parent;
+
+    m_mutex.unlock();
+    return m_threadID;
+}
+
+void ParallelEnvironment::ThreadPrivate::release(ParallelEnvironment* parent)
+{
+    MutexLocker lock(m_mutex);
+    ASSERT_UNUSED(parent, m_parent == parent);
+    ASSERT(!m_running);
+    m_parent = 0;
+}
+
+void ParallelEnvironment::ThreadPrivate::execute(ThreadFunction threadFunction, void* parameters)
+{
+    MutexLocker lock(m_mutex);
+
+    m_threadFunction = threadFunction;
+    m_parameters = parameters;
+    m_running = true;
+    m_threadCondition.signal();
+}
+
+void ParallelEnvironment::ThreadPrivate::waitForFinish()
+{
+    MutexLocker lock(m_mutex);
+
+    while (m_running)
+        m_threadCondition.wait(m_mutex);
+}
+
+void* ParallelEnvironment::ThreadPrivate::workerThread(void* threadData)
+{
+    // The pool keeps a reference to every thread it has started, so this
+    // object outlives the worker.
+    ThreadPrivate* sharedThread = static_cast<ThreadPrivate*>(threadData);
+    MutexLocker lock(sharedThread->m_mutex);
+
+    while (true) {
+        if (sharedThread->m_running) {
+            (*sharedThread->m_threadFunction)(sharedThread->m_parameters);
+            sharedThread->m_running = false;
+            sharedThread->m_threadCondition.signal();
+        }
+
+        sharedThread->m_threadCondition.wait(sharedThread->m_mutex);
+    }
+
+    return 0;
+}
+
+} // namespace WTF
+
+#endif // ENABLE(PARALLEL_JOBS)
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ParallelJobsGeneric_h
+#define ParallelJobsGeneric_h
+
+#if ENABLE(PARALLEL_JOBS)
+
+#include "Noncopyable.h"
+#include "RefPtr.h"
+#include "ThreadSafeRefCounted.h"
+#include "Threading.h"
+#include "Vector.h"
+
+namespace WTF {
+
+// Hands the parameter blocks of a ParallelJobs to threads borrowed from a
+// process wide pool. The threads are created on first use and then parked on
+// a condition variable, so a filter that runs every frame does not pay for
+// thread creation. A thread stays reserved by one environment until that
+// environment is destroyed; environments that find the pool busy simply get
+// fewer jobs.
+class ParallelEnvironment {
+    WTF_MAKE_NONCOPYABLE(ParallelEnvironment);
+public:
+    typedef void (*ThreadFunction)(void*);
+
+    ParallelEnvironment(ThreadFunction, size_t sizeOfParameter, int requestedJobNumber);
+    ~ParallelEnvironment();
+
+    int numberOfJobs() const { return m_numberOfJobs; }
+
+    void execute(void* parameters);
+
+    class ThreadPrivate : public ThreadSafeRefCounted<ThreadPrivate> {
+    public:
+        static PassRefPtr<ThreadPrivate> create() { return adoptRef(new ThreadPrivate); }
+
+        bool tryLockFor(ParallelEnvironment*);
+        void release(ParallelEnvironment*);
+
+        void execute(ThreadFunction, void* parameters);
+        void waitForFinish();
+
+    private:
+        ThreadPrivate()
+            : m_threadID(0)
+            , m_running(false)
+            , m_parent(0)
+            , m_threadFunction(0)
+            , m_parameters(0)
+        {
+        }
+
+        static void* workerThread(void*);
+
+        ThreadIdentifier m_threadID;
+        bool m_running;
+        ParallelEnvironment* m_parent;
+
+        Mutex m_mutex;
+        ThreadCondition m_threadCondition;
+
+        ThreadFunction m_threadFunction;
+        void* m_parameters;
+    };
+
+private:
+    ThreadFunction m_threadFunction;
+    size_t m_sizeOfParameter;
+    int m_numberOfJobs;
+
+    Vector<RefPtr<ThreadPrivate> > m_threads;
+};
+
+} // namespace WTF
+
+#endif // ENABLE(PARALLEL_JOBS)
+
+#endif // ParallelJobsGeneric_h
@@ -356,6 +356,10 @@
 #define WTF_CPU_ARM_NEON 1
 #endif
 
+#if CPU(ARM_NEON) && COMPILER(GCC) && !defined(HAVE_ARM_NEON_INTRINSICS)
+#define HAVE_ARM_NEON_INTRINSICS 1
+#endif
+
 #endif /* ARM */
 
 #if CPU(ARM) || CPU(MIPS)
@@ -686,6 +690,7 @@
 // USE defines
 #define WTF_USE_PTHREADS 1
 #define WTF_USE_SKIA 1
+#define WTF_USE_WEBP 1
 #if !defined WTF_USE_ACCELERATED_COMPOSITING
 #define WTF_USE_ACCELERATED_COMPOSITING 1
 #define ENABLE_3D_RENDERING 1
@@ -745,6 +750,9 @@
 // Enable scrollable divs in separate layers.  This might be upstreamed to
 // webkit.org but for now, it is just an Android feature.
 #define ENABLE_ANDROID_OVERFLOW_SCROLL 1
+// Run the speculative preload scanner on a background thread as soon as
+// network data arrives, rather than only when the parser blocks on a script.
+#define ENABLE_THREADED_PRELOAD_SCANNER 1
 
 // Other Android guards not present upstream
 #define ANDROID_FLATTEN_FRAMESET
@@ -778,6 +786,9 @@
 #define ANDROID_DUMP_DISPLAY_TREE
 // Animated GIF support.
 #define ANDROID_ANIMATED_GIF
+// Draw the rows of JPEG, PNG and WebP images received so far while they are
+// still downloading, using the streaming decoders in platform/image-decoders.
+#define ANDROID_PROGRESSIVE_IMAGE_DECODING
 // apple-touch-icon support in <link> tags
 #define ANDROID_APPLE_TOUCH_ICON
 
@@ -1290,6 +1301,18 @@
 #define ENABLE_BRANCH_COMPACTION 1
 #endif
 
+/* Spread independent work, such as the rows of a filter effect, over a pool of worker threads.
+   Android builds without FILTERS, which is the only user. */
+#if !defined(ENABLE_PARALLEL_JOBS) && !ENABLE(SINGLE_THREADED) && USE(PTHREADS) && !PLATFORM(ANDROID)
+#define ENABLE_PARALLEL_JOBS 1
+#endif
+
+/* Web Audio computes its FFTs with vecLib on Darwin, and with MKL or FFTW where the port provides
+   them. Everywhere else the built-in FFT is used instead of a stub that produces no output. */
+#if ENABLE(WEB_AUDIO) && !OS(DARWIN) && !USE(WEBAUDIO_MKL) && !USE(WEBAUDIO_FFTW) && !defined(WTF_USE_WEBAUDIO_BUILTIN_FFT)
+#define WTF_USE_WEBAUDIO_BUILTIN_FFT 1
+#endif
+
 #if ENABLE(GLIB_SUPPORT)
 #include "GTypedefs.h"
 #endif
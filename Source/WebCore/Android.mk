@@ -189,6 +189,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	dom/ScriptRunner.cpp \
 	dom/SelectElement.cpp \
 	dom/SelectorNodeList.cpp \
+	dom/SelectorQueryIndex.cpp \
 	dom/ShadowRoot.cpp \
 	dom/SpaceSplitString.cpp \
 	dom/StaticHashSetNodeList.cpp \
@@ -392,6 +393,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	html/canvas/WebGLObject.cpp \
 	html/canvas/WebGLVertexArrayObjectOES.cpp \
 	\
+	html/parser/HTMLBackgroundPreloadScanner.cpp \
 	html/parser/HTMLConstructionSite.cpp \
 	html/parser/HTMLDocumentParser.cpp \
 	html/parser/HTMLElementStack.cpp \
@@ -471,6 +473,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	loader/appcache/ManifestParser.cpp \
 	\
 	loader/cache/MemoryCache.cpp \
+	loader/cache/MemoryCacheReplacementPolicy.cpp \
 	\
 	loader/icon/IconDatabase.cpp \
 	loader/icon/IconDatabaseBase.cpp \
@@ -596,6 +599,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	platform/animation/Animation.cpp \
 	platform/animation/AnimationList.cpp \
 	\
+	platform/audio/builtin/FFTFrameBuiltin.cpp \
 	platform/audio/mkl/FFTFrameMKL.cpp \
 	\
 	platform/graphics/BitmapImage.cpp \
@@ -680,6 +684,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	platform/graphics/android/rendering/GaneshRenderer.cpp \
 	platform/graphics/android/rendering/GLExtras.cpp \
 	platform/graphics/android/rendering/GLUtils.cpp \
+	platform/graphics/android/rendering/ImagePredecoder.cpp \
 	platform/graphics/android/rendering/ImagesManager.cpp \
 	platform/graphics/android/rendering/ImageTexture.cpp \
 	platform/graphics/android/rendering/InspectorCanvas.cpp \
@@ -749,6 +754,9 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	platform/image-decoders/skia/ImageDecoderSkia.cpp \
 	platform/image-decoders/gif/GIFImageDecoder.cpp \
 	platform/image-decoders/gif/GIFImageReader.cpp \
+	platform/image-decoders/jpeg/JPEGImageDecoder.cpp \
+	platform/image-decoders/png/PNGImageDecoder.cpp \
+	platform/image-decoders/webp/WEBPImageDecoder.cpp \
 	\
 	platform/image-encoders/skia/JPEGImageEncoder.cpp \
 	\
@@ -0,0 +1,4 @@
+#ifndef WebCore_FWD_ParallelJobs_h
+#define WebCore_FWD_ParallelJobs_h
+#include <JavaScriptCore/ParallelJobs.h>
+#endif
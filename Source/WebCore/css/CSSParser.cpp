@@ -406,12 +406,348 @@ static bool parseSimpleLengthValue(CSSMutableStyleDeclaration* declaration, int
     return true;
 }
 
+static inline bool isValidKeywordPropertyAndValue(int propertyId, int valueID)
+{
+    if (!valueID)
+        return false;
+
+    switch (propertyId) {
+    case CSSPropertyBorderCollapse: // collapse | separate | inherit
+        return valueID == CSSValueCollapse || valueID == CSSValueSeparate;
+    case CSSPropertyBorderTopStyle: // <border-style> | inherit
+    case CSSPropertyBorderRightStyle: // Defined as: none | hidden | dotted | dashed |
+    case CSSPropertyBorderBottomStyle: // solid | double | groove | ridge | inset | outset
+    case CSSPropertyBorderLeftStyle:
+    case CSSPropertyWebkitBorderStartStyle:
+    case CSSPropertyWebkitBorderEndStyle:
+    case CSSPropertyWebkitBorderBeforeStyle:
+    case CSSPropertyWebkitBorderAfterStyle:
+    case CSSPropertyWebkitColumnRuleStyle:
+        return valueID >= CSSValueNone && valueID <= CSSValueDouble;
+    case CSSPropertyCaptionSide: // top | bottom | left | right | inherit
+        return valueID == CSSValueLeft || valueID == CSSValueRight || valueID == CSSValueTop || valueID == CSSValueBottom;
+    case CSSPropertyClear: // none | left | right | both | inherit
+        return valueID == CSSValueNone || valueID == CSSValueLeft || valueID == CSSValueRight || valueID == CSSValueBoth;
+    case CSSPropertyDirection: // ltr | rtl | inherit
+        return valueID == CSSValueLtr || valueID == CSSValueRtl;
+    case CSSPropertyDisplay:
+        // inline | block | list-item | run-in | inline-block | table |
+        // inline-table | table-row-group | table-header-group | table-footer-group | table-row |
+        // table-column-group | table-column | table-cell | table-caption | box | inline-box | none | inherit
+#if ENABLE(WCSS)
+        return (valueID >= CSSValueInline && valueID <= CSSValueWapMarquee) || valueID == CSSValueNone;
+#else
+        return (valueID >= CSSValueInline && valueID <= CSSValueWebkitInlineBox) || valueID == CSSValueNone;
+#endif
+    case CSSPropertyEmptyCells: // show | hide | inherit
+        return valueID == CSSValueShow || valueID == CSSValueHide;
+    case CSSPropertyFloat: // left | right | none | inherit + center for buggy CSS
+        return valueID == CSSValueLeft || valueID == CSSValueRight || valueID == CSSValueNone || valueID == CSSValueCenter;
+    case CSSPropertyListStylePosition: // inside | outside | inherit
+        return valueID == CSSValueInside || valueID == CSSValueOutside;
+    case CSSPropertyListStyleType:
+        // See section CSS_PROP_LIST_STYLE_TYPE of file CSSValueKeywords.in
+        // for the list of supported list-style-types.
+        return (valueID >= CSSValueDisc && valueID <= CSSValueKatakanaIroha) || valueID == CSSValueNone;
+    case CSSPropertyOutlineStyle: // (<border-style> except hidden) | auto | inherit
+        return valueID == CSSValueAuto || valueID == CSSValueNone || (valueID >= CSSValueInset && valueID <= CSSValueDouble);
+    case CSSPropertyOverflowX:
+    case CSSPropertyOverflowY: // visible | hidden | scroll | auto | marquee | overlay | inherit
+        return valueID == CSSValueVisible || valueID == CSSValueHidden || valueID == CSSValueScroll || valueID == CSSValueAuto
+            || valueID == CSSValueOverlay || valueID == CSSValueWebkitMarquee;
+    case CSSPropertyPageBreakAfter: // auto | always | avoid | left | right | inherit
+    case CSSPropertyPageBreakBefore:
+    case CSSPropertyWebkitColumnBreakAfter:
+    case CSSPropertyWebkitColumnBreakBefore:
+        return valueID == CSSValueAuto || valueID == CSSValueAlways || valueID == CSSValueAvoid || valueID == CSSValueLeft || valueID == CSSValueRight;
+    case CSSPropertyPageBreakInside: // avoid | auto | inherit
+    case CSSPropertyWebkitColumnBreakInside:
+        return valueID == CSSValueAuto || valueID == CSSValueAvoid;
+    case CSSPropertyPosition: // static | relative | absolute | fixed | inherit
+        return valueID == CSSValueStatic || valueID == CSSValueRelative || valueID == CSSValueAbsolute || valueID == CSSValueFixed;
+    case CSSPropertyTextTransform: // capitalize | uppercase | lowercase | none | inherit
+        return (valueID >= CSSValueCapitalize && valueID <= CSSValueLowercase) || valueID == CSSValueNone;
+    case CSSPropertyUnicodeBidi: // normal | embed | bidi-override | isolate | inherit
+        return valueID == CSSValueNormal || valueID == CSSValueEmbed || valueID == CSSValueBidiOverride || valueID == CSSValueWebkitIsolate;
+    case CSSPropertyVisibility: // visible | hidden | collapse | inherit
+        return valueID == CSSValueVisible || valueID == CSSValueHidden || valueID == CSSValueCollapse;
+    case CSSPropertyWhiteSpace: // normal | pre | nowrap | inherit
+        return valueID == CSSValueNormal || valueID == CSSValuePre || valueID == CSSValuePreWrap || valueID == CSSValuePreLine || valueID == CSSValueNowrap;
+    default:
+        ASSERT_NOT_REACHED();
+        return false;
+    }
+}
+
+// Properties whose only valid values, apart from inherit and initial, are single keywords.
+static inline bool isKeywordPropertyID(int propertyId)
+{
+    switch (propertyId) {
+    case CSSPropertyBorderBottomStyle:
+    case CSSPropertyBorderCollapse:
+    case CSSPropertyBorderLeftStyle:
+    case CSSPropertyBorderRightStyle:
+    case CSSPropertyBorderTopStyle:
+    case CSSPropertyCaptionSide:
+    case CSSPropertyClear:
+    case CSSPropertyDirection:
+    case CSSPropertyDisplay:
+    case CSSPropertyEmptyCells:
+    case CSSPropertyFloat:
+    case CSSPropertyListStylePosition:
+    case CSSPropertyListStyleType:
+    case CSSPropertyOutlineStyle:
+    case CSSPropertyOverflowX:
+    case CSSPropertyOverflowY:
+    case CSSPropertyPageBreakAfter:
+    case CSSPropertyPageBreakBefore:
+    case CSSPropertyPageBreakInside:
+    case CSSPropertyPosition:
+    case CSSPropertyTextTransform:
+    case CSSPropertyUnicodeBidi:
+    case CSSPropertyVisibility:
+    case CSSPropertyWebkitBorderAfterStyle:
+    case CSSPropertyWebkitBorderBeforeStyle:
+    case CSSPropertyWebkitBorderEndStyle:
+    case CSSPropertyWebkitBorderStartStyle:
+    case CSSPropertyWebkitColumnBreakAfter:
+    case CSSPropertyWebkitColumnBreakBefore:
+    case CSSPropertyWebkitColumnBreakInside:
+    case CSSPropertyWebkitColumnRuleStyle:
+    case CSSPropertyWhiteSpace:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool parseKeywordValue(CSSMutableStyleDeclaration* declaration, int propertyId, const String& string, bool important)
+{
+    if (!string.length())
+        return false;
+    if (!isKeywordPropertyID(propertyId))
+        return false;
+    CSSParserString cssString;
+    cssString.characters = const_cast<UChar*>(string.characters());
+    cssString.length = string.length();
+    int valueID = cssValueKeywordID(cssString);
+    if (!valueID)
+        return false;
+
+    RefPtr<CSSValue> value;
+    if (valueID == CSSValueInherit)
+        value = CSSInheritedValue::create();
+    else if (valueID == CSSValueInitial)
+        value = CSSInitialValue::createExplicit();
+    else if (isValidKeywordPropertyAndValue(propertyId, valueID)) {
+        CSSStyleSheet* stylesheet = static_cast<CSSStyleSheet*>(declaration->stylesheet());
+        if (!stylesheet || !stylesheet->document())
+            return false;
+        value = stylesheet->document()->cssPrimitiveValueCache()->createIdentifierValue(valueID);
+    } else
+        return false;
+
+    CSSProperty property(propertyId, value.release(), important);
+    declaration->addParsedProperty(property);
+    return true;
+}
+
+static bool parseSimpleNumberValue(CSSMutableStyleDeclaration* declaration, int propertyId, const String& string, bool important)
+{
+    // opacity: <number> | inherit, z-index: auto | <integer> | inherit. Keywords
+    // other than auto are left to the full parser.
+    if (propertyId != CSSPropertyOpacity && propertyId != CSSPropertyZIndex)
+        return false;
+    const UChar* characters = string.characters();
+    unsigned length = string.length();
+    if (!characters || !length)
+        return false;
+
+    if (propertyId == CSSPropertyZIndex) {
+        for (unsigned i = 0; i < length; ++i) {
+            if (!isASCIIDigit(characters[i]) && !(!i && (characters[i] == '-' || characters[i] == '+')))
+                return false;
+        }
+    }
+
+    bool ok;
+    double number = charactersToDouble(characters, length, &ok);
+    if (!ok)
+        return false;
+
+    CSSStyleSheet* stylesheet = static_cast<CSSStyleSheet*>(declaration->stylesheet());
+    if (!stylesheet || !stylesheet->document())
+        return false;
+    CSSProperty property(propertyId, stylesheet->document()->cssPrimitiveValueCache()->createValue(number, CSSPrimitiveValue::CSS_NUMBER), important);
+    declaration->addParsedProperty(property);
+    return true;
+}
+
+enum SimpleTransformArgumentType {
+    SimpleTransformLength, // px, % or 0
+    SimpleTransformAngle, // deg or 0
+    SimpleTransformNumber
+};
+
+struct SimpleTransformFunction {
+    const char* name;
+    WebKitCSSTransformValue::TransformOperationType type;
+    unsigned minimumArguments;
+    unsigned maximumArguments;
+    SimpleTransformArgumentType argumentType;
+};
+
+// The transform functions most commonly set from animation scripts. Anything
+// else, including other units and nested calc-like syntax, goes through parseTransform().
+static const SimpleTransformFunction simpleTransformFunctions[] = {
+    { "translate", WebKitCSSTransformValue::TranslateTransformOperation, 1, 2, SimpleTransformLength },
+    { "translatex", WebKitCSSTransformValue::TranslateXTransformOperation, 1, 1, SimpleTransformLength },
+    { "translatey", WebKitCSSTransformValue::TranslateYTransformOperation, 1, 1, SimpleTransformLength },
+    { "translate3d", WebKitCSSTransformValue::Translate3DTransformOperation, 3, 3, SimpleTransformLength },
+    { "scale", WebKitCSSTransformValue::ScaleTransformOperation, 1, 2, SimpleTransformNumber },
+    { "scalex", WebKitCSSTransformValue::ScaleXTransformOperation, 1, 1, SimpleTransformNumber },
+    { "scaley", WebKitCSSTransformValue::ScaleYTransformOperation, 1, 1, SimpleTransformNumber },
+    { "rotate", WebKitCSSTransformValue::RotateTransformOperation, 1, 1, SimpleTransformAngle },
+    { "rotatez", WebKitCSSTransformValue::RotateZTransformOperation, 1, 1, SimpleTransformAngle },
+};
+
+static inline bool endsWith(const UChar* characters, unsigned length, const char* suffix, unsigned suffixLength)
+{
+    if (length <= suffixLength)
+        return false;
+    for (unsigned i = 0; i < suffixLength; ++i) {
+        if (toASCIILower(characters[length - suffixLength + i]) != suffix[i])
+            return false;
+    }
+    return true;
+}
+
+static PassRefPtr<CSSPrimitiveValue> parseSimpleTransformArgument(const UChar* characters, unsigned length, SimpleTransformArgumentType argumentType, bool allowPercentage, CSSPrimitiveValueCache* primitiveValueCache)
+{
+    while (length && isHTMLSpace(characters[length - 1]))
+        --length;
+    if (!length)
+        return 0;
+
+    CSSPrimitiveValue::UnitTypes unit = CSSPrimitiveValue::CSS_NUMBER;
+    if (argumentType == SimpleTransformLength && endsWith(characters, length, "px", 2)) {
+        length -= 2;
+        unit = CSSPrimitiveValue::CSS_PX;
+    } else if (argumentType == SimpleTransformLength && allowPercentage && characters[length - 1] == '%' && length > 1) {
+        length -= 1;
+        unit = CSSPrimitiveValue::CSS_PERCENTAGE;
+    } else if (argumentType == SimpleTransformAngle && endsWith(characters, length, "deg", 3)) {
+        length -= 3;
+        unit = CSSPrimitiveValue::CSS_DEG;
+    }
+
+    bool ok;
+    double number = charactersToDouble(characters, length, &ok);
+    if (!ok)
+        return 0;
+
+    // As in CSSParser::validUnit in strict mode, a unitless length or angle must be zero.
+    // It keeps the CSS_NUMBER unit, as parseTransform() would give it.
+    if (unit == CSSPrimitiveValue::CSS_NUMBER && argumentType != SimpleTransformNumber && number)
+        return 0;
+    return primitiveValueCache->createValue(number, unit);
+}
+
+static PassRefPtr<WebKitCSSTransformValue> parseSimpleTransformOperation(const UChar*& position, const UChar* end, CSSPrimitiveValueCache* primitiveValueCache)
+{
+    const UChar* nameStart = position;
+    while (position < end && *position != '(')
+        ++position;
+    if (position == end)
+        return 0;
+    unsigned nameLength = position - nameStart;
+    ++position;
+
+    const SimpleTransformFunction* function = 0;
+    for (size_t i = 0; i < WTF_ARRAY_LENGTH(simpleTransformFunctions); ++i) {
+        const char* name = simpleTransformFunctions[i].name;
+        if (strlen(name) == nameLength && equalIgnoringCase(nameStart, name, nameLength)) {
+            function = &simpleTransformFunctions[i];
+            break;
+        }
+    }
+    if (!function)
+        return 0;
+
+    RefPtr<WebKitCSSTransformValue> transformValue = WebKitCSSTransformValue::create(function->type);
+    unsigned argumentCount = 0;
+    while (true) {
+        while (position < end && isHTMLSpace(*position))
+            ++position;
+        const UChar* argumentStart = position;
+        while (position < end && *position != ',' && *position != ')')
+            ++position;
+        if (position == end || argumentCount == function->maximumArguments)
+            return 0;
+
+        // The third argument of translate3d() cannot be a percentage.
+        bool allowPercentage = !(function->type == WebKitCSSTransformValue::Translate3DTransformOperation && argumentCount == 2);
+        RefPtr<CSSPrimitiveValue> argument = parseSimpleTransformArgument(argumentStart, position - argumentStart, function->argumentType, allowPercentage, primitiveValueCache);
+        if (!argument)
+            return 0;
+        transformValue->append(argument.release());
+        ++argumentCount;
+
+        if (*position++ == ')')
+            break;
+    }
+    if (argumentCount < function->minimumArguments)
+        return 0;
+    return transformValue.release();
+}
+
+static bool parseSimpleTransformValue(CSSMutableStyleDeclaration* declaration, int propertyId, const String& string, bool important)
+{
+    if (propertyId != CSSPropertyWebkitTransform)
+        return false;
+    const UChar* characters = string.characters();
+    unsigned length = string.length();
+    if (!characters || !length)
+        return false;
+
+    CSSStyleSheet* stylesheet = static_cast<CSSStyleSheet*>(declaration->stylesheet());
+    if (!stylesheet || !stylesheet->document())
+        return false;
+    RefPtr<CSSPrimitiveValueCache> primitiveValueCache = stylesheet->document()->cssPrimitiveValueCache();
+
+    RefPtr<CSSValueList> transformList = CSSValueList::createSpaceSeparated();
+    const UChar* position = characters;
+    const UChar* end = characters + length;
+    while (true) {
+        while (position < end && isHTMLSpace(*position))
+            ++position;
+        if (position == end)
+            break;
+        RefPtr<WebKitCSSTransformValue> transformValue = parseSimpleTransformOperation(position, end, primitiveValueCache.get());
+        if (!transformValue)
+            return false;
+        transformList->append(transformValue.release());
+    }
+    if (!transformList->length())
+        return false;
+
+    CSSProperty property(propertyId, transformList.release(), important);
+    declaration->addParsedProperty(property);
+    return true;
+}
+
 bool CSSParser::parseValue(CSSMutableStyleDeclaration* declaration, int propertyId, const String& string, bool important, bool strict)
 {
     if (parseSimpleLengthValue(declaration, propertyId, string, important, strict))
         return true;
     if (parseColorValue(declaration, propertyId, string, important, strict))
         return true;
+    if (parseKeywordValue(declaration, propertyId, string, important))
+        return true;
+    if (parseSimpleNumberValue(declaration, propertyId, string, important))
+        return true;
+    if (parseSimpleTransformValue(declaration, propertyId, string, important))
+        return true;
     CSSParser parser(strict);
     return parser.parseValue(declaration, propertyId, string, important);
 }
@@ -783,6 +1119,15 @@ bool CSSParser::parseValue(int propId, bool important)
         return true;
     }
 
+    if (isKeywordPropertyID(propId)) {
+        if (!isValidKeywordPropertyAndValue(propId, id))
+            return false;
+        if (m_valueList->next() && !inShorthand())
+            return false;
+        addProperty(propId, primitiveValueCache()->createIdentifierValue(id), important);
+        return true;
+    }
+
     bool validPrimitive = false;
     RefPtr<CSSValue> parsedValue;
 
@@ -805,59 +1150,10 @@ bool CSSParser::parseValue(int propId, bool important)
         else
             return parseQuotes(propId, important);
         break;
-    case CSSPropertyUnicodeBidi: // normal | embed | bidi-override | isolate | inherit
-        if (id == CSSValueNormal
-            || id == CSSValueEmbed
-            || id == CSSValueBidiOverride
-            || id == CSSValueWebkitIsolate)
-            validPrimitive = true;
-        break;
-
-    case CSSPropertyPosition:             // static | relative | absolute | fixed | inherit
-        if (id == CSSValueStatic ||
-             id == CSSValueRelative ||
-             id == CSSValueAbsolute ||
-             id == CSSValueFixed)
-            validPrimitive = true;
-        break;
-
-    case CSSPropertyPageBreakAfter:     // auto | always | avoid | left | right | inherit
-    case CSSPropertyPageBreakBefore:
-    case CSSPropertyWebkitColumnBreakAfter:
-    case CSSPropertyWebkitColumnBreakBefore:
-        if (id == CSSValueAuto ||
-             id == CSSValueAlways ||
-             id == CSSValueAvoid ||
-             id == CSSValueLeft ||
-             id == CSSValueRight)
-            validPrimitive = true;
-        break;
-
-    case CSSPropertyPageBreakInside:    // avoid | auto | inherit
-    case CSSPropertyWebkitColumnBreakInside:
-        if (id == CSSValueAuto || id == CSSValueAvoid)
-            validPrimitive = true;
-        break;
-
-    case CSSPropertyEmptyCells:          // show | hide | inherit
-        if (id == CSSValueShow ||
-             id == CSSValueHide)
-            validPrimitive = true;
-        break;
-
     case CSSPropertyContent:              // [ <string> | <uri> | <counter> | attr(X) | open-quote |
         // close-quote | no-open-quote | no-close-quote ]+ | inherit
         return parseContent(propId, important);
 
-    case CSSPropertyWhiteSpace:          // normal | pre | nowrap | inherit
-        if (id == CSSValueNormal ||
-            id == CSSValuePre ||
-            id == CSSValuePreWrap ||
-            id == CSSValuePreLine ||
-            id == CSSValueNowrap)
-            validPrimitive = true;
-        break;
-
     case CSSPropertyClip:                 // <shape> | auto | inherit
         if (id == CSSValueAuto)
             validPrimitive = true;
@@ -868,22 +1164,6 @@ bool CSSParser::parseValue(int propId, bool important)
     /* Start of supported CSS properties with validation. This is needed for parseShorthand to work
      * correctly and allows optimization in WebCore::applyRule(..)
      */
-    case CSSPropertyCaptionSide:         // top | bottom | left | right | inherit
-        if (id == CSSValueLeft || id == CSSValueRight ||
-            id == CSSValueTop || id == CSSValueBottom)
-            validPrimitive = true;
-        break;
-
-    case CSSPropertyBorderCollapse:      // collapse | separate | inherit
-        if (id == CSSValueCollapse || id == CSSValueSeparate)
-            validPrimitive = true;
-        break;
-
-    case CSSPropertyVisibility:           // visible | hidden | collapse | inherit
-        if (id == CSSValueVisible || id == CSSValueHidden || id == CSSValueCollapse)
-            validPrimitive = true;
-        break;
-
     case CSSPropertyOverflow: {
         ShorthandScope scope(this, propId);
         if (num != 1 || !parseValue(CSSPropertyOverflowX, important))
@@ -892,59 +1172,6 @@ bool CSSParser::parseValue(int propId, bool important)
         addProperty(CSSPropertyOverflowY, value, important);
         return true;
     }
-    case CSSPropertyOverflowX:
-    case CSSPropertyOverflowY:           // visible | hidden | scroll | auto | marquee | overlay | inherit
-        if (id == CSSValueVisible || id == CSSValueHidden || id == CSSValueScroll || id == CSSValueAuto ||
-            id == CSSValueOverlay || id == CSSValueWebkitMarquee)
-            validPrimitive = true;
-        break;
-
-    case CSSPropertyListStylePosition:  // inside | outside | inherit
-        if (id == CSSValueInside || id == CSSValueOutside)
-            validPrimitive = true;
-        break;
-
-    case CSSPropertyListStyleType:
-        // See section CSS_PROP_LIST_STYLE_TYPE of file CSSValueKeywords.in
-        // for the list of supported list-style-types.
-        if ((id >= CSSValueDisc && id <= CSSValueKatakanaIroha) || id == CSSValueNone)
-            validPrimitive = true;
-        break;
-
-    case CSSPropertyDisplay:
-        // inline | block | list-item | run-in | inline-block | table |
-        // inline-table | table-row-group | table-header-group | table-footer-group | table-row |
-        // table-column-group | table-column | table-cell | table-caption | box | inline-box | none | inherit
-#if ENABLE(WCSS)
-        if ((id >= CSSValueInline && id <= CSSValueWapMarquee) || id == CSSValueNone)
-#else
-        if ((id >= CSSValueInline && id <= CSSValueWebkitInlineBox) || id == CSSValueNone)
-#endif
-            validPrimitive = true;
-        break;
-
-    case CSSPropertyDirection:            // ltr | rtl | inherit
-        if (id == CSSValueLtr || id == CSSValueRtl)
-            validPrimitive = true;
-        break;
-
-    case CSSPropertyTextTransform:       // capitalize | uppercase | lowercase | none | inherit
-        if ((id >= CSSValueCapitalize && id <= CSSValueLowercase) || id == CSSValueNone)
-            validPrimitive = true;
-        break;
-
-    case CSSPropertyFloat:                // left | right | none | inherit + center for buggy CSS
-        if (id == CSSValueLeft || id == CSSValueRight ||
-             id == CSSValueNone || id == CSSValueCenter)
-            validPrimitive = true;
-        break;
-
-    case CSSPropertyClear:                // none | left | right | both | inherit
-        if (id == CSSValueNone || id == CSSValueLeft ||
-             id == CSSValueRight|| id == CSSValueBoth)
-            validPrimitive = true;
-        break;
-
     case CSSPropertyTextAlign:
         // left | right | center | justify | webkit_left | webkit_right | webkit_center | webkit_match_parent |
         // start | end | <string> | inherit
@@ -953,24 +1180,6 @@ bool CSSParser::parseValue(int propId, bool important)
             validPrimitive = true;
         break;
 
-    case CSSPropertyOutlineStyle:        // (<border-style> except hidden) | auto | inherit
-        if (id == CSSValueAuto || id == CSSValueNone || (id >= CSSValueInset && id <= CSSValueDouble))
-            validPrimitive = true;
-        break;
-
-    case CSSPropertyBorderTopStyle:     //// <border-style> | inherit
-    case CSSPropertyBorderRightStyle:   //   Defined as:    none | hidden | dotted | dashed |
-    case CSSPropertyBorderBottomStyle:  //   solid | double | groove | ridge | inset | outset
-    case CSSPropertyBorderLeftStyle:
-    case CSSPropertyWebkitBorderStartStyle:
-    case CSSPropertyWebkitBorderEndStyle:
-    case CSSPropertyWebkitBorderBeforeStyle:
-    case CSSPropertyWebkitBorderAfterStyle:
-    case CSSPropertyWebkitColumnRuleStyle:
-        if (id >= CSSValueNone && id <= CSSValueDouble)
-            validPrimitive = true;
-        break;
-
     case CSSPropertyFontWeight:  // normal | bold | bolder | lighter | 100 | 200 | 300 | 400 | 500 | 600 | 700 | 800 | 900 | inherit
         return parseFontWeight(important);
 
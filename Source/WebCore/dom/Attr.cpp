@@ -126,6 +126,10 @@ void Attr::setValue(const AtomicString& value)
     m_attribute->setValue(value);
     createTextChild();
     m_ignoreChildrenChanged--;
+
+    // Neither of the above changes the tree when the Attr had no children and the value
+    // is empty, but queries cached against the DOM tree version must still see the change.
+    document()->incDOMTreeVersion();
 }
 
 void Attr::setValue(const AtomicString& value, ExceptionCode&)
@@ -31,6 +31,7 @@
 #include "ClassNodeList.h"
 
 #include "Document.h"
+#include "HTMLNames.h"
 #include "StyledElement.h"
 
 namespace WebCore {
@@ -57,4 +58,9 @@ bool ClassNodeList::nodeMatches(Element* testNode) const
     return static_cast<StyledElement*>(testNode)->classNames().containsAll(m_classNames);
 }
 
+bool ClassNodeList::dependsOnAttribute(const QualifiedName& attrName) const
+{
+    return attrName == HTMLNames::classAttr;
+}
+
 } // namespace WebCore
@@ -49,6 +49,7 @@ namespace WebCore {
         ClassNodeList(PassRefPtr<Node> rootNode, const String& classNames);
 
         virtual bool nodeMatches(Element*) const;
+        virtual bool dependsOnAttribute(const QualifiedName&) const;
 
         SpaceSplitString m_classNames;
         String m_originalClassNames;
@@ -493,6 +493,7 @@ void ContainerNode::parserRemoveChild(Node* oldChild)
     Node* next = oldChild->nextSibling();
 
     removeBetween(prev, next, oldChild);
+    document()->incDOMTreeVersion();
 
     childrenChanged(true, prev, next, -1);
     if (oldChild->inDocument())
@@ -792,8 +793,13 @@ void ContainerNode::childrenChanged(bool changedByParser, Node* beforeChange, No
     Node::childrenChanged(changedByParser, beforeChange, afterChange, childCountDelta);
     if (!changedByParser && childCountDelta)
         document()->nodeChildrenChanged(this);
-    if (document()->hasNodeListCaches())
-        notifyNodeListsChildrenChanged();
+    // A change to the data of a child leaves the lists alone.
+    if (childCountDelta && document()->hasNodeListCaches()) {
+        if (childCountDelta == 1 && !afterChange)
+            notifyNodeListsChildAppended(lastChild());
+        else
+            notifyNodeListsChildrenChanged();
+    }
 }
 
 void ContainerNode::cloneChildNodes(ContainerNode *clone)
@@ -132,6 +132,7 @@
 #include "SecurityOrigin.h"
 #include "SegmentedString.h"
 #include "SelectionController.h"
+#include "SelectorQueryIndex.h"
 #include "Settings.h"
 #include "StaticHashSetNodeList.h"
 #include "StyleSheetList.h"
@@ -625,6 +626,13 @@ Element* Document::getElementById(const AtomicString& id) const
     return TreeScope::getElementById(id);
 }
 
+SelectorQueryIndex* Document::selectorQueryIndex()
+{
+    if (!m_selectorQueryIndex)
+        m_selectorQueryIndex = SelectorQueryIndex::create();
+    return m_selectorQueryIndex->update(this) ? m_selectorQueryIndex.get() : 0;
+}
+
 MediaQueryMatcher* Document::mediaQueryMatcher()
 {
     if (!m_mediaQueryMatcher)
@@ -110,6 +110,7 @@ class RenderArena;
 class RenderView;
 class RenderFullScreen;
 class ScriptableDocumentParser;
+class SelectorQueryIndex;
 class ScriptElementData;
 class ScriptRunner;
 class SecurityOrigin;
@@ -905,6 +906,9 @@ public:
     void incDOMTreeVersion() { m_domTreeVersion = ++s_globalTreeVersion; }
     uint64_t domTreeVersion() const { return m_domTreeVersion; }
 
+    // Returns 0 if the index is not up to date with the tree.
+    SelectorQueryIndex* selectorQueryIndex();
+
     void setDocType(PassRefPtr<DocumentType>);
 
 #if ENABLE(XPATH)
@@ -1218,6 +1222,7 @@ private:
 
     uint64_t m_domTreeVersion;
     static uint64_t s_globalTreeVersion;
+    OwnPtr<SelectorQueryIndex> m_selectorQueryIndex;
     
     HashSet<NodeIterator*> m_nodeIterators;
     HashSet<Range*> m_ranges;
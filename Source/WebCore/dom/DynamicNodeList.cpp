@@ -157,6 +157,16 @@ void DynamicNodeList::invalidateCache()
     m_caches->reset();
 }
 
+void DynamicNodeList::updateCacheForAppendedNode(Node* node)
+{
+    ASSERT(m_ownsCaches);
+    // The cached item still has the same offset, only the length grows.
+    if (!m_caches->isLengthCacheValid)
+        return;
+    for (Node* n = node; n; n = n->traverseNextNode(node))
+        m_caches->cachedLength += n->isElementNode() && nodeMatches(static_cast<Element*>(n));
+}
+
 DynamicNodeList::Caches::Caches()
     : lastItem(0)
     , isLengthCacheValid(false)
@@ -33,6 +33,7 @@ namespace WebCore {
 
     class Element;
     class Node;
+    class QualifiedName;
 
     class DynamicNodeList : public NodeList {
     public:
@@ -60,6 +61,11 @@ namespace WebCore {
 
         // Other methods (not part of DOM)
         void invalidateCache();
+        // Called for the lists that own their caches when |node| was added
+        // after every node under the root.
+        virtual void updateCacheForAppendedNode(Node*);
+        // Whether changing the attribute can change which elements match.
+        virtual bool dependsOnAttribute(const QualifiedName&) const { return false; }
         Node* rootNode() const { return m_rootNode.get(); }
 
     protected:
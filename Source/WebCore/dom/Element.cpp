@@ -734,6 +734,7 @@ void Element::attributeChanged(Attribute* attr, bool)
     if (isIdAttributeName(attr->name()))
         idAttributeChanged(attr);
     recalcStyleIfNeededAfterAttributeChanged(attr);
+    notifyNodeListsAttributeChanged(attr->name());
     updateAfterAttributeChanged(attr);
 }
 
@@ -47,4 +47,9 @@ bool NameNodeList::nodeMatches(Element* testNode) const
     return testNode->getAttribute(nameAttr) == m_nodeName;
 }
 
+bool NameNodeList::dependsOnAttribute(const QualifiedName& attrName) const
+{
+    return attrName == nameAttr;
+}
+
 } // namespace WebCore
@@ -44,6 +44,7 @@ namespace WebCore {
         NameNodeList(PassRefPtr<Node> rootNode, const String& name);
 
         virtual bool nodeMatches(Element*) const;
+        virtual bool dependsOnAttribute(const QualifiedName&) const;
 
         AtomicString m_nodeName;
     };
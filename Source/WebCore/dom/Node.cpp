@@ -1007,7 +1007,16 @@ void Node::unregisterDynamicNodeList(DynamicNodeList* list)
     }
 }
 
-void Node::notifyLocalNodeListsAttributeChanged()
+void Node::clearNodeListsIfEmpty()
+{
+    NodeRareData* data = rareData();
+    if (data->nodeLists()->isEmpty()) {
+        data->clearNodeLists();
+        document()->removeNodeListCache();
+    }
+}
+
+void Node::notifyLocalNodeListsAttributeChanged(const QualifiedName& attrName)
 {
     if (!hasRareData())
         return;
@@ -1015,24 +1024,19 @@ void Node::notifyLocalNodeListsAttributeChanged()
     if (!data->nodeLists())
         return;
 
-    if (!isAttributeNode())
-        data->nodeLists()->invalidateCachesThatDependOnAttributes();
-    else
-        data->nodeLists()->invalidateCaches();
-
-    if (data->nodeLists()->isEmpty()) {
-        data->clearNodeLists();
-        document()->removeNodeListCache();
-    }
+    data->nodeLists()->invalidateCachesForAttribute(attrName);
+    clearNodeListsIfEmpty();
 }
 
-void Node::notifyNodeListsAttributeChanged()
+void Node::notifyNodeListsAttributeChanged(const QualifiedName& attrName)
 {
-    for (Node *n = this; n; n = n->parentNode())
-        n->notifyLocalNodeListsAttributeChanged();
+    if (!document()->hasNodeListCaches())
+        return;
+    for (Node* n = this; n; n = n->parentNode())
+        n->notifyLocalNodeListsAttributeChanged(attrName);
 }
 
-void Node::notifyLocalNodeListsChildrenChanged()
+void Node::notifyLocalNodeListsChildrenChanged(bool isParent)
 {
     if (!hasRareData())
         return;
@@ -1040,22 +1044,49 @@ void Node::notifyLocalNodeListsChildrenChanged()
     if (!data->nodeLists())
         return;
 
-    data->nodeLists()->invalidateCaches();
+    // childNodes only sees the children of its own node.
+    if (isParent)
+        data->nodeLists()->invalidateCaches();
+    else
+        data->nodeLists()->invalidateCachesThatDependOnDescendants();
+    clearNodeListsIfEmpty();
+}
 
-    NodeListsNodeData::NodeListSet::iterator end = data->nodeLists()->m_listsWithCaches.end();
-    for (NodeListsNodeData::NodeListSet::iterator i = data->nodeLists()->m_listsWithCaches.begin(); i != end; ++i)
-        (*i)->invalidateCache();
+void Node::notifyNodeListsChildrenChanged()
+{
+    notifyLocalNodeListsChildrenChanged(true);
+    for (Node* n = parentNode(); n; n = n->parentNode())
+        n->notifyLocalNodeListsChildrenChanged(false);
+}
 
-    if (data->nodeLists()->isEmpty()) {
-        data->clearNodeLists();
-        document()->removeNodeListCache();
-    }
+void Node::notifyLocalNodeListsChildAppended(Node* child, bool isParent)
+{
+    if (!hasRareData())
+        return;
+    NodeRareData* data = rareData();
+    if (!data->nodeLists())
+        return;
+
+    data->nodeLists()->updateCachesForAppendedNode(child, isParent);
+    clearNodeListsIfEmpty();
 }
 
-void Node::notifyNodeListsChildrenChanged()
+// The lists rooted at an ancestor can keep their caches as long as the child
+// comes after every node they have already seen, that is as long as no node
+// on the way up has a next sibling. Above that, the child was inserted into
+// the middle of the list.
+void Node::notifyNodeListsChildAppended(Node* child)
 {
-    for (Node* n = this; n; n = n->parentNode())
-        n->notifyLocalNodeListsChildrenChanged();
+    ASSERT(child->parentNode() == this && !child->nextSibling());
+    bool appendedLast = true;
+    for (Node* n = this; n; n = n->parentNode()) {
+        if (appendedLast)
+            n->notifyLocalNodeListsChildAppended(child, n == this);
+        else
+            n->notifyLocalNodeListsChildrenChanged(false);
+        if (n->nextSibling())
+            appendedLast = false;
+    }
 }
 
 void Node::notifyLocalNodeListsLabelChanged()
@@ -1783,28 +1814,7 @@ PassRefPtr<Element> Node::querySelector(const String& selectors, ExceptionCode&
         return 0;
     }
 
-    CSSStyleSelector::SelectorChecker selectorChecker(document(), strictParsing);
-
-    // FIXME: we could also optimize for the the [id="foo"] case
-    if (strictParsing && inDocument() && querySelectorList.hasOneSelector() && querySelectorList.first()->m_match == CSSSelector::Id) {
-        Element* element = document()->getElementById(querySelectorList.first()->value());
-        if (element && (isDocumentNode() || element->isDescendantOf(this)) && selectorChecker.checkSelector(querySelectorList.first(), element))
-            return element;
-        return 0;
-    }
-
-    // FIXME: We can speed this up by implementing caching similar to the one use by getElementById
-    for (Node* n = firstChild(); n; n = n->traverseNextNode(this)) {
-        if (n->isElementNode()) {
-            Element* element = static_cast<Element*>(n);
-            for (CSSSelector* selector = querySelectorList.first(); selector; selector = CSSSelectorList::next(selector)) {
-                if (selectorChecker.checkSelector(selector, element))
-                    return element;
-            }
-        }
-    }
-    
-    return 0;
+    return findFirstSelectorMatch(this, querySelectorList);
 }
 
 PassRefPtr<NodeList> Node::querySelectorAll(const String& selectors, ExceptionCode& ec)
@@ -2426,26 +2436,37 @@ void Node::formatForDebugger(char* buffer, unsigned length) const
 void NodeListsNodeData::invalidateCaches()
 {
     m_childNodeListCaches->reset();
+    invalidateCachesThatDependOnDescendants();
+}
 
+void NodeListsNodeData::invalidateCachesThatDependOnDescendants()
+{
     if (m_labelsNodeListCache)
         m_labelsNodeListCache->invalidateCache();
-    TagNodeListCache::const_iterator tagCacheEnd = m_tagNodeListCache.end();
-    for (TagNodeListCache::const_iterator it = m_tagNodeListCache.begin(); it != tagCacheEnd; ++it)
-        it->second->invalidateCache();
-    invalidateCachesThatDependOnAttributes();
+    NodeListSet::iterator end = m_listsWithCaches.end();
+    for (NodeListSet::iterator it = m_listsWithCaches.begin(); it != end; ++it)
+        (*it)->invalidateCache();
 }
 
-void NodeListsNodeData::invalidateCachesThatDependOnAttributes()
+void NodeListsNodeData::invalidateCachesForAttribute(const QualifiedName& attrName)
 {
-    ClassNodeListCache::iterator classCacheEnd = m_classNodeListCache.end();
-    for (ClassNodeListCache::iterator it = m_classNodeListCache.begin(); it != classCacheEnd; ++it)
-        it->second->invalidateCache();
-
-    NameNodeListCache::iterator nameCacheEnd = m_nameNodeListCache.end();
-    for (NameNodeListCache::iterator it = m_nameNodeListCache.begin(); it != nameCacheEnd; ++it)
-        it->second->invalidateCache();
-    if (m_labelsNodeListCache)
+    if (m_labelsNodeListCache && m_labelsNodeListCache->dependsOnAttribute(attrName))
         m_labelsNodeListCache->invalidateCache();
+    NodeListSet::iterator end = m_listsWithCaches.end();
+    for (NodeListSet::iterator it = m_listsWithCaches.begin(); it != end; ++it) {
+        if ((*it)->dependsOnAttribute(attrName))
+            (*it)->invalidateCache();
+    }
+}
+
+void NodeListsNodeData::updateCachesForAppendedNode(Node* node, bool isChild)
+{
+    if (isChild && m_childNodeListCaches->isLengthCacheValid)
+        ++m_childNodeListCaches->cachedLength;
+
+    NodeListSet::iterator end = m_listsWithCaches.end();
+    for (NodeListSet::iterator it = m_listsWithCaches.begin(); it != end; ++it)
+        (*it)->updateCacheForAppendedNode(node);
 }
 
 bool NodeListsNodeData::isEmpty() const
@@ -2719,8 +2740,6 @@ void Node::dispatchSubtreeModifiedEvent()
     
     document()->incDOMTreeVersion();
 
-    notifyNodeListsAttributeChanged(); // FIXME: Can do better some day. Really only care about the name attribute changing.
-    
     if (!document()->hasListenerType(Document::DOMSUBTREEMODIFIED_LISTENER))
         return;
 
@@ -509,9 +509,8 @@ public:
     void registerDynamicNodeList(DynamicNodeList*);
     void unregisterDynamicNodeList(DynamicNodeList*);
     void notifyNodeListsChildrenChanged();
-    void notifyLocalNodeListsChildrenChanged();
-    void notifyNodeListsAttributeChanged();
-    void notifyLocalNodeListsAttributeChanged();
+    void notifyNodeListsChildAppended(Node*);
+    void notifyNodeListsAttributeChanged(const QualifiedName&);
     void notifyLocalNodeListsLabelChanged();
     void removeCachedClassNodeList(ClassNodeList*, const String&);
     void removeCachedNameNodeList(NameNodeList*, const String&);
@@ -680,6 +679,11 @@ private:
 
     Element* ancestorElement() const;
 
+    void notifyLocalNodeListsChildrenChanged(bool isParent);
+    void notifyLocalNodeListsChildAppended(Node*, bool isParent);
+    void notifyLocalNodeListsAttributeChanged(const QualifiedName&);
+    void clearNodeListsIfEmpty();
+
     // Use Node::parentNode as the consistent way of querying a parent node.
     // This method is made private to ensure a compiler error on call sites that
     // don't follow this rule.
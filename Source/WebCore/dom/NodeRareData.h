@@ -61,7 +61,9 @@ public:
     }
     
     void invalidateCaches();
-    void invalidateCachesThatDependOnAttributes();
+    void invalidateCachesThatDependOnDescendants();
+    void invalidateCachesForAttribute(const QualifiedName&);
+    void updateCachesForAppendedNode(Node*, bool isChild);
     bool isEmpty() const;
 
 private:
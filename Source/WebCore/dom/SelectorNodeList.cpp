@@ -35,40 +35,127 @@
 #include "Document.h"
 #include "Element.h"
 #include "HTMLNames.h"
+#include "SelectorQueryIndex.h"
 #include "StaticNodeList.h"
 
 namespace WebCore {
 
 using namespace HTMLNames;
 
-PassRefPtr<StaticNodeList> createSelectorNodeList(Node* rootNode, const CSSSelectorList& querySelectorList)
+// Finds the elements that the rightmost compound selector can match without
+// walking the tree: the element with its id, or the smallest of the lists of
+// elements with one of its classes or with its tag name. Returns false if
+// the whole tree has to be walked instead.
+static bool startSetForSelector(Node* rootNode, CSSSelector* selector, Element*& onlyCandidate, const SelectorQueryIndex::ElementVector*& candidates)
 {
-    Vector<RefPtr<Node> > nodes;
+    onlyCandidate = 0;
+    candidates = 0;
+    if (!rootNode->inDocument())
+        return false;
+
     Document* document = rootNode->document();
-    CSSSelector* onlySelector = querySelectorList.hasOneSelector() ? querySelectorList.first() : 0;
-    bool strictParsing = !document->inQuirksMode();
-
-    CSSStyleSelector::SelectorChecker selectorChecker(document, strictParsing);
-
-    if (strictParsing && rootNode->inDocument() && onlySelector && onlySelector->m_match == CSSSelector::Id && !document->containsMultipleElementsWithId(onlySelector->value())) {
-        Element* element = document->getElementById(onlySelector->value());
-        if (element && (rootNode->isDocumentNode() || element->isDescendantOf(rootNode)) && selectorChecker.checkSelector(onlySelector, element))
-            nodes.append(element);
-    } else {
-        for (Node* n = rootNode->firstChild(); n; n = n->traverseNextNode(rootNode)) {
-            if (n->isElementNode()) {
-                Element* element = static_cast<Element*>(n);
-                for (CSSSelector* selector = querySelectorList.first(); selector; selector = CSSSelectorList::next(selector)) {
-                    if (selectorChecker.checkSelector(selector, element)) {
-                        nodes.append(n);
-                        break;
-                    }
+    SelectorQueryIndex* index = 0;
+    bool triedIndex = false;
+    const SelectorQueryIndex::ElementVector* smallest = 0;
+    for (; selector; selector = selector->tagHistory()) {
+        if (selector->m_match == CSSSelector::Id && !document->inQuirksMode() && !document->containsMultipleElementsWithId(selector->value())) {
+            onlyCandidate = document->getElementById(selector->value());
+            return true;
+        }
+
+        bool hasLocalName = selector->hasTag() && selector->tag().localName() != starAtom;
+        if (selector->m_match == CSSSelector::Class || hasLocalName) {
+            if (!triedIndex) {
+                index = document->selectorQueryIndex();
+                triedIndex = true;
+            }
+            if (index) {
+                const SelectorQueryIndex::ElementVector* elements = 0;
+                if (selector->m_match == CSSSelector::Class) {
+                    elements = index->elementsWithClass(selector->value());
+                    if (!elements)
+                        return true;
+                    if (!smallest || elements->size() < smallest->size())
+                        smallest = elements;
+                }
+                if (hasLocalName) {
+                    elements = index->elementsWithLocalName(selector->tag().localName());
+                    if (!elements)
+                        return true;
+                    if (!smallest || elements->size() < smallest->size())
+                        smallest = elements;
                 }
             }
         }
+
+        if (selector->relation() != CSSSelector::SubSelector)
+            break;
     }
-    
+
+    if (!smallest)
+        return false;
+    candidates = smallest;
+    return true;
+}
+
+static inline bool isInScope(Node* rootNode, Element* element)
+{
+    return rootNode->isDocumentNode() || element->isDescendantOf(rootNode);
+}
+
+static void collectSelectorMatches(Node* rootNode, const CSSSelectorList& querySelectorList, bool firstMatchOnly, Vector<RefPtr<Node> >& nodes)
+{
+    Document* document = rootNode->document();
+    CSSStyleSelector::SelectorChecker selectorChecker(document, !document->inQuirksMode());
+
+    if (CSSSelector* onlySelector = querySelectorList.hasOneSelector() ? querySelectorList.first() : 0) {
+        Element* onlyCandidate;
+        const SelectorQueryIndex::ElementVector* candidates;
+        if (startSetForSelector(rootNode, onlySelector, onlyCandidate, candidates)) {
+            if (onlyCandidate && isInScope(rootNode, onlyCandidate) && selectorChecker.checkSelector(onlySelector, onlyCandidate))
+                nodes.append(onlyCandidate);
+            if (!candidates)
+                return;
+            // The candidates are in document order.
+            for (size_t i = 0; i < candidates->size(); ++i) {
+                Element* element = candidates->at(i);
+                if (isInScope(rootNode, element) && selectorChecker.checkSelector(onlySelector, element)) {
+                    nodes.append(element);
+                    if (firstMatchOnly)
+                        return;
+                }
+            }
+            return;
+        }
+    }
+
+    for (Node* n = rootNode->firstChild(); n; n = n->traverseNextNode(rootNode)) {
+        if (n->isElementNode()) {
+            Element* element = static_cast<Element*>(n);
+            for (CSSSelector* selector = querySelectorList.first(); selector; selector = CSSSelectorList::next(selector)) {
+                if (selectorChecker.checkSelector(selector, element)) {
+                    nodes.append(n);
+                    if (firstMatchOnly)
+                        return;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+PassRefPtr<StaticNodeList> createSelectorNodeList(Node* rootNode, const CSSSelectorList& querySelectorList)
+{
+    Vector<RefPtr<Node> > nodes;
+    collectSelectorMatches(rootNode, querySelectorList, false, nodes);
     return StaticNodeList::adopt(nodes);
 }
 
+Element* findFirstSelectorMatch(Node* rootNode, const CSSSelectorList& querySelectorList)
+{
+    Vector<RefPtr<Node> > nodes;
+    collectSelectorMatches(rootNode, querySelectorList, true, nodes);
+    return nodes.isEmpty() ? 0 : static_cast<Element*>(nodes[0].get());
+}
+
 } // namespace WebCore
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SelectorQueryIndex.h"
+
+#include "Document.h"
+#include "Element.h"
+#include "SpaceSplitString.h"
+#include "StyledElement.h"
+
+namespace WebCore {
+
+SelectorQueryIndex::SelectorQueryIndex()
+    : m_domTreeVersion(0)
+    , m_isBuilt(false)
+{
+}
+
+SelectorQueryIndex::~SelectorQueryIndex()
+{
+    clear();
+}
+
+bool SelectorQueryIndex::update(Document* document)
+{
+    if (document->domTreeVersion() != m_domTreeVersion) {
+        // The elements in the maps may be gone already, so they must not be
+        // touched, only dropped.
+        clear();
+        m_domTreeVersion = document->domTreeVersion();
+        return false;
+    }
+
+    if (!m_isBuilt)
+        build(document);
+    return true;
+}
+
+void SelectorQueryIndex::build(Document* document)
+{
+    for (Node* node = document->firstChild(); node; node = node->traverseNextNode()) {
+        if (!node->isElementNode())
+            continue;
+        Element* element = static_cast<Element*>(node);
+        add(m_localNameMap, element->localName(), element);
+        if (!element->hasClass())
+            continue;
+        const SpaceSplitString& classNames = static_cast<StyledElement*>(element)->classNames();
+        for (size_t i = 0; i < classNames.size(); ++i)
+            add(m_classMap, classNames[i], element);
+    }
+    m_isBuilt = true;
+}
+
+void SelectorQueryIndex::clear()
+{
+    deleteAllValues(m_classMap);
+    m_classMap.clear();
+    deleteAllValues(m_localNameMap);
+    m_localNameMap.clear();
+    m_isBuilt = false;
+}
+
+void SelectorQueryIndex::add(Map& map, const AtomicString& key, Element* element)
+{
+    std::pair<Map::iterator, bool> result = map.add(key, 0);
+    if (result.second)
+        result.first->second = new ElementVector;
+    ElementVector* elements = result.first->second;
+    // A class can be listed twice in the same attribute.
+    if (elements->isEmpty() || elements->last() != element)
+        elements->append(element);
+}
+
+} // namespace WebCore
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SelectorQueryIndex_h
+#define SelectorQueryIndex_h
+
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+#include <wtf/text/AtomicString.h>
+#include <wtf/text/AtomicStringHash.h>
+
+namespace WebCore {
+
+class Document;
+class Element;
+
+// Lists the elements of a document by class name and by local name, in
+// document order, so that querySelector and querySelectorAll only have to
+// check the elements that can match the rightmost compound selector.
+//
+// The index is thrown away whenever the DOM tree version of the document
+// changes. Since building it costs as much as the walk it saves, it is only
+// built once a second query sees the same version, as selector engines
+// running many queries between mutations do.
+class SelectorQueryIndex {
+    WTF_MAKE_NONCOPYABLE(SelectorQueryIndex); WTF_MAKE_FAST_ALLOCATED;
+public:
+    typedef Vector<Element*> ElementVector;
+
+    static PassOwnPtr<SelectorQueryIndex> create() { return adoptPtr(new SelectorQueryIndex); }
+    ~SelectorQueryIndex();
+
+    // Returns whether the index can be used for the current tree of |document|.
+    bool update(Document*);
+
+    // Return 0 if no element has the class or local name.
+    const ElementVector* elementsWithClass(const AtomicString& className) const { return m_classMap.get(className); }
+    const ElementVector* elementsWithLocalName(const AtomicString& localName) const { return m_localNameMap.get(localName); }
+
+private:
+    SelectorQueryIndex();
+
+    typedef HashMap<AtomicString, ElementVector*> Map;
+
+    void build(Document*);
+    void clear();
+    static void add(Map&, const AtomicString&, Element*);
+
+    Map m_classMap;
+    Map m_localNameMap;
+    uint64_t m_domTreeVersion;
+    bool m_isBuilt;
+};
+
+} // namespace WebCore
+
+#endif // SelectorQueryIndex_h
@@ -199,6 +199,7 @@ void StyledElement::attributeChanged(Attribute* attr, bool preserveDecls)
             attributeMap()->declAdded();
     }
 
+    notifyNodeListsAttributeChanged(attr->name());
     updateAfterAttributeChanged(attr);
 }
 
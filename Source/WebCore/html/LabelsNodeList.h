@@ -43,6 +43,11 @@ protected:
 
     virtual bool nodeMatches(Element*) const;
 
+    // A label's control is found through its for attribute, the ids of other
+    // elements or its descendants, so the cache is not kept across changes.
+    virtual void updateCacheForAppendedNode(Node*) { invalidateCache(); }
+    virtual bool dependsOnAttribute(const QualifiedName&) const { return true; }
+
 private:
     RefPtr<Node> m_forNode;
 };
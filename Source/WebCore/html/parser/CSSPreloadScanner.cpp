@@ -49,6 +49,13 @@ void CSSPreloadScanner::reset()
     m_ruleValue.clear();
 }
 
+void CSSPreloadScanner::takeImportURLs(Vector<String>& urls)
+{
+    ASSERT(!m_document);
+    urls.append(m_importURLs);
+    m_importURLs.clear();
+}
+
 void CSSPreloadScanner::scan(const HTMLToken& token, bool scanningBody)
 {
     m_scanningBody = scanningBody;
@@ -194,8 +201,12 @@ void CSSPreloadScanner::emitRule()
 {
     if (equalIgnoringCase("import", m_rule.data(), m_rule.size())) {
         String value = parseCSSStringOrURL(m_ruleValue.data(), m_ruleValue.size());
-        if (!value.isEmpty())
-            m_document->cachedResourceLoader()->preload(CachedResource::CSSStyleSheet, value, String(), m_scanningBody);
+        if (!value.isEmpty()) {
+            if (m_document)
+                m_document->cachedResourceLoader()->preload(CachedResource::CSSStyleSheet, value, String(), m_scanningBody);
+            else
+                m_importURLs.append(value);
+        }
         m_state = Initial;
     } else if (equalIgnoringCase("charset", m_rule.data(), m_rule.size()))
         m_state = Initial;
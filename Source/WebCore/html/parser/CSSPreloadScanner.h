@@ -43,6 +43,10 @@ public:
     void reset();
     void scan(const HTMLToken&, bool scanningBody);
 
+    // A scanner created without a Document (for example on the background
+    // preload scanner thread) collects @import URLs instead of preloading them.
+    void takeImportURLs(Vector<String>&);
+
 private:
     enum State {
         Initial,
@@ -66,6 +70,7 @@ private:
 
     bool m_scanningBody;
     Document* m_document;
+    Vector<String> m_importURLs;
 };
 
 }
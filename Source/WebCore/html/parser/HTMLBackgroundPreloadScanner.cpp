@@ -0,0 +1,346 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "HTMLBackgroundPreloadScanner.h"
+
+#if ENABLE(THREADED_PRELOAD_SCANNER)
+
+#include "CachedResourceLoader.h"
+#include "Document.h"
+#include "HTMLDocumentParser.h"
+#include "HTMLParserIdioms.h"
+#include "HTMLPreloadScanner.h"
+#include "HTMLTokenizer.h"
+#include "HTMLTreeBuilder.h"
+#include <wtf/MainThread.h>
+#include <wtf/MessageQueue.h>
+#include <wtf/StdLibExtras.h>
+
+namespace WebCore {
+
+namespace {
+
+// The HTMLNames atoms live in the main thread's AtomicString table, so the
+// scanner thread compares tag and attribute names by their characters.
+template<size_t inlineCapacity>
+bool nameIs(const Vector<UChar, inlineCapacity>& name, const char* expected)
+{
+    size_t length = strlen(expected);
+    if (name.size() != length)
+        return false;
+    for (size_t i = 0; i < length; ++i) {
+        if (name[i] != static_cast<UChar>(expected[i]))
+            return false;
+    }
+    return true;
+}
+
+template<size_t inlineCapacity>
+String toString(const Vector<UChar, inlineCapacity>& vector)
+{
+    return String(vector.data(), vector.size());
+}
+
+class ScanTask {
+    WTF_MAKE_NONCOPYABLE(ScanTask); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static PassOwnPtr<ScanTask> create(PassRefPtr<HTMLBackgroundPreloadScanner> scanner, const String& source)
+    {
+        return adoptPtr(new ScanTask(scanner, source));
+    }
+
+    void performTask() { m_scanner->scan(m_source); }
+
+private:
+    ScanTask(PassRefPtr<HTMLBackgroundPreloadScanner> scanner, const String& source)
+        : m_scanner(scanner)
+        , m_source(source)
+    {
+    }
+
+    RefPtr<HTMLBackgroundPreloadScanner> m_scanner;
+    String m_source;
+};
+
+// A single scanner thread is shared by all documents and lives as long as
+// the process, like the other WebCore helper threads on Android.
+class PreloadScannerThread {
+    WTF_MAKE_NONCOPYABLE(PreloadScannerThread); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static PreloadScannerThread& shared()
+    {
+        DEFINE_STATIC_LOCAL(PreloadScannerThread, thread, ());
+        return thread;
+    }
+
+    void scheduleTask(PassOwnPtr<ScanTask> task)
+    {
+        ASSERT(isMainThread());
+        if (!m_threadID)
+            m_threadID = createThread(PreloadScannerThread::threadEntryPointCallback, this, "WebCore: PreloadScanner");
+        m_queue.append(task);
+    }
+
+private:
+    PreloadScannerThread()
+        : m_threadID(0)
+    {
+    }
+
+    static void* threadEntryPointCallback(void* thread)
+    {
+        return static_cast<PreloadScannerThread*>(thread)->threadEntryPoint();
+    }
+
+    void* threadEntryPoint()
+    {
+        ASSERT(!isMainThread());
+        while (OwnPtr<ScanTask> task = m_queue.waitForMessage())
+            task->performTask();
+        return 0;
+    }
+
+    ThreadIdentifier m_threadID;
+    MessageQueue<ScanTask> m_queue;
+};
+
+} // namespace
+
+PassRefPtr<HTMLBackgroundPreloadScanner> HTMLBackgroundPreloadScanner::create(Document* document)
+{
+    return adoptRef(new HTMLBackgroundPreloadScanner(document));
+}
+
+HTMLBackgroundPreloadScanner::HTMLBackgroundPreloadScanner(Document* document)
+    : m_document(document)
+    , m_tokenizer(HTMLTokenizer::create(HTMLDocumentParser::usePreHTML5ParserQuirks(document)))
+    , m_cssScanner(0)
+    , m_scriptingEnabled(HTMLTreeBuilder::scriptEnabled(document->frame()))
+    , m_pluginsEnabled(HTMLTreeBuilder::pluginsEnabled(document->frame()))
+    , m_bodySeen(false)
+    , m_inStyle(false)
+    , m_deliveryScheduled(false)
+    , m_detached(false)
+{
+    ASSERT(isMainThread());
+}
+
+HTMLBackgroundPreloadScanner::~HTMLBackgroundPreloadScanner()
+{
+    ASSERT(!m_document);
+}
+
+void HTMLBackgroundPreloadScanner::appendToEnd(const SegmentedString& source)
+{
+    ASSERT(isMainThread());
+    ASSERT(m_document);
+    PreloadScannerThread::shared().scheduleTask(ScanTask::create(this, source.toString().crossThreadString()));
+}
+
+void HTMLBackgroundPreloadScanner::detach()
+{
+    ASSERT(isMainThread());
+    m_document = 0;
+    MutexLocker locker(m_pendingPreloadsMutex);
+    m_detached = true;
+    m_pendingPreloads.clear();
+}
+
+void HTMLBackgroundPreloadScanner::scan(const String& source)
+{
+    ASSERT(!isMainThread());
+    {
+        MutexLocker locker(m_pendingPreloadsMutex);
+        if (m_detached)
+            return;
+    }
+
+    m_source.append(SegmentedString(source));
+    while (m_tokenizer->nextToken(m_source, m_token)) {
+        processToken();
+        m_token.clear();
+    }
+
+    if (m_foundPreloads.isEmpty())
+        return;
+
+    MutexLocker locker(m_pendingPreloadsMutex);
+    if (m_detached) {
+        m_foundPreloads.clear();
+        return;
+    }
+    m_pendingPreloads.append(m_foundPreloads);
+    m_foundPreloads.clear();
+    // Preloads found while the main thread is busy are coalesced into the
+    // delivery that is already scheduled.
+    if (m_deliveryScheduled)
+        return;
+    m_deliveryScheduled = true;
+    ref();
+    callOnMainThread(deliverPendingPreloadsOnMainThread, this);
+}
+
+void HTMLBackgroundPreloadScanner::processToken()
+{
+    if (m_inStyle) {
+        if (m_token.type() == HTMLToken::Character) {
+            m_cssScanner.scan(m_token, m_bodySeen);
+            collectImportsFromStyle();
+        } else if (m_token.type() == HTMLToken::EndTag) {
+            m_inStyle = false;
+            m_cssScanner.reset();
+        }
+    }
+
+    if (m_token.type() != HTMLToken::StartTag)
+        return;
+
+    const HTMLToken::DataVector& tagName = m_token.name();
+    updateTokenizerState(tagName);
+
+    if (nameIs(tagName, "body"))
+        m_bodySeen = true;
+    else if (nameIs(tagName, "style"))
+        m_inStyle = true;
+
+    PendingPreload preload;
+    if (nameIs(tagName, "script"))
+        preload.kind = PendingPreload::Script;
+    else if (nameIs(tagName, "img"))
+        preload.kind = PendingPreload::Image;
+    else if (nameIs(tagName, "link"))
+        preload.kind = PendingPreload::Link;
+    else if (!nameIs(tagName, "input"))
+        return;
+    bool isInput = nameIs(tagName, "input");
+    bool inputIsImage = false;
+
+    const HTMLToken::AttributeList& attributes = m_token.attributes();
+    for (HTMLToken::AttributeList::const_iterator iter = attributes.begin(); iter != attributes.end(); ++iter) {
+        const HTMLToken::Attribute& attribute = *iter;
+        // We only respect the first src/href, per HTML5.
+        if (nameIs(attribute.m_name, preload.kind == PendingPreload::Link ? "href" : "src")) {
+            if (preload.url.isEmpty())
+                preload.url = stripLeadingAndTrailingHTMLSpaces(toString(attribute.m_value));
+        } else if (nameIs(attribute.m_name, "charset"))
+            preload.charset = toString(attribute.m_value);
+        else if (preload.kind == PendingPreload::Link && nameIs(attribute.m_name, "rel"))
+            preload.linkRel = toString(attribute.m_value);
+        else if (preload.kind == PendingPreload::Link && nameIs(attribute.m_name, "media"))
+            preload.linkMedia = toString(attribute.m_value);
+        else if (isInput && nameIs(attribute.m_name, "type"))
+            inputIsImage = equalIgnoringCase(toString(attribute.m_value), "image");
+    }
+
+    if (isInput) {
+        if (!inputIsImage)
+            return;
+        preload.kind = PendingPreload::Image;
+        preload.charset = String();
+    }
+    if (preload.url.isEmpty())
+        return;
+    preload.scanningBody = m_bodySeen;
+    m_foundPreloads.append(preload);
+}
+
+// Mirrors HTMLTokenizer::updateStateFor, which needs main thread atoms and a Frame.
+void HTMLBackgroundPreloadScanner::updateTokenizerState(const HTMLToken::DataVector& tagName)
+{
+    if (nameIs(tagName, "textarea") || nameIs(tagName, "title"))
+        m_tokenizer->setState(HTMLTokenizer::RCDATAState);
+    else if (nameIs(tagName, "plaintext"))
+        m_tokenizer->setState(HTMLTokenizer::PLAINTEXTState);
+    else if (nameIs(tagName, "script"))
+        m_tokenizer->setState(HTMLTokenizer::ScriptDataState);
+    else if (nameIs(tagName, "style")
+        || nameIs(tagName, "iframe")
+        || nameIs(tagName, "xmp")
+        || (nameIs(tagName, "noembed") && m_pluginsEnabled)
+        || nameIs(tagName, "noframes")
+        || (nameIs(tagName, "noscript") && m_scriptingEnabled))
+        m_tokenizer->setState(HTMLTokenizer::RAWTEXTState);
+}
+
+void HTMLBackgroundPreloadScanner::collectImportsFromStyle()
+{
+    Vector<String> urls;
+    m_cssScanner.takeImportURLs(urls);
+    for (size_t i = 0; i < urls.size(); ++i) {
+        PendingPreload preload;
+        preload.kind = PendingPreload::CSSImport;
+        preload.url = urls[i];
+        preload.scanningBody = m_bodySeen;
+        m_foundPreloads.append(preload);
+    }
+}
+
+void HTMLBackgroundPreloadScanner::deliverPendingPreloadsOnMainThread(void* context)
+{
+    HTMLBackgroundPreloadScanner* scanner = static_cast<HTMLBackgroundPreloadScanner*>(context);
+    scanner->deliverPendingPreloads();
+    scanner->deref();
+}
+
+void HTMLBackgroundPreloadScanner::deliverPendingPreloads()
+{
+    ASSERT(isMainThread());
+    Vector<PendingPreload> preloads;
+    {
+        MutexLocker locker(m_pendingPreloadsMutex);
+        m_deliveryScheduled = false;
+        preloads.swap(m_pendingPreloads);
+    }
+
+    if (!m_document)
+        return;
+
+    CachedResourceLoader* cachedResourceLoader = m_document->cachedResourceLoader();
+    bool documentHasBody = m_document->body();
+    for (size_t i = 0; i < preloads.size(); ++i) {
+        const PendingPreload& preload = preloads[i];
+        bool scanningBody = documentHasBody || preload.scanningBody;
+        switch (preload.kind) {
+        case PendingPreload::Script:
+            cachedResourceLoader->preload(CachedResource::Script, preload.url, preload.charset, scanningBody);
+            break;
+        case PendingPreload::Image:
+            cachedResourceLoader->preload(CachedResource::ImageResource, preload.url, String(), scanningBody);
+            break;
+        case PendingPreload::Link:
+            if (HTMLPreloadScanner::relAttributeIsStyleSheet(preload.linkRel) && HTMLPreloadScanner::linkMediaAttributeIsScreen(preload.linkMedia))
+                cachedResourceLoader->preload(CachedResource::CSSStyleSheet, preload.url, preload.charset, scanningBody);
+            break;
+        case PendingPreload::CSSImport:
+            cachedResourceLoader->preload(CachedResource::CSSStyleSheet, preload.url, String(), scanningBody);
+            break;
+        }
+    }
+}
+
+}
+
+#endif // ENABLE(THREADED_PRELOAD_SCANNER)
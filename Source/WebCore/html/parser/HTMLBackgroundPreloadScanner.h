@@ -0,0 +1,116 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HTMLBackgroundPreloadScanner_h
+#define HTMLBackgroundPreloadScanner_h
+
+#if ENABLE(THREADED_PRELOAD_SCANNER)
+
+#include "CSSPreloadScanner.h"
+#include "HTMLToken.h"
+#include "PlatformString.h"
+#include "SegmentedString.h"
+#include <wtf/OwnPtr.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class Document;
+class HTMLTokenizer;
+
+// Speculatively scans the decoded source of a document for subresources on a
+// shared background thread, as soon as the data arrives from the network.
+// Unlike HTMLPreloadScanner it does not wait for the parser to block on a
+// script. Anything that needs the DOM or main thread only state (rel and
+// media evaluation, URL completion) is deferred to the main thread, where
+// the discovered URLs are passed to CachedResourceLoader::preload in batches.
+class HTMLBackgroundPreloadScanner : public ThreadSafeRefCounted<HTMLBackgroundPreloadScanner> {
+public:
+    static PassRefPtr<HTMLBackgroundPreloadScanner> create(Document*);
+    ~HTMLBackgroundPreloadScanner();
+
+    // Called on the main thread.
+    void appendToEnd(const SegmentedString&);
+    void detach();
+
+    // Called on the scanner thread.
+    void scan(const String& source);
+
+private:
+    HTMLBackgroundPreloadScanner(Document*);
+
+    struct PendingPreload {
+        enum Kind {
+            Script,
+            Image,
+            Link,
+            CSSImport
+        };
+
+        Kind kind;
+        String url;
+        String charset;
+        String linkRel;
+        String linkMedia;
+        bool scanningBody;
+    };
+
+    // Called on the scanner thread.
+    void processToken();
+    void updateTokenizerState(const HTMLToken::DataVector& tagName);
+    void collectImportsFromStyle();
+
+    // Called on the main thread.
+    static void deliverPendingPreloadsOnMainThread(void*);
+    void deliverPendingPreloads();
+
+    // Only touched on the main thread.
+    Document* m_document;
+
+    // Only touched on the scanner thread once scanning has started.
+    OwnPtr<HTMLTokenizer> m_tokenizer;
+    SegmentedString m_source;
+    HTMLToken m_token;
+    CSSPreloadScanner m_cssScanner;
+    Vector<PendingPreload> m_foundPreloads;
+    bool m_scriptingEnabled;
+    bool m_pluginsEnabled;
+    bool m_bodySeen;
+    bool m_inStyle;
+
+    // Shared between the two threads.
+    Mutex m_pendingPreloadsMutex;
+    Vector<PendingPreload> m_pendingPreloads;
+    bool m_deliveryScheduled;
+    bool m_detached;
+};
+
+}
+
+#endif // ENABLE(THREADED_PRELOAD_SCANNER)
+
+#endif // HTMLBackgroundPreloadScanner_h
@@ -34,6 +34,9 @@
 #include "HTMLParserScheduler.h"
 #include "HTMLTokenizer.h"
 #include "HTMLPreloadScanner.h"
+#if ENABLE(THREADED_PRELOAD_SCANNER)
+#include "HTMLBackgroundPreloadScanner.h"
+#endif
 #include "HTMLScriptRunner.h"
 #include "HTMLTreeBuilder.h"
 #include "HTMLDocument.h"
@@ -105,6 +108,9 @@ HTMLDocumentParser::~HTMLDocumentParser()
     ASSERT(!m_parserScheduler);
     ASSERT(!m_pumpSessionNestingLevel);
     ASSERT(!m_preloadScanner);
+#if ENABLE(THREADED_PRELOAD_SCANNER)
+    ASSERT(!m_backgroundPreloadScanner);
+#endif
 }
 
 void HTMLDocumentParser::detach()
@@ -116,6 +122,12 @@ void HTMLDocumentParser::detach()
     // FIXME: It seems wrong that we would have a preload scanner here.
     // Yet during fast/dom/HTMLScriptElement/script-load-events.html we do.
     m_preloadScanner.clear();
+#if ENABLE(THREADED_PRELOAD_SCANNER)
+    if (m_backgroundPreloadScanner) {
+        m_backgroundPreloadScanner->detach();
+        m_backgroundPreloadScanner.clear();
+    }
+#endif
     m_parserScheduler.clear(); // Deleting the scheduler will clear any timers.
 }
 
@@ -287,7 +299,8 @@ void HTMLDocumentParser::pumpTokenizer(SynchronousMode mode)
     if (session.needsYield)
         m_parserScheduler->scheduleForResume();
 
-    if (isWaitingForScripts()) {
+    // The background scanner has already looked at everything we have received.
+    if (isWaitingForScripts() && !hasBackgroundPreloadScanner()) {
         ASSERT(m_tokenizer->state() == HTMLTokenizer::DataState);
         if (!m_preloadScanner) {
             m_preloadScanner.set(new HTMLPreloadScanner(document()));
@@ -343,6 +356,15 @@ void HTMLDocumentParser::append(const SegmentedString& source)
     // but we need to ensure it isn't deleted yet.
     RefPtr<HTMLDocumentParser> protect(this);
 
+#if ENABLE(THREADED_PRELOAD_SCANNER)
+    // Network data is scanned for subresources off the main thread as soon as it
+    // arrives, so there is no need to fall back to scanning when we block on a script.
+    if (!m_backgroundPreloadScanner && !isParsingFragment() && document()->frame())
+        m_backgroundPreloadScanner = HTMLBackgroundPreloadScanner::create(document());
+    if (m_backgroundPreloadScanner)
+        m_backgroundPreloadScanner->appendToEnd(source);
+#endif
+
     if (m_preloadScanner) {
         if (m_input.current().isEmpty() && !isWaitingForScripts()) {
             // We have parsed until the end of the current input and so are now moving ahead of the preload scanner.
@@ -48,6 +48,9 @@ class HTMLTokenizer;
 class HTMLScriptRunner;
 class HTMLTreeBuilder;
 class HTMLPreloadScanner;
+#if ENABLE(THREADED_PRELOAD_SCANNER)
+class HTMLBackgroundPreloadScanner;
+#endif
 class ScriptController;
 class ScriptSourceCode;
 
@@ -136,6 +139,11 @@ private:
     bool isScheduledForResume() const;
     bool inScriptExecution() const;
     bool inPumpSession() const { return m_pumpSessionNestingLevel > 0; }
+#if ENABLE(THREADED_PRELOAD_SCANNER)
+    bool hasBackgroundPreloadScanner() const { return m_backgroundPreloadScanner.get(); }
+#else
+    bool hasBackgroundPreloadScanner() const { return false; }
+#endif
     bool shouldDelayEnd() const { return inPumpSession() || isWaitingForScripts() || inScriptExecution() || isScheduledForResume(); }
 
     ScriptController* script() const;
@@ -149,6 +157,9 @@ private:
     OwnPtr<HTMLScriptRunner> m_scriptRunner;
     OwnPtr<HTMLTreeBuilder> m_treeBuilder;
     OwnPtr<HTMLPreloadScanner> m_preloadScanner;
+#if ENABLE(THREADED_PRELOAD_SCANNER)
+    RefPtr<HTMLBackgroundPreloadScanner> m_backgroundPreloadScanner;
+#endif
     OwnPtr<HTMLParserScheduler> m_parserScheduler;
     HTMLSourceTracker m_sourceTracker;
     XSSFilter m_xssFilter;
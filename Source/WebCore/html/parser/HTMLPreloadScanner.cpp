@@ -79,9 +79,9 @@ public:
                 if (attributeName == hrefAttr)
                     setUrlToLoad(attributeValue);
                 else if (attributeName == relAttr)
-                    m_linkIsStyleSheet = relAttributeIsStyleSheet(attributeValue);
+                    m_linkIsStyleSheet = HTMLPreloadScanner::relAttributeIsStyleSheet(attributeValue);
                 else if (attributeName == mediaAttr)
-                    m_linkMediaAttributeIsScreen = linkMediaAttributeIsScreen(attributeValue);
+                    m_linkMediaAttributeIsScreen = HTMLPreloadScanner::linkMediaAttributeIsScreen(attributeValue);
             } else if (m_tagName == inputTag) {
                 if (attributeName == srcAttr)
                     setUrlToLoad(attributeValue);
@@ -91,26 +91,6 @@ public:
         }
     }
 
-    static bool relAttributeIsStyleSheet(const String& attributeValue)
-    {
-        HTMLLinkElement::RelAttribute rel;
-        HTMLLinkElement::tokenizeRelAttribute(attributeValue, rel);
-        return rel.m_isStyleSheet && !rel.m_isAlternate && !rel.m_isIcon && !rel.m_isDNSPrefetch;
-    }
-
-    static bool linkMediaAttributeIsScreen(const String& attributeValue)
-    {
-        if (attributeValue.isEmpty())
-            return true;
-        RefPtr<MediaList> mediaList = MediaList::createAllowingDescriptionSyntax(attributeValue);
-    
-        // Only preload screen media stylesheets. Used this way, the evaluator evaluates to true for any 
-        // rules containing complex queries (full evaluation is possible but it requires a frame and a style selector which
-        // may be problematic here).
-        MediaQueryEvaluator mediaQueryEvaluator("screen");
-        return mediaQueryEvaluator.eval(mediaList.get());
-    }
-
     void setUrlToLoad(const String& attributeValue)
     {
         // We only respect the first src/href, per HTML5:
@@ -156,6 +136,26 @@ HTMLPreloadScanner::HTMLPreloadScanner(Document* document)
 {
 }
 
+bool HTMLPreloadScanner::relAttributeIsStyleSheet(const String& attributeValue)
+{
+    HTMLLinkElement::RelAttribute rel;
+    HTMLLinkElement::tokenizeRelAttribute(attributeValue, rel);
+    return rel.m_isStyleSheet && !rel.m_isAlternate && !rel.m_isIcon && !rel.m_isDNSPrefetch;
+}
+
+bool HTMLPreloadScanner::linkMediaAttributeIsScreen(const String& attributeValue)
+{
+    if (attributeValue.isEmpty())
+        return true;
+    RefPtr<MediaList> mediaList = MediaList::createAllowingDescriptionSyntax(attributeValue);
+
+    // Only preload screen media stylesheets. Used this way, the evaluator evaluates to true for any 
+    // rules containing complex queries (full evaluation is possible but it requires a frame and a style selector which
+    // may be problematic here).
+    MediaQueryEvaluator mediaQueryEvaluator("screen");
+    return mediaQueryEvaluator.eval(mediaList.get());
+}
+
 void HTMLPreloadScanner::appendToEnd(const SegmentedString& source)
 {
     m_source.append(source);
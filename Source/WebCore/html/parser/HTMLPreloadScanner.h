@@ -46,6 +46,9 @@ public:
     void appendToEnd(const SegmentedString&);
     void scan();
 
+    static bool relAttributeIsStyleSheet(const String&);
+    static bool linkMediaAttributeIsScreen(const String&);
+
 private:
     void processToken();
     bool scanningBody() const;
@@ -584,15 +584,14 @@ void DocumentLoader::substituteResourceDeliveryTimerFired(Timer<DocumentLoader>*
     for (SubstituteResourceMap::const_iterator it = copy.begin(); it != end; ++it) {
         RefPtr<ResourceLoader> loader = it->first;
         SubstituteResource* resource = it->second.get();
+        SharedBuffer* data = resource ? resource->data() : 0;
         
-        if (resource) {
-            SharedBuffer* data = resource->data();
-        
+        if (data) {
             loader->didReceiveResponse(resource->response());
             loader->didReceiveData(data->data(), data->size(), data->size(), true);
             loader->didFinishLoading(0);
         } else {
-            // A null resource means that we should fail the load.
+            // A null resource, or one whose data could not be read, means that we should fail the load.
             // FIXME: Maybe we should use another error here - something like "not in cache".
             loader->didFail(loader->cannotShowURLError());
         }
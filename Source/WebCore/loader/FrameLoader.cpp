@@ -92,6 +92,7 @@
 #include "SegmentedString.h"
 #include "SerializedScriptValue.h"
 #include "Settings.h"
+#include "StorageNamespace.h"
 #include "TextResourceDecoder.h"
 #include "WindowFeatures.h"
 #include "XMLDocumentParser.h"
@@ -677,6 +678,14 @@ void FrameLoader::didBeginDocument(bool dispatch)
             m_frame->document()->contentSecurityPolicy()->didReceiveHeader(contentSecurityPolicy);
     }
 
+#if ENABLE(DOM_STORAGE)
+    // Start importing the origin's local storage from disk on the storage thread, so it
+    // is likely to be ready by the time a script asks for it.
+    Page* page = m_frame->page();
+    if (page && settings && settings->localStorageEnabled() && m_frame->document()->securityOrigin()->canAccessLocalStorage())
+        page->group().localStorage()->prewarmStorageArea(m_frame->document()->securityOrigin());
+#endif
+
     history()->restoreDocumentState();
 }
 
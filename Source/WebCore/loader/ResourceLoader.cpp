@@ -293,6 +293,30 @@ void ResourceLoader::didReceiveData(const char* data, int length, long long enco
         frameLoader()->notifier()->didReceiveData(this, data, length, static_cast<int>(encodedDataLength));
 }
 
+#if PLATFORM(ANDROID)
+void ResourceLoader::didReceiveDataSegments(const Vector<RefPtr<SharedBuffer::DataSegment> >& segments)
+{
+    // Protect this in this delegate method since the additional processing can do
+    // anything including possibly derefing this; one example of this is Radar 3266216.
+    RefPtr<ResourceLoader> protector(this);
+
+    for (size_t i = 0; i < segments.size(); ++i) {
+        SharedBuffer::DataSegment* segment = segments[i].get();
+        int length = static_cast<int>(segment->size());
+
+        if (m_shouldBufferData) {
+            // Hold on to the network buffer rather than copying it.
+            if (!m_resourceData)
+                m_resourceData = SharedBuffer::create();
+            m_resourceData->append(segment);
+        }
+
+        if (m_sendResourceLoadCallbacks && m_frame)
+            frameLoader()->notifier()->didReceiveData(this, segment->data(), length, length);
+    }
+}
+#endif
+
 void ResourceLoader::willStopBufferingData(const char* data, int length)
 {
     if (!m_shouldBufferData)
@@ -91,6 +91,9 @@ namespace WebCore {
 #if HAVE(CFNETWORK_DATA_ARRAY_CALLBACK)
         virtual void didReceiveDataArray(CFArrayRef dataArray);
 #endif
+#if PLATFORM(ANDROID)
+        virtual void didReceiveDataSegments(const Vector<RefPtr<SharedBuffer::DataSegment> >&);
+#endif
 
         virtual bool shouldUseCredentialStorage();
         virtual void didReceiveAuthenticationChallenge(const AuthenticationChallenge&);
@@ -117,6 +120,9 @@ namespace WebCore {
 #if HAVE(CFNETWORK_DATA_ARRAY_CALLBACK)
         virtual void didReceiveDataArray(ResourceHandle*, CFArrayRef dataArray);
 #endif
+#if PLATFORM(ANDROID)
+        virtual void didReceiveDataSegments(ResourceHandle*, const Vector<RefPtr<SharedBuffer::DataSegment> >& segments) { didReceiveDataSegments(segments); }
+#endif
 #if USE(PROTECTION_SPACE_AUTH_CALLBACK)
         virtual bool canAuthenticateAgainstProtectionSpace(ResourceHandle*, const ProtectionSpace& protectionSpace) { return canAuthenticateAgainstProtectionSpace(protectionSpace); }
 #endif
@@ -169,6 +169,23 @@ void SubresourceLoader::didReceiveData(const char* data, int length, long long e
         m_client->didReceiveData(this, data, length);
 }
 
+#if PLATFORM(ANDROID)
+void SubresourceLoader::didReceiveDataSegments(const Vector<RefPtr<SharedBuffer::DataSegment> >& segments)
+{
+    // Reference the object in this method since the additional processing can do
+    // anything including removing the last reference to this object; one example of this is 3266216.
+    RefPtr<SubresourceLoader> protect(this);
+
+    ResourceLoader::didReceiveDataSegments(segments);
+
+    // A subresource loader does not load multipart sections progressively.
+    // So don't deliver any data to the loader yet. The client may clear itself
+    // from its callback, so the whole batch goes out in one call.
+    if (!m_loadingMultipartContent && m_client && !reachedTerminalState())
+        m_client->didReceiveDataSegments(this, segments);
+}
+#endif
+
 void SubresourceLoader::didReceiveCachedMetadata(const char* data, int length)
 {
     // Reference the object in this method since the additional processing can do
@@ -29,6 +29,12 @@
 #ifndef SubresourceLoaderClient_h
 #define SubresourceLoaderClient_h
 
+#if PLATFORM(ANDROID)
+#include "SharedBuffer.h"
+#include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
+#endif
+
 namespace WebCore {
 
 class AuthenticationChallenge;
@@ -47,6 +53,22 @@ public:
 
     virtual void didReceiveResponse(SubresourceLoader*, const ResourceResponse&) { }
     virtual void didReceiveData(SubresourceLoader*, const char*, int /*dataLength*/) { }
+#if PLATFORM(ANDROID)
+    // A batch of network buffers, already appended to the loader's resource data.
+    // The default delivers the batch as a single didReceiveData call.
+    virtual void didReceiveDataSegments(SubresourceLoader* loader, const Vector<RefPtr<SharedBuffer::DataSegment> >& segments)
+    {
+        if (segments.size() == 1) {
+            didReceiveData(loader, segments[0]->data(), static_cast<int>(segments[0]->size()));
+            return;
+        }
+        Vector<char> data;
+        for (size_t i = 0; i < segments.size(); ++i)
+            data.append(segments[i]->data(), segments[i]->size());
+        if (!data.isEmpty())
+            didReceiveData(loader, data.data(), static_cast<int>(data.size()));
+    }
+#endif
     virtual void didReceiveCachedMetadata(SubresourceLoader*, const char*, int /*dataLength*/) { }
     virtual void didFinishLoading(SubresourceLoader*, double /*finishTime*/) { }
     virtual void didFail(SubresourceLoader*, const ResourceError&) { }
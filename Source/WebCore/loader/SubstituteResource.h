@@ -42,7 +42,7 @@ public:
 
     const KURL& url() const { return m_url; }
     const ResourceResponse& response() const { return m_response; }
-    SharedBuffer* data() const { return m_data.get(); }
+    virtual SharedBuffer* data() const { return m_data.get(); }
 
 protected:
     SubstituteResource(const KURL& url, const ResourceResponse& response, PassRefPtr<SharedBuffer> data)
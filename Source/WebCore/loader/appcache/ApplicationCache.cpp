@@ -184,6 +184,13 @@ void ApplicationCache::clearStorageID()
     for (ResourceMap::const_iterator it = m_resources.begin(); it != end; ++it)
         it->second->clearStorageID();
 }
+
+void ApplicationCache::loadResourceData()
+{
+    ResourceMap::const_iterator end = m_resources.end();
+    for (ResourceMap::const_iterator it = m_resources.begin(); it != end; ++it)
+        it->second->data();
+}
     
 void ApplicationCache::deleteCacheForOrigin(SecurityOrigin* origin)
 {
@@ -89,6 +89,9 @@ public:
     void setStorageID(unsigned storageID) { m_storageID = storageID; }
     unsigned storageID() const { return m_storageID; }
     void clearStorageID();
+
+    // Reads the bodies of the resources that ApplicationCacheStorage::loadCache() left in storage.
+    void loadResourceData();
     
     static bool requestIsHTTPOrHTTPSGet(const ResourceRequest&);
 
@@ -512,6 +512,11 @@ void ApplicationCacheGroup::didReceiveResponse(ResourceHandle* handle, const Res
     if (m_newestCache && response.httpStatusCode() == 304) { // Not modified.
         ApplicationCacheResource* newestCachedResource = m_newestCache->resourceForURL(url);
         if (newestCachedResource) {
+            if (!newestCachedResource->data()) {
+                // Note that cacheUpdateFailed() can cause the cache group to be deleted.
+                cacheUpdateFailed();
+                return;
+            }
             m_cacheBeingUpdated->addResource(ApplicationCacheResource::create(url, newestCachedResource->response(), type, newestCachedResource->data(), newestCachedResource->path()));
             m_pendingEntries.remove(m_currentHandle->firstRequest().url());
             m_currentHandle->cancel();
@@ -540,6 +545,11 @@ void ApplicationCacheGroup::didReceiveResponse(ResourceHandle* handle, const Res
             ASSERT(m_newestCache);
             ApplicationCacheResource* newestCachedResource = m_newestCache->resourceForURL(handle->firstRequest().url());
             ASSERT(newestCachedResource);
+            if (!newestCachedResource->data()) {
+                // Note that cacheUpdateFailed() can cause the cache group to be deleted.
+                cacheUpdateFailed();
+                return;
+            }
             m_cacheBeingUpdated->addResource(ApplicationCacheResource::create(url, newestCachedResource->response(), type, newestCachedResource->data(), newestCachedResource->path()));
             m_pendingEntries.remove(m_currentHandle->firstRequest().url());
             m_currentHandle->cancel();
@@ -644,6 +654,11 @@ void ApplicationCacheGroup::didFail(ResourceHandle* handle, const ResourceError&
         ASSERT(m_newestCache);
         ApplicationCacheResource* newestCachedResource = m_newestCache->resourceForURL(url);
         ASSERT(newestCachedResource);
+        if (!newestCachedResource->data()) {
+            // Note that cacheUpdateFailed() can cause the cache group to be deleted.
+            cacheUpdateFailed();
+            return;
+        }
         m_cacheBeingUpdated->addResource(ApplicationCacheResource::create(url, newestCachedResource->response(), type, newestCachedResource->data(), newestCachedResource->path()));
         // Load the next resource, if any.
         startLoadingEntry();
@@ -694,8 +709,9 @@ void ApplicationCacheGroup::didFinishLoadingManifest()
         ApplicationCacheResource* newestManifest = m_newestCache->manifestResource();
         ASSERT(newestManifest);
     
+        SharedBuffer* newestManifestData = newestManifest->data();
         if (!m_manifestResource || // The resource will be null if HTTP response was 304 Not Modified.
-            (newestManifest->data()->size() == m_manifestResource->data()->size() && !memcmp(newestManifest->data()->data(), m_manifestResource->data()->data(), newestManifest->data()->size()))) {
+            (newestManifestData && newestManifestData->size() == m_manifestResource->data()->size() && !memcmp(newestManifestData->data(), m_manifestResource->data()->data(), newestManifestData->size()))) {
 
             m_completionType = NoUpdate;
             m_manifestResource = 0;
@@ -1130,6 +1146,15 @@ void ApplicationCacheGroup::clearStorageID()
         (*it)->clearStorageID();
 }
 
+void ApplicationCacheGroup::loadResourceDataOfCachesInUse()
+{
+    HashSet<DocumentLoader*>::const_iterator end = m_associatedDocumentLoaders.end();
+    for (HashSet<DocumentLoader*>::const_iterator it = m_associatedDocumentLoaders.begin(); it != end; ++it) {
+        if (ApplicationCache* cache = (*it)->applicationCacheHost()->applicationCache())
+            cache->loadResourceData();
+    }
+}
+
 
 }
 
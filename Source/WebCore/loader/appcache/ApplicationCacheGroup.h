@@ -75,6 +75,10 @@ public:
     void setStorageID(unsigned storageID) { m_storageID = storageID; }
     unsigned storageID() const { return m_storageID; }
     void clearStorageID();
+
+    // Reads into memory the resource bodies of the caches that documents are still associated
+    // with, so that the documents can keep using them after they are removed from storage.
+    void loadResourceDataOfCachesInUse();
     
     void update(Frame*, ApplicationCacheUpdateOption); // FIXME: Frame should not be needed when updating without browsing context.
     void cacheDestroyed(ApplicationCache*);
@@ -84,9 +84,14 @@ void ApplicationCacheHost::maybeLoadMainResource(ResourceRequest& request, Subst
         if (m_mainResourceApplicationCache) {
             // Get the resource from the application cache. By definition, cacheForMainRequest() returns a cache that contains the resource.
             ApplicationCacheResource* resource = m_mainResourceApplicationCache->resourceForRequest(request);
-            substituteData = SubstituteData(resource->data(), 
-                                            resource->response().mimeType(),
-                                            resource->response().textEncodingName(), KURL());
+            if (SharedBuffer* data = resource->data()) {
+                substituteData = SubstituteData(data,
+                                                resource->response().mimeType(),
+                                                resource->response().textEncodingName(), KURL());
+            } else {
+                // The body could not be read from storage, so load the main resource normally.
+                m_mainResourceApplicationCache = 0;
+            }
         }
     }
 }
@@ -201,9 +206,10 @@ bool ApplicationCacheHost::maybeLoadSynchronously(ResourceRequest& request, Reso
 {
     ApplicationCacheResource* resource;
     if (shouldLoadResourceFromApplicationCache(request, resource)) {
-        if (resource) {
+        SharedBuffer* resourceData = resource ? resource->data() : 0;
+        if (resourceData) {
             response = resource->response();
-            data.append(resource->data()->data(), resource->data()->size());
+            data.append(resourceData->data(), resourceData->size());
         } else {
             error = documentLoader()->frameLoader()->client()->cannotShowURLError(request);
         }
@@ -222,9 +228,11 @@ void ApplicationCacheHost::maybeLoadFallbackSynchronously(const ResourceRequest&
          || !protocolHostAndPortAreEqual(request.url(), response.url())) {
         ApplicationCacheResource* resource;
         if (getApplicationCacheFallbackResource(request, resource)) {
-            response = resource->response();
-            data.clear();
-            data.append(resource->data()->data(), resource->data()->size());
+            if (SharedBuffer* resourceData = resource->data()) {
+                response = resource->response();
+                data.clear();
+                data.append(resourceData->data(), resourceData->size());
+            }
         }
     }
 }
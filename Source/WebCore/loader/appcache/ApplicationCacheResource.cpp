@@ -25,7 +25,11 @@
 
 #include "config.h"
 #include "ApplicationCacheResource.h"
+
+#include "ApplicationCacheStorage.h"
+#include "Logging.h"
 #include <stdio.h>
+#include <wtf/text/CString.h>
 
 #if ENABLE(OFFLINE_WEB_APPLICATIONS)
 
@@ -37,7 +41,46 @@ ApplicationCacheResource::ApplicationCacheResource(const KURL& url, const Resour
     , m_storageID(0)
     , m_estimatedSizeInStorage(0)
     , m_path(path)
+    , m_dataStorageID(0)
+    , m_dataSize(0)
+    , m_dataRemovedFromStorage(false)
+{
+}
+
+SharedBuffer* ApplicationCacheResource::data() const
+{
+    if (!m_dataStorageID)
+        return SubstituteResource::data();
+
+    if (!m_loadedData && !m_dataRemovedFromStorage) {
+        m_loadedData = cacheStorage().loadResourceData(m_dataStorageID, m_path);
+        if (!m_loadedData)
+            LOG_ERROR("Could not load the data of application cache resource %s", url().string().utf8().data());
+    }
+    return m_loadedData.get();
+}
+
+void ApplicationCacheResource::setDataInStorage(unsigned dataStorageID, int64_t dataSize)
 {
+    ASSERT(dataStorageID);
+
+    if (!m_dataStorageID)
+        SubstituteResource::data()->clear();
+
+    m_dataStorageID = dataStorageID;
+    m_dataSize = dataSize;
+    m_loadedData = 0;
+    m_dataRemovedFromStorage = false;
+}
+
+void ApplicationCacheResource::clearStorageID()
+{
+    m_storageID = 0;
+
+    // A body that has not been read yet is gone with the rest of the resource's storage, and its
+    // id may be reused by another resource.
+    if (m_dataStorageID && !m_loadedData)
+        m_dataRemovedFromStorage = true;
 }
 
 void ApplicationCacheResource::addType(unsigned type) 
@@ -51,7 +94,10 @@ int64_t ApplicationCacheResource::estimatedSizeInStorage()
     if (m_estimatedSizeInStorage)
       return m_estimatedSizeInStorage;
 
-    if (data())
+    // Don't read the body from storage just to find out its size.
+    if (m_dataStorageID && !m_loadedData)
+        m_estimatedSizeInStorage = m_dataSize;
+    else if (data())
         m_estimatedSizeInStorage = data()->size();
 
     HTTPHeaderMap::const_iterator end = response().httpHeaderFields().end();
@@ -48,12 +48,31 @@ public:
         return adoptRef(new ApplicationCacheResource(url, response, type, buffer, path));
     }
 
+    // Used by ApplicationCacheStorage::loadCache(). The body is only read from storage, or
+    // mapped from the flat file at |path|, when data() is first called.
+    static PassRefPtr<ApplicationCacheResource> createWithDataInStorage(const KURL& url, const ResourceResponse& response, unsigned type, unsigned dataStorageID, int64_t dataSize, const String& path)
+    {
+        ASSERT(!url.hasFragmentIdentifier());
+        ASSERT(dataStorageID);
+        RefPtr<ApplicationCacheResource> resource = adoptRef(new ApplicationCacheResource(url, response, type, SharedBuffer::create(), path));
+        resource->m_dataStorageID = dataStorageID;
+        resource->m_dataSize = dataSize;
+        return resource.release();
+    }
+
+    // Returns 0 if the body could not be read from storage.
+    virtual SharedBuffer* data() const;
+
+    // Called once the body has been written to storage. Drops the in-memory copy; the
+    // body is read back from storage the next time data() is called.
+    void setDataInStorage(unsigned dataStorageID, int64_t dataSize);
+
     unsigned type() const { return m_type; }
     void addType(unsigned type);
     
     void setStorageID(unsigned storageID) { m_storageID = storageID; }
     unsigned storageID() const { return m_storageID; }
-    void clearStorageID() { m_storageID = 0; }
+    void clearStorageID();
     int64_t estimatedSizeInStorage();
 
     const String& path() const { return m_path; }
@@ -70,6 +89,12 @@ private:
     unsigned m_storageID;
     int64_t m_estimatedSizeInStorage;
     String m_path;
+
+    // Only set for resources whose body has not been read from storage yet.
+    unsigned m_dataStorageID;
+    int64_t m_dataSize;
+    mutable RefPtr<SharedBuffer> m_loadedData;
+    bool m_dataRemovedFromStorage;
 };
     
 } // namespace WebCore
@@ -43,12 +43,23 @@
 #include <wtf/StdLibExtras.h>
 #include <wtf/StringExtras.h>
 
+#if PLATFORM(ANDROID)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 using namespace std;
 
 namespace WebCore {
 
 static const char flatFileSubdirectory[] = "ApplicationCache";
 
+// Resource bodies at least this large are stored as flat files rather than in the database,
+// so that they can be mapped into memory when they are used.
+static const unsigned flatFileSizeThreshold = 64 * 1024;
+
 template <class T>
 class StorageIDJournal {
 public:  
@@ -793,7 +804,10 @@ bool ApplicationCacheStorage::store(ApplicationCacheResource* resource, unsigned
     String fullPath;
     if (!resource->path().isEmpty())
         dataStatement.bindText(2, pathGetFileName(resource->path()));
-    else if (shouldStoreResourceAsFlatFile(resource)) {
+    else if (!resource->data()) {
+        // The body could not be read back from storage, so there is nothing to copy.
+        return false;
+    } else if (shouldStoreResourceAsFlatFile(resource)) {
         // First, check to see if creating the flat file would violate the maximum total quota. We don't need
         // to check the per-origin quota here, as it was already checked in storeNewestCache().
         if (m_database.totalSize() + flatFileAreaSize() + resource->data()->size() > m_maximumSize) {
@@ -876,7 +890,7 @@ bool ApplicationCacheStorage::store(ApplicationCacheResource* resource, unsigned
     // release the resource's data and free up a potentially large amount
     // of memory:
     if (!fullPath.isEmpty())
-        resource->data()->clear();
+        resource->setDataInStorage(dataId, resource->data()->size());
 
     resource->setStorageID(resourceId);
     return true;
@@ -1055,7 +1069,7 @@ static inline void parseHeaders(const String& headers, ResourceResponse& respons
 PassRefPtr<ApplicationCache> ApplicationCacheStorage::loadCache(unsigned storageID)
 {
     SQLiteStatement cacheStatement(m_database, 
-                                   "SELECT url, type, mimeType, textEncodingName, headers, CacheResourceData.data, CacheResourceData.path FROM CacheEntries INNER JOIN CacheResources ON CacheEntries.resource=CacheResources.id "
+                                   "SELECT url, type, mimeType, textEncodingName, headers, CacheResourceData.id, length(CacheResourceData.data), CacheResourceData.path FROM CacheEntries INNER JOIN CacheResources ON CacheEntries.resource=CacheResources.id "
                                    "INNER JOIN CacheResourceData ON CacheResourceData.id=CacheResources.data WHERE CacheEntries.cache=?");
     if (cacheStatement.prepare() != SQLResultOk) {
         LOG_ERROR("Could not prepare cache statement, error \"%s\"", m_database.lastErrorMsg());
@@ -1074,15 +1088,13 @@ PassRefPtr<ApplicationCache> ApplicationCacheStorage::loadCache(unsigned storage
         
         unsigned type = static_cast<unsigned>(cacheStatement.getColumnInt64(1));
 
-        Vector<char> blob;
-        cacheStatement.getColumnBlobAsVector(5, blob);
+        // The body itself is only read when the resource is used.
+        unsigned dataStorageID = static_cast<unsigned>(cacheStatement.getColumnInt64(5));
         
-        RefPtr<SharedBuffer> data = SharedBuffer::adoptVector(blob);
-        
-        String path = cacheStatement.getColumnText(6);
+        String path = cacheStatement.getColumnText(7);
         long long size = 0;
         if (path.isEmpty())
-            size = data->size();
+            size = cacheStatement.getColumnInt64(6);
         else {
             path = pathByAppendingComponent(flatFileDirectory, path);
             getFileSize(path, size);
@@ -1096,7 +1108,7 @@ PassRefPtr<ApplicationCache> ApplicationCacheStorage::loadCache(unsigned storage
         String headers = cacheStatement.getColumnText(4);
         parseHeaders(headers, response);
         
-        RefPtr<ApplicationCacheResource> resource = ApplicationCacheResource::create(url, response, type, data.release(), path);
+        RefPtr<ApplicationCacheResource> resource = ApplicationCacheResource::createWithDataInStorage(url, response, type, dataStorageID, size, path);
 
         if (type & ApplicationCacheResource::Manifest)
             cache->setManifestResource(resource.release());
@@ -1169,6 +1181,9 @@ void ApplicationCacheStorage::remove(ApplicationCache* cache)
     ASSERT(cache->group());
     ASSERT(cache->group()->storageID());
 
+    // Documents may still be using the cache, and they read its resource bodies lazily.
+    cache->group()->loadResourceDataOfCachesInUse();
+
     // All associated data will be deleted by database triggers.
     SQLiteStatement statement(m_database, "DELETE FROM Caches WHERE id=?");
     if (statement.prepare() != SQLResultOk)
@@ -1200,6 +1215,11 @@ void ApplicationCacheStorage::empty()
     
     if (!m_database.isOpen())
         return;
+
+    // The caches in memory keep working, so read the resource bodies they still need first.
+    CacheGroupMap::const_iterator end = m_cachesInMemory.end();
+    for (CacheGroupMap::const_iterator it = m_cachesInMemory.begin(); it != end; ++it)
+        it->second->loadResourceDataOfCachesInUse();
     
     // Clear cache groups, caches, cache resources, and origins.
     executeSQLCommand("DELETE FROM CacheGroups");
@@ -1209,7 +1229,6 @@ void ApplicationCacheStorage::empty()
     // Clear the storage IDs for the caches in memory.
     // The caches will still work, but cached resources will not be saved to disk 
     // until a cache update process has been initiated.
-    CacheGroupMap::const_iterator end = m_cachesInMemory.end();
     for (CacheGroupMap::const_iterator it = m_cachesInMemory.begin(); it != end; ++it)
         it->second->clearStorageID();
     
@@ -1224,8 +1243,102 @@ void ApplicationCacheStorage::deleteTables()
     
 bool ApplicationCacheStorage::shouldStoreResourceAsFlatFile(ApplicationCacheResource* resource)
 {
-    return resource->response().mimeType().startsWith("audio/", false) 
-        || resource->response().mimeType().startsWith("video/", false);
+    if (resource->response().mimeType().startsWith("audio/", false)
+        || resource->response().mimeType().startsWith("video/", false))
+        return true;
+
+    SharedBuffer* data = resource->data();
+    return data && data->size() >= flatFileSizeThreshold;
+}
+
+#if PLATFORM(ANDROID)
+// Lets a SharedBuffer use the pages of a flat file directly. Only the parts of the resource
+// that are actually read become resident, and the kernel can drop them again when it needs to.
+class MappedFileSegment : public SharedBuffer::DataSegment {
+public:
+    static PassRefPtr<MappedFileSegment> create(const String& path)
+    {
+        CString filename = fileSystemRepresentation(path);
+        int fd = open(filename.data(), O_RDONLY);
+        if (fd == -1)
+            return 0;
+
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) || static_cast<unsigned>(fileStat.st_size) != fileStat.st_size) {
+            close(fd);
+            return 0;
+        }
+
+        if (!fileStat.st_size) {
+            close(fd);
+            return adoptRef(new MappedFileSegment(0, 0));
+        }
+
+        void* data = mmap(0, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping stays valid after the descriptor is closed, and after the file is deleted.
+        close(fd);
+        if (data == MAP_FAILED)
+            return 0;
+
+        return adoptRef(new MappedFileSegment(static_cast<const char*>(data), fileStat.st_size));
+    }
+
+    virtual ~MappedFileSegment()
+    {
+        if (m_data)
+            munmap(const_cast<char*>(m_data), m_size);
+    }
+
+    virtual const char* data() const { return m_data; }
+    virtual unsigned size() const { return m_size; }
+
+private:
+    MappedFileSegment(const char* data, unsigned size)
+        : m_data(data)
+        , m_size(size)
+    {
+    }
+
+    const char* m_data;
+    unsigned m_size;
+};
+#endif
+
+PassRefPtr<SharedBuffer> ApplicationCacheStorage::loadResourceData(unsigned dataStorageID, const String& path)
+{
+    if (!path.isEmpty()) {
+#if PLATFORM(ANDROID)
+        RefPtr<MappedFileSegment> segment = MappedFileSegment::create(path);
+        if (!segment)
+            return 0;
+        RefPtr<SharedBuffer> data = SharedBuffer::create();
+        if (segment->size())
+            data->append(segment.release());
+        return data.release();
+#else
+        return SharedBuffer::createWithContentsOfFile(path);
+#endif
+    }
+
+    openDatabase(false);
+    if (!m_database.isOpen())
+        return 0;
+
+    SQLiteStatement dataStatement(m_database, "SELECT data FROM CacheResourceData WHERE id=?");
+    if (dataStatement.prepare() != SQLResultOk) {
+        LOG_ERROR("Could not prepare resource data statement, error \"%s\"", m_database.lastErrorMsg());
+        return 0;
+    }
+    dataStatement.bindInt64(1, dataStorageID);
+
+    if (dataStatement.step() != SQLResultRow) {
+        LOG_ERROR("Could not load resource data, error \"%s\"", m_database.lastErrorMsg());
+        return 0;
+    }
+
+    Vector<char> blob;
+    dataStatement.getColumnBlobAsVector(0, blob);
+    return SharedBuffer::adoptVector(blob);
 }
     
 bool ApplicationCacheStorage::writeDataToUniqueFileInDirectory(SharedBuffer* data, const String& directory, String& path)
@@ -1274,6 +1387,8 @@ bool ApplicationCacheStorage::storeCopyOfCache(const String& cacheDirectory, App
     ApplicationCache::ResourceMap::const_iterator end = cache->end();
     for (ApplicationCache::ResourceMap::const_iterator it = cache->begin(); it != end; ++it) {
         ApplicationCacheResource* resource = it->second.get();
+        if (!resource->data())
+            return false;
         
         RefPtr<ApplicationCacheResource> resourceCopy = ApplicationCacheResource::create(resource->url(), resource->response(), resource->type(), resource->data(), resource->path());
         
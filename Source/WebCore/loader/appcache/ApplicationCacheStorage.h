@@ -83,6 +83,9 @@ public:
     bool store(ApplicationCacheResource*, ApplicationCache*);
     bool storeUpdatedType(ApplicationCacheResource*, ApplicationCache*);
 
+    // Reads the body of a resource created by loadCache(), the first time it is needed.
+    PassRefPtr<SharedBuffer> loadResourceData(unsigned dataStorageID, const String& path);
+
     // Removes the group if the cache to be removed is the newest one (so, storeNewestCache() needs to be called beforehand when updating).
     void remove(ApplicationCache*);
     
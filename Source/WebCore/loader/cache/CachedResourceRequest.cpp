@@ -277,6 +277,34 @@ void CachedResourceRequest::didReceiveData(SubresourceLoader* loader, const char
         m_resource->data(loader->resourceData(), false);
 }
 
+#if PLATFORM(ANDROID)
+void CachedResourceRequest::didReceiveDataSegments(SubresourceLoader* loader, const Vector<RefPtr<SharedBuffer::DataSegment> >& segments)
+{
+    ASSERT(loader == m_loader.get());
+
+    // The segments are already part of loader->resourceData(), which is all
+    // an incremental load needs, so hand it over once for the whole batch.
+    if (m_multipart) {
+        SubresourceLoaderClient::didReceiveDataSegments(loader, segments);
+        return;
+    }
+
+    ASSERT(!m_resource->isCacheValidator());
+
+    if (m_resource->errorOccurred())
+        return;
+
+    if (m_resource->response().httpStatusCode() >= 400) {
+        if (!m_resource->shouldIgnoreHTTPStatusCodeErrors())
+            m_resource->error(CachedResource::LoadError);
+        return;
+    }
+
+    if (m_incremental)
+        m_resource->data(loader->resourceData(), false);
+}
+#endif
+
 void CachedResourceRequest::didReceiveCachedMetadata(SubresourceLoader*, const char* data, int size)
 {
     ASSERT(!m_resource->isCacheValidator());
@@ -48,6 +48,9 @@ namespace WebCore {
         virtual void willSendRequest(SubresourceLoader*, ResourceRequest&, const ResourceResponse&);
         virtual void didReceiveResponse(SubresourceLoader*, const ResourceResponse&);
         virtual void didReceiveData(SubresourceLoader*, const char*, int);
+#if PLATFORM(ANDROID)
+        virtual void didReceiveDataSegments(SubresourceLoader*, const Vector<RefPtr<SharedBuffer::DataSegment> >&);
+#endif
         virtual void didReceiveCachedMetadata(SubresourceLoader*, const char*, int);
         virtual void didFinishLoading(SubresourceLoader*, double);
         virtual void didFail(SubresourceLoader*, const ResourceError&);
@@ -23,6 +23,15 @@
 #include "config.h"
 #include "MemoryCache.h"
 
+// Set to 1 to log a trace of the cache activity that Tools/android/memorycachesim can replay
+// to compare replacement policies and capacities.
+#define TRACE_MEMORY_CACHE 0
+
+#if TRACE_MEMORY_CACHE && PLATFORM(ANDROID)
+#define LOG_TAG "webcore"
+#include "AndroidLog.h"
+#endif
+
 #include "CachedCSSStyleSheet.h"
 #include "CachedFont.h"
 #include "CachedImage.h"
@@ -51,6 +60,20 @@ static const double cMinDelayBeforeLiveDecodedPrune = 1; // Seconds.
 static const float cTargetPrunePercentage = .95f; // Percentage of capacity toward which we prune, to avoid immediately pruning again.
 static const double cDefaultDecodedDataDeletionInterval = 0;
 
+#if TRACE_MEMORY_CACHE
+static void traceResource(const char* event, CachedResource* resource)
+{
+#if PLATFORM(ANDROID)
+    ALOGD("MemoryCacheTrace: %s %s %u %u", event, resource->url().utf8().data(), resource->encodedSize(), resource->decodedSize());
+#else
+    LOG(ResourceLoading, "MemoryCacheTrace: %s %s %u %u", event, resource->url().utf8().data(), resource->encodedSize(), resource->decodedSize());
+#endif
+}
+#define TRACE_RESOURCE(event, resource) traceResource(event, resource)
+#else
+#define TRACE_RESOURCE(event, resource) ((void)0)
+#endif
+
 MemoryCache* memoryCache()
 {
     static MemoryCache* staticCache = new MemoryCache;
@@ -70,6 +93,22 @@ MemoryCache::MemoryCache()
 {
 }
 
+void MemoryCache::setReplacementPolicy(PassOwnPtr<MemoryCacheReplacementPolicy> policy)
+{
+    m_replacementPolicy = policy;
+    if (!m_replacementPolicy)
+        return;
+
+    // Tell the new policy about the resources already in the cache.
+    int size = m_allResources.size();
+    for (int i = 0; i < size; i++) {
+        for (CachedResource* current = m_allResources[i].m_tail; current; current = current->m_prevInAllResourcesList) {
+            m_replacementPolicy->resourceUpdated(current, current->size(),
+                MemoryCacheReplacementPolicy::retrievalCost(current->encodedSize(), current->decodedSize()), current->accessCount());
+        }
+    }
+}
+
 KURL MemoryCache::removeFragmentIdentifierIfNeeded(const KURL& originalURL)
 {
     if (!originalURL.hasFragmentIdentifier())
@@ -233,6 +272,11 @@ void MemoryCache::pruneDeadResources()
         }
         if (targetSize && m_deadSize <= targetSize)
             return;
+
+        if (m_replacementPolicy) {
+            pruneDeadResourcesInPolicyOrder(targetSize);
+            return;
+        }
     }
     
     bool canShrinkLRULists = true;
@@ -263,6 +307,7 @@ void MemoryCache::pruneDeadResources()
         while (current) {
             CachedResource* prev = current->m_prevInAllResourcesList;
             if (!current->hasClients() && !current->isPreloaded() && !current->isCacheValidator()) {
+                TRACE_RESOURCE("evict", current);
                 if (!makeResourcePurgeable(current))
                     evict(current);
 
@@ -289,6 +334,63 @@ void MemoryCache::pruneDeadResources()
     m_inPruneDeadResources = false;
 }
 
+void MemoryCache::pruneDeadResourcesInPolicyOrder(unsigned targetSize)
+{
+    ASSERT(m_replacementPolicy);
+
+    Vector<MemoryCacheReplacementPolicy::ResourceID> candidates;
+    int size = m_allResources.size();
+    for (int i = 0; i < size; i++) {
+        for (CachedResource* current = m_allResources[i].m_head; current; current = current->m_nextInAllResourcesList) {
+            if (!current->hasClients() && !current->isPreloaded())
+                candidates.append(current);
+        }
+    }
+    m_replacementPolicy->sortForEviction(candidates);
+
+    m_inPruneDeadResources = true;
+
+    // First flush decoded data, which is cheaper to get back than the encoded data.
+    size_t candidateCount = candidates.size();
+    for (size_t i = 0; i < candidateCount; ++i) {
+        // Destroying the decoded data of an SVG image can remove its subresources from the cache.
+        if (!m_replacementPolicy->contains(candidates[i]))
+            continue;
+        CachedResource* current = static_cast<CachedResource*>(const_cast<void*>(candidates[i]));
+        if (!current->isLoaded())
+            continue;
+        // This may move the resource to a different LRU list, but it stays in the cache.
+        current->destroyDecodedData();
+        if (targetSize && m_deadSize <= targetSize) {
+            m_inPruneDeadResources = false;
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < candidateCount; ++i) {
+        // Evicting an SVG image can evict its subresources too, which are then no longer known
+        // to the policy.
+        if (!m_replacementPolicy->contains(candidates[i]))
+            continue;
+        CachedResource* current = static_cast<CachedResource*>(const_cast<void*>(candidates[i]));
+        if (current->isCacheValidator())
+            continue;
+
+        TRACE_RESOURCE("evict", current);
+        m_replacementPolicy->resourceEvicted(current);
+        if (!makeResourcePurgeable(current))
+            evict(current);
+
+        // If evict() caused pruneDeadResources() to be re-entered, bail out.
+        if (!m_inPruneDeadResources)
+            return;
+
+        if (targetSize && m_deadSize <= targetSize)
+            break;
+    }
+    m_inPruneDeadResources = false;
+}
+
 void MemoryCache::setCapacities(unsigned minDeadBytes, unsigned maxDeadBytes, unsigned totalBytes)
 {
     ASSERT(minDeadBytes <= maxDeadBytes);
@@ -326,6 +428,9 @@ void MemoryCache::evict(CachedResource* resource)
     LOG(ResourceLoading, "Evicting resource %p for '%s' from cache", resource, resource->url().latin1().data());
     // The resource may have already been removed by someone other than our caller,
     // who needed a fresh copy for a reload. See <http://bugs.webkit.org/show_bug.cgi?id=12479#c6>.
+    if (m_replacementPolicy)
+        m_replacementPolicy->resourceRemoved(resource);
+
     if (resource->inCache()) {
         // Remove from the resource map.
         m_resources.remove(resource->url());
@@ -440,6 +545,12 @@ void MemoryCache::insertInLRUList(CachedResource* resource)
     
     if (!resource->m_nextInAllResourcesList)
         list->m_tail = resource;
+
+    TRACE_RESOURCE("size", resource);
+    if (m_replacementPolicy) {
+        m_replacementPolicy->resourceUpdated(resource, resource->size(),
+            MemoryCacheReplacementPolicy::retrievalCost(resource->encodedSize(), resource->decodedSize()), resource->accessCount());
+    }
         
 #ifndef NDEBUG
     // Verify that we are in now in the list like we should be.
@@ -465,8 +576,11 @@ void MemoryCache::resourceAccessed(CachedResource* resource)
     removeFromLRUList(resource);
     
     // If this is the first time the resource has been accessed, adjust the size of the cache to account for its initial size.
-    if (!resource->accessCount())
+    if (!resource->accessCount()) {
+        TRACE_RESOURCE("add", resource);
         adjustSize(resource->hasClients(), resource->size());
+    } else
+        TRACE_RESOURCE("access", resource);
     
     // Add to our access count.
     resource->increaseAccessCount();
@@ -475,6 +589,12 @@ void MemoryCache::resourceAccessed(CachedResource* resource)
     insertInLRUList(resource);
 }
 
+void MemoryCache::remove(CachedResource* resource)
+{
+    TRACE_RESOURCE("remove", resource);
+    evict(resource);
+}
+
 void MemoryCache::removeResourcesWithOrigin(SecurityOrigin* origin)
 {
     Vector<CachedResource*> resourcesWithOrigin;
@@ -27,10 +27,12 @@
 
 #include "CachePolicy.h"
 #include "CachedResource.h"
+#include "MemoryCacheReplacementPolicy.h"
 #include "PlatformString.h"
 #include <wtf/HashMap.h>
 #include <wtf/HashSet.h>
 #include <wtf/Noncopyable.h>
+#include <wtf/OwnPtr.h>
 #include <wtf/Vector.h>
 #include <wtf/text/StringHash.h>
 
@@ -109,7 +111,7 @@ public:
     CachedResource* resourceForURL(const KURL&);
     
     bool add(CachedResource* resource);
-    void remove(CachedResource* resource) { evict(resource); }
+    void remove(CachedResource*);
 
     static KURL removeFragmentIdentifierIfNeeded(const KURL& originalURL);
     
@@ -123,6 +125,10 @@ public:
     //  - totalBytes: The maximum number of bytes that the cache should consume overall.
     void setCapacities(unsigned minDeadBytes, unsigned maxDeadBytes, unsigned totalBytes);
 
+    // Chooses the order in which dead resources are evicted. Passing null goes back to the
+    // size-adjusted LRU lists.
+    void setReplacementPolicy(PassOwnPtr<MemoryCacheReplacementPolicy>);
+
     // Turn the cache on and off.  Disabling the cache will remove all resources from the cache.  They may
     // still live on if they are referenced by some Web page though.
     void setDisabled(bool);
@@ -186,6 +192,7 @@ private:
     
     void pruneDeadResources(); // Flush decoded and encoded data from resources not referenced by Web pages.
     void pruneLiveResources(); // Flush decoded data from resources still referenced by Web pages.
+    void pruneDeadResourcesInPolicyOrder(unsigned targetSize);
 
     bool makeResourcePurgeable(CachedResource*);
     void evict(CachedResource*);
@@ -213,6 +220,10 @@ private:
     // A URL-based map of all resources that are in the cache (including the freshest version of objects that are currently being 
     // referenced by a Web page).
     HashMap<String, CachedResource*> m_resources;
+
+    // Chooses the order in which dead resources are evicted. When null, the size-adjusted
+    // LRU lists are used.
+    OwnPtr<MemoryCacheReplacementPolicy> m_replacementPolicy;
 };
 
 inline bool MemoryCache::shouldMakeResourcePurgeableOnEviction()
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "MemoryCacheReplacementPolicy.h"
+
+#include <algorithm>
+#include <wtf/HashMap.h>
+
+namespace WebCore {
+
+// A request costs about as much as transferring this many bytes on a mobile
+// network, whatever the size of the response.
+static const double cRequestCost = 16 * 1024;
+// Decoding a byte of image data is much cheaper than downloading one.
+static const double cDecodeCostPerByte = 0.25;
+
+double MemoryCacheReplacementPolicy::retrievalCost(unsigned encodedSize, unsigned decodedSize)
+{
+    return cRequestCost + encodedSize + cDecodeCostPerByte * decodedSize;
+}
+
+namespace {
+
+template<typename Value>
+class PriorityLess {
+public:
+    PriorityLess(const HashMap<MemoryCacheReplacementPolicy::ResourceID, Value>& priorities)
+        : m_priorities(priorities)
+    {
+    }
+
+    bool operator()(MemoryCacheReplacementPolicy::ResourceID a, MemoryCacheReplacementPolicy::ResourceID b) const
+    {
+        return m_priorities.get(a) < m_priorities.get(b);
+    }
+
+private:
+    const HashMap<MemoryCacheReplacementPolicy::ResourceID, Value>& m_priorities;
+};
+
+class LRUPolicy : public MemoryCacheReplacementPolicy {
+public:
+    LRUPolicy()
+        : m_clock(0)
+    {
+    }
+
+    virtual const char* name() const { return "lru"; }
+
+    virtual void resourceUpdated(ResourceID resource, unsigned, double, unsigned)
+    {
+        m_lastAccess.set(resource, ++m_clock);
+    }
+
+    virtual void resourceEvicted(ResourceID resource) { m_lastAccess.remove(resource); }
+    virtual void resourceRemoved(ResourceID resource) { m_lastAccess.remove(resource); }
+    virtual bool contains(ResourceID resource) const { return m_lastAccess.contains(resource); }
+
+    virtual void sortForEviction(Vector<ResourceID>& resources) const
+    {
+        std::stable_sort(resources.begin(), resources.end(), PriorityLess<unsigned long long>(m_lastAccess));
+    }
+
+private:
+    unsigned long long m_clock;
+    HashMap<ResourceID, unsigned long long> m_lastAccess;
+};
+
+class GreedyDualSizeFrequencyPolicy : public MemoryCacheReplacementPolicy {
+public:
+    GreedyDualSizeFrequencyPolicy()
+        : m_inflation(0)
+    {
+    }
+
+    virtual const char* name() const { return "gdsf"; }
+
+    virtual void resourceUpdated(ResourceID resource, unsigned size, double cost, unsigned accessCount)
+    {
+        // Only an access ages the resource to the current inflation. A size
+        // change keeps the inflation it was last accessed at, and only
+        // recomputes the cost term.
+        HashMap<ResourceID, Entry>::iterator it = m_entries.find(resource);
+        if (it == m_entries.end() || it->second.accessCount != accessCount) {
+            Entry entry;
+            entry.inflation = m_inflation;
+            entry.accessCount = accessCount;
+            it = m_entries.set(resource, entry).first;
+        }
+        double frequency = std::max(accessCount, 1U);
+        m_priorities.set(resource, it->second.inflation + frequency * cost / std::max(size, 1U));
+    }
+
+    virtual void resourceEvicted(ResourceID resource)
+    {
+        HashMap<ResourceID, double>::iterator it = m_priorities.find(resource);
+        if (it == m_priorities.end())
+            return;
+        // Everything still in the cache is now worth at least as much as
+        // what was just evicted.
+        m_inflation = std::max(m_inflation, it->second);
+        m_priorities.remove(it);
+        m_entries.remove(resource);
+    }
+
+    virtual void resourceRemoved(ResourceID resource)
+    {
+        m_priorities.remove(resource);
+        m_entries.remove(resource);
+    }
+
+    virtual bool contains(ResourceID resource) const { return m_priorities.contains(resource); }
+
+    virtual void sortForEviction(Vector<ResourceID>& resources) const
+    {
+        std::stable_sort(resources.begin(), resources.end(), PriorityLess<double>(m_priorities));
+    }
+
+private:
+    // The inflation and access count at the last access
+    struct Entry {
+        double inflation;
+        unsigned accessCount;
+    };
+
+    double m_inflation;
+    HashMap<ResourceID, double> m_priorities;
+    HashMap<ResourceID, Entry> m_entries;
+};
+
+} // namespace
+
+PassOwnPtr<MemoryCacheReplacementPolicy> MemoryCacheReplacementPolicy::createLRU()
+{
+    return adoptPtr(new LRUPolicy);
+}
+
+PassOwnPtr<MemoryCacheReplacementPolicy> MemoryCacheReplacementPolicy::createGreedyDualSizeFrequency()
+{
+    return adoptPtr(new GreedyDualSizeFrequencyPolicy);
+}
+
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MemoryCacheReplacementPolicy_h
+#define MemoryCacheReplacementPolicy_h
+
+#include <wtf/FastAllocBase.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// Decides in which order MemoryCache evicts the resources no Web page is
+// using when it is over capacity. Without a policy MemoryCache uses its
+// size-adjusted LRU lists.
+//
+// Resources are only known by an opaque identifier and a few numbers, so the
+// same policies can be run against recorded cache traces by
+// Tools/android/memorycachesim to compare them and tune the cache capacities.
+class MemoryCacheReplacementPolicy {
+    WTF_MAKE_NONCOPYABLE(MemoryCacheReplacementPolicy); WTF_MAKE_FAST_ALLOCATED;
+public:
+    typedef const void* ResourceID;
+
+    // Evicts the least recently used resources first.
+    static PassOwnPtr<MemoryCacheReplacementPolicy> createLRU();
+    // Greedy-Dual-Size-Frequency: evicts first the resources with the lowest
+    // (frequency * cost / size), aged by the priority of the last eviction so
+    // that resources that were popular a long time ago eventually go.
+    static PassOwnPtr<MemoryCacheReplacementPolicy> createGreedyDualSizeFrequency();
+
+    // Rough cost, in bytes of network transfer, of getting a resource back
+    // after evicting it: a request, the encoded data, and decoding it again.
+    static double retrievalCost(unsigned encodedSize, unsigned decodedSize);
+
+    MemoryCacheReplacementPolicy() { }
+    virtual ~MemoryCacheReplacementPolicy() { }
+
+    virtual const char* name() const = 0;
+
+    // Called when a resource is added to the cache or accessed, and when
+    // its size changes.
+    virtual void resourceUpdated(ResourceID, unsigned size, double cost, unsigned accessCount) = 0;
+    // Called when a resource is evicted to make room in the cache.
+    virtual void resourceEvicted(ResourceID) = 0;
+    // Called when a resource leaves the cache for any reason.
+    virtual void resourceRemoved(ResourceID) = 0;
+
+    virtual bool contains(ResourceID) const = 0;
+
+    // Sorts the resources so that the ones to evict first come first.
+    virtual void sortForEviction(Vector<ResourceID>&) const = 0;
+};
+
+}
+
+#endif
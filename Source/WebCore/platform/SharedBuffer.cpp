@@ -57,19 +57,49 @@ static inline void freeSegment(char* p)
     fastFree(p);
 }
 
+#if PLATFORM(ANDROID)
+class CopiedDataSegment : public SharedBuffer::DataSegment {
+public:
+    static PassRefPtr<CopiedDataSegment> create(const char* data, unsigned length)
+    {
+        return adoptRef(new CopiedDataSegment(data, length));
+    }
+
+    virtual const char* data() const { return m_data.data(); }
+    virtual unsigned size() const { return m_data.size(); }
+
+private:
+    CopiedDataSegment(const char* data, unsigned length)
+    {
+        m_data.append(data, length);
+    }
+
+    Vector<char> m_data;
+};
+#endif
+
 SharedBuffer::SharedBuffer()
     : m_size(0)
+#if PLATFORM(ANDROID)
+    , m_dataSegmentsSize(0)
+#endif
 {
 }
 
 SharedBuffer::SharedBuffer(const char* data, int size)
     : m_size(0)
+#if PLATFORM(ANDROID)
+    , m_dataSegmentsSize(0)
+#endif
 {
     append(data, size);
 }
 
 SharedBuffer::SharedBuffer(const unsigned char* data, int size)
     : m_size(0)
+#if PLATFORM(ANDROID)
+    , m_dataSegmentsSize(0)
+#endif
 {
     append(reinterpret_cast<const char*>(data), size);
 }
@@ -113,6 +143,12 @@ const char* SharedBuffer::data() const
     
     if (m_purgeableBuffer)
         return m_purgeableBuffer->data();
+
+#if PLATFORM(ANDROID)
+    // A buffer that is just one adopted segment, such as a mapped file, doesn't need flattening.
+    if (m_dataSegments.size() == 1 && m_dataSegmentsSize == m_size)
+        return m_dataSegments[0]->data();
+#endif
     
     return buffer().data();
 }
@@ -122,6 +158,16 @@ void SharedBuffer::append(const char* data, unsigned length)
     ASSERT(!m_purgeableBuffer);
 
     maybeTransferPlatformData();
+
+#if PLATFORM(ANDROID)
+    // Keep the bytes in order without flattening the adopted segments: once
+    // there are any, further bytes become a segment of their own.
+    if (!m_dataSegments.isEmpty()) {
+        if (length)
+            append(CopiedDataSegment::create(data, length));
+        return;
+    }
+#endif
     
     unsigned positionInSegment = offsetInSegment(m_size - m_buffer.size());
     m_size += length;
@@ -155,6 +201,38 @@ void SharedBuffer::append(const char* data, unsigned length)
     }
 }
 
+#if PLATFORM(ANDROID)
+void SharedBuffer::append(PassRefPtr<DataSegment> prpSegment)
+{
+    ASSERT(!m_purgeableBuffer);
+    RefPtr<DataSegment> segment = prpSegment;
+    ASSERT(segment);
+
+    maybeTransferPlatformData();
+
+    unsigned length = segment->size();
+    if (!length)
+        return;
+    m_size += length;
+    m_dataSegmentsSize += length;
+    m_dataSegments.append(segment.release());
+}
+
+void SharedBuffer::copyDataSegmentsAndClear(char* destination, unsigned bytesToCopy) const
+{
+    ASSERT(bytesToCopy == m_dataSegmentsSize);
+    for (unsigned i = 0; i < m_dataSegments.size(); ++i) {
+        unsigned length = m_dataSegments[i]->size();
+        ASSERT(bytesToCopy >= length);
+        memcpy(destination, m_dataSegments[i]->data(), length);
+        destination += length;
+        bytesToCopy -= length;
+    }
+    m_dataSegments.clear();
+    m_dataSegmentsSize = 0;
+}
+#endif
+
 void SharedBuffer::clear()
 {
     clearPlatformData();
@@ -170,6 +248,10 @@ void SharedBuffer::clear()
 #if HAVE(CFNETWORK_DATA_ARRAY_CALLBACK)
     m_dataArray.clear();
 #endif
+#if PLATFORM(ANDROID)
+    m_dataSegments.clear();
+    m_dataSegmentsSize = 0;
+#endif
 }
 
 PassRefPtr<SharedBuffer> SharedBuffer::copy() const
@@ -180,6 +262,23 @@ PassRefPtr<SharedBuffer> SharedBuffer::copy() const
         return clone;
     }
 
+#if PLATFORM(ANDROID)
+    if (!m_dataSegments.isEmpty()) {
+        // Adopted segments are immutable, so the clone can share them.
+        unsigned ownedSize = m_size - m_dataSegmentsSize;
+        unsigned position = 0;
+        while (position < ownedSize) {
+            const char* segment;
+            unsigned length = min(getSomeData(segment, position), ownedSize - position);
+            clone->append(segment, length);
+            position += length;
+        }
+        for (unsigned i = 0; i < m_dataSegments.size(); ++i)
+            clone->append(m_dataSegments[i]);
+        return clone;
+    }
+#endif
+
     clone->m_size = m_size;
     clone->m_buffer.reserveCapacity(m_size);
     clone->m_buffer.append(m_buffer.data(), m_buffer.size());
@@ -201,6 +300,10 @@ const Vector<char>& SharedBuffer::buffer() const
         m_buffer.resize(m_size);
         char* destination = m_buffer.data() + bufferSize;
         unsigned bytesLeft = m_size - bufferSize;
+#if PLATFORM(ANDROID)
+        unsigned dataSegmentsSize = m_dataSegmentsSize;
+        bytesLeft -= dataSegmentsSize;
+#endif
         for (unsigned i = 0; i < m_segments.size(); ++i) {
             unsigned bytesToCopy = min(bytesLeft, segmentSize);
             memcpy(destination, m_segments[i], bytesToCopy);
@@ -211,6 +314,9 @@ const Vector<char>& SharedBuffer::buffer() const
         m_segments.clear();
 #if HAVE(CFNETWORK_DATA_ARRAY_CALLBACK)
         copyDataArrayAndClear(destination, bytesLeft);
+#endif
+#if PLATFORM(ANDROID)
+        copyDataSegmentsAndClear(destination, dataSegmentsSize);
 #endif
     }
     return m_buffer;
@@ -236,6 +342,23 @@ unsigned SharedBuffer::getSomeData(const char*& someData, unsigned position) con
  
     position -= consecutiveSize;
     unsigned segmentedSize = m_size - consecutiveSize;
+#if PLATFORM(ANDROID)
+    segmentedSize -= m_dataSegmentsSize;
+    if (position >= segmentedSize) {
+        position -= segmentedSize;
+        for (unsigned i = 0; i < m_dataSegments.size(); ++i) {
+            unsigned length = m_dataSegments[i]->size();
+            if (position < length) {
+                someData = m_dataSegments[i]->data() + position;
+                return length - position;
+            }
+            position -= length;
+        }
+        ASSERT_NOT_REACHED();
+        someData = 0;
+        return 0;
+    }
+#endif
     unsigned segments = m_segments.size();
     unsigned segment = segmentIndex(position);
     ASSERT(segment < segments);
@@ -32,6 +32,11 @@
 #include <wtf/RefCounted.h>
 #include <wtf/Vector.h>
 
+#if PLATFORM(ANDROID)
+#include <wtf/RefPtr.h>
+#include <wtf/Threading.h>
+#endif
+
 #if USE(CF)
 #include <wtf/RetainPtr.h>
 #endif
@@ -101,6 +106,19 @@ public:
     void append(CFDataRef);
 #endif
 
+#if PLATFORM(ANDROID)
+    // An immutable block of bytes owned by someone else, typically a network
+    // read buffer, that a SharedBuffer can hold on to instead of copying.
+    class DataSegment : public ThreadSafeRefCounted<DataSegment> {
+    public:
+        virtual ~DataSegment() { }
+        virtual const char* data() const = 0;
+        virtual unsigned size() const = 0;
+    };
+
+    void append(PassRefPtr<DataSegment>);
+#endif
+
     PassRefPtr<SharedBuffer> copy() const;
     
     bool hasPurgeableBuffer() const { return m_purgeableBuffer.get(); }
@@ -146,6 +164,12 @@ private:
     mutable Vector<RetainPtr<CFDataRef> > m_dataArray;
     void copyDataArrayAndClear(char *destination, unsigned bytesToCopy) const;
 #endif
+#if PLATFORM(ANDROID)
+    // Adopted segments always follow m_buffer and m_segments.
+    mutable Vector<RefPtr<DataSegment> > m_dataSegments;
+    mutable unsigned m_dataSegmentsSize;
+    void copyDataSegmentsAndClear(char* destination, unsigned bytesToCopy) const;
+#endif
 #if USE(CF)
     SharedBuffer(CFDataRef);
     RetainPtr<CFDataRef> m_cfData;
@@ -234,8 +234,6 @@ void AudioBus::processWithGainFromMonoStereo(const AudioBus &sourceBus, double*
     // We don't want to suddenly change the gain from mixing one time slice to the next,
     // so we "de-zipper" by slowly changing the gain each sample-frame until we've achieved the target gain.
 
-    // FIXME: optimize this method (SSE, etc.)
-    // FIXME: Need fast path here when gain has converged on targetGain. In this case, de-zippering is no longer needed.
     // FIXME: Need fast path when this==sourceBus && lastMixGain==targetGain==1.0 && sumToBus==false (this is a NOP)
 
     // Take master bus gain into account as well as the targetGain.
@@ -258,11 +256,23 @@ void AudioBus::processWithGainFromMonoStereo(const AudioBus &sourceBus, double*
     const double DezipperRate = 0.005;
     int framesToProcess = length();
 
+    // De-zippering is only needed until the gain gets close enough to the target gain,
+    // the remaining frames are processed with the target gain using VectorMath.
+    const double GainEpsilon = 0.001;
+    int framesToDezipper = 0;
+    double gainDifference = fabs(totalDesiredGain - gain);
+    if (gainDifference >= GainEpsilon) {
+        // The difference shrinks by a factor of (1 - DezipperRate) every frame.
+        double frames = ceil(log(GainEpsilon / gainDifference) / log(1 - DezipperRate));
+        framesToDezipper = std::min(framesToProcess, static_cast<int>(frames));
+    }
+    int framesAtTargetGain = framesToProcess - framesToDezipper;
+
     if (sumToBus) {
         // Sum to our bus
         if (sourceR && destinationR) {
             // Stereo
-            while (framesToProcess--) {
+            while (framesToDezipper--) {
                 float sampleL = *sourceL++;
                 float sampleR = *sourceR++;
                 *destinationL++ += static_cast<float>(gain * sampleL);
@@ -274,7 +284,7 @@ void AudioBus::processWithGainFromMonoStereo(const AudioBus &sourceBus, double*
         } else if (destinationR) {
             // Mono -> stereo (mix equally into L and R)
             // FIXME: Really we should apply an equal-power scaling factor here, since we're effectively panning center...
-            while (framesToProcess--) {
+            while (framesToDezipper--) {
                 float sample = *sourceL++;
                 *destinationL++ += static_cast<float>(gain * sample);
                 *destinationR++ += static_cast<float>(gain * sample);
@@ -284,7 +294,7 @@ void AudioBus::processWithGainFromMonoStereo(const AudioBus &sourceBus, double*
             }
         } else {
             // Mono
-            while (framesToProcess--) {
+            while (framesToDezipper--) {
                 float sampleL = *sourceL++;
                 *destinationL++ += static_cast<float>(gain * sampleL);
 
@@ -296,7 +306,7 @@ void AudioBus::processWithGainFromMonoStereo(const AudioBus &sourceBus, double*
         // Process directly (without summing) to our bus
         if (sourceR && destinationR) {
             // Stereo
-            while (framesToProcess--) {
+            while (framesToDezipper--) {
                 float sampleL = *sourceL++;
                 float sampleR = *sourceR++;
                 *destinationL++ = static_cast<float>(gain * sampleL);
@@ -308,7 +318,7 @@ void AudioBus::processWithGainFromMonoStereo(const AudioBus &sourceBus, double*
         } else if (destinationR) {
             // Mono -> stereo (mix equally into L and R)
             // FIXME: Really we should apply an equal-power scaling factor here, since we're effectively panning center...
-            while (framesToProcess--) {
+            while (framesToDezipper--) {
                 float sample = *sourceL++;
                 *destinationL++ = static_cast<float>(gain * sample);
                 *destinationR++ = static_cast<float>(gain * sample);
@@ -318,7 +328,7 @@ void AudioBus::processWithGainFromMonoStereo(const AudioBus &sourceBus, double*
             }
         } else {
             // Mono
-            while (framesToProcess--) {
+            while (framesToDezipper--) {
                 float sampleL = *sourceL++;
                 *destinationL++ = static_cast<float>(gain * sampleL);
 
@@ -328,6 +338,22 @@ void AudioBus::processWithGainFromMonoStereo(const AudioBus &sourceBus, double*
         }
     }
 
+    if (framesAtTargetGain) {
+        gain = totalDesiredGain;
+        float targetGainFloat = static_cast<float>(totalDesiredGain);
+        // Mono -> stereo mixes the mono channel equally into L and R.
+        const float* sourceForR = sourceR ? sourceR : sourceL;
+        if (sumToBus) {
+            vsma(sourceL, 1, &targetGainFloat, destinationL, 1, framesAtTargetGain);
+            if (destinationR)
+                vsma(sourceForR, 1, &targetGainFloat, destinationR, 1, framesAtTargetGain);
+        } else {
+            vsmul(sourceL, 1, &targetGainFloat, destinationL, 1, framesAtTargetGain);
+            if (destinationR)
+                vsmul(sourceForR, 1, &targetGainFloat, destinationR, 1, framesAtTargetGain);
+        }
+    }
+
     // Save the target gain as the starting point for next time around.
     *lastMixGain = gain;
 }
@@ -33,8 +33,6 @@
 #include "AudioChannel.h"
 
 #include "VectorMath.h"
-#include <algorithm>
-#include <math.h>
 #include <wtf/OwnPtr.h>
 
 namespace WebCore {
@@ -89,13 +87,8 @@ void AudioChannel::sumFrom(const AudioChannel* sourceChannel)
 
 float AudioChannel::maxAbsValue() const
 {
-    const float* p = data();
-    int n = length();
-
     float max = 0.0f;
-    while (n--)
-        max = std::max(max, fabsf(*p++));
-
+    vmaxmgv(data(), 1, &max, length());
     return max;
 }
 
@@ -30,6 +30,8 @@
 
 #include "AudioBus.h"
 #include "AudioUtilities.h"
+#include "VectorMath.h"
+#include <algorithm>
 #include <wtf/MathExtras.h>
 
 // Use a 50ms smoothing / de-zippering time-constant.
@@ -95,7 +97,19 @@ void EqualPowerPanner::pan(double azimuth, double /*elevation*/, AudioBus* input
 
     int n = framesToProcess;
 
-    while (n--) {
+    // Smoothing is only needed until the gains get close enough to the desired gains,
+    // the remaining frames are processed with the desired gains using VectorMath.
+    const double GainEpsilon = 0.001;
+    double gainDifference = std::max(fabs(desiredGainL - gainL), fabs(desiredGainR - gainR));
+    int framesToSmooth = 0;
+    if (gainDifference >= GainEpsilon) {
+        // The differences shrink by a factor of (1 - SmoothingConstant) every frame.
+        double frames = ceil(log(GainEpsilon / gainDifference) / log(1 - SmoothingConstant));
+        framesToSmooth = std::min(n, static_cast<int>(frames));
+    }
+    n -= framesToSmooth;
+
+    while (framesToSmooth--) {
         float input = *sourceP++;
         gainL += (desiredGainL - gainL) * SmoothingConstant;
         gainR += (desiredGainR - gainR) * SmoothingConstant;
@@ -103,6 +117,15 @@ void EqualPowerPanner::pan(double azimuth, double /*elevation*/, AudioBus* input
         *destinationR++ = static_cast<float>(input * gainR);
     }
 
+    if (n) {
+        gainL = desiredGainL;
+        gainR = desiredGainR;
+        float gainLFloat = static_cast<float>(gainL);
+        float gainRFloat = static_cast<float>(gainR);
+        VectorMath::vsmul(sourceP, 1, &gainLFloat, destinationL, 1, n);
+        VectorMath::vsmul(sourceP, 1, &gainRFloat, destinationR, 1, n);
+    }
+
     m_gainL = gainL;
     m_gainR = gainR;
 }
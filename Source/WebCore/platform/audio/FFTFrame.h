@@ -146,6 +146,19 @@ private:
     static fftwf_plan fftwPlanForSize(unsigned fftSize, Direction,
                                       float*, float*, float*);
 #endif // USE(WEBAUDIO_FFTW)
+#if USE(WEBAUDIO_BUILTIN_FFT)
+    // Bit reversal and twiddle factor tables, shared by all the frames of a given size.
+    struct FFTTables;
+
+    static const FFTTables* tablesForSize(unsigned fftSize);
+
+    static Mutex* s_tablesLock;
+    static FFTTables** s_tables;
+
+    const FFTTables* m_tables;
+    AudioFloatArray m_realData;
+    AudioFloatArray m_imagData;
+#endif // USE(WEBAUDIO_BUILTIN_FFT)
 #endif // !OS(DARWIN)
 };
 
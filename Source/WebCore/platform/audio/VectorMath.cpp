@@ -32,6 +32,17 @@
 #include <Accelerate/Accelerate.h>
 #endif
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#if CPU(ARM_NEON) && COMPILER(GCC)
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
+#include <math.h>
+
 namespace WebCore {
 
 namespace VectorMath {
@@ -59,13 +70,69 @@ void vadd(const float* source1P, int sourceStride1, const float* source2P, int s
 #endif
 }
 
+void vmul(const float* source1P, int sourceStride1, const float* source2P, int sourceStride2, float* destP, int destStride, size_t framesToProcess)
+{
+#if defined(__ppc__) || defined(__i386__)
+    ::vmul(source1P, sourceStride1, source2P, sourceStride2, destP, destStride, framesToProcess);
+#else
+    vDSP_vmul(source1P, sourceStride1, source2P, sourceStride2, destP, destStride, framesToProcess);
+#endif
+}
+
+void vsma(const float* sourceP, int sourceStride, const float* scale, float* destP, int destStride, size_t framesToProcess)
+{
+    vDSP_vsma(sourceP, sourceStride, scale, destP, destStride, destP, destStride, framesToProcess);
+}
+
+void vmaxmgv(const float* sourceP, int sourceStride, float* maxP, size_t framesToProcess)
+{
+    vDSP_maxmgv(sourceP, sourceStride, maxP, framesToProcess);
+}
+
 #else
 
+// The vectorized paths only handle contiguous data. They process frames one
+// at a time until sourceP is 16-byte aligned, then four at a time, then the
+// remaining frames one at a time, so that their results are the same as the
+// scalar loops.
+
+static inline bool isAligned16(const float* p)
+{
+    return !(reinterpret_cast<size_t>(p) & 0x0F);
+}
+
 void vsmul(const float* sourceP, int sourceStride, const float* scale, float* destP, int destStride, size_t framesToProcess)
 {
-    // FIXME: optimize for SSE
     int n = framesToProcess;
     float k = *scale;
+
+#ifdef __SSE2__
+    if (sourceStride == 1 && destStride == 1) {
+        while (!isAligned16(sourceP) && n) {
+            *destP++ = k * *sourceP++;
+            n--;
+        }
+
+        __m128 mScale = _mm_set_ps1(k);
+        int groups = n / 4;
+        if (isAligned16(destP)) {
+            for (int i = 0; i < groups; ++i, sourceP += 4, destP += 4)
+                _mm_store_ps(destP, _mm_mul_ps(_mm_load_ps(sourceP), mScale));
+        } else {
+            for (int i = 0; i < groups; ++i, sourceP += 4, destP += 4)
+                _mm_storeu_ps(destP, _mm_mul_ps(_mm_load_ps(sourceP), mScale));
+        }
+        n %= 4;
+    }
+#elif CPU(ARM_NEON) && COMPILER(GCC)
+    if (sourceStride == 1 && destStride == 1) {
+        int groups = n / 4;
+        for (int i = 0; i < groups; ++i, sourceP += 4, destP += 4)
+            vst1q_f32(destP, vmulq_n_f32(vld1q_f32(sourceP), k));
+        n %= 4;
+    }
+#endif
+
     while (n--) {
         *destP = k * *sourceP;
         sourceP += sourceStride;
@@ -75,8 +142,34 @@ void vsmul(const float* sourceP, int sourceStride, const float* scale, float* de
 
 void vadd(const float* source1P, int sourceStride1, const float* source2P, int sourceStride2, float* destP, int destStride, size_t framesToProcess)
 {
-    // FIXME: optimize for SSE
     int n = framesToProcess;
+
+#ifdef __SSE2__
+    if (sourceStride1 == 1 && sourceStride2 == 1 && destStride == 1) {
+        while (!isAligned16(source1P) && n) {
+            *destP++ = *source1P++ + *source2P++;
+            n--;
+        }
+
+        int groups = n / 4;
+        if (isAligned16(source2P) && isAligned16(destP)) {
+            for (int i = 0; i < groups; ++i, source1P += 4, source2P += 4, destP += 4)
+                _mm_store_ps(destP, _mm_add_ps(_mm_load_ps(source1P), _mm_load_ps(source2P)));
+        } else {
+            for (int i = 0; i < groups; ++i, source1P += 4, source2P += 4, destP += 4)
+                _mm_storeu_ps(destP, _mm_add_ps(_mm_load_ps(source1P), _mm_loadu_ps(source2P)));
+        }
+        n %= 4;
+    }
+#elif CPU(ARM_NEON) && COMPILER(GCC)
+    if (sourceStride1 == 1 && sourceStride2 == 1 && destStride == 1) {
+        int groups = n / 4;
+        for (int i = 0; i < groups; ++i, source1P += 4, source2P += 4, destP += 4)
+            vst1q_f32(destP, vaddq_f32(vld1q_f32(source1P), vld1q_f32(source2P)));
+        n %= 4;
+    }
+#endif
+
     while (n--) {
         *destP = *source1P + *source2P;
         source1P += sourceStride1;
@@ -85,6 +178,131 @@ void vadd(const float* source1P, int sourceStride1, const float* source2P, int s
     }
 }
 
+void vmul(const float* source1P, int sourceStride1, const float* source2P, int sourceStride2, float* destP, int destStride, size_t framesToProcess)
+{
+    int n = framesToProcess;
+
+#ifdef __SSE2__
+    if (sourceStride1 == 1 && sourceStride2 == 1 && destStride == 1) {
+        while (!isAligned16(source1P) && n) {
+            *destP++ = *source1P++ * *source2P++;
+            n--;
+        }
+
+        int groups = n / 4;
+        if (isAligned16(source2P) && isAligned16(destP)) {
+            for (int i = 0; i < groups; ++i, source1P += 4, source2P += 4, destP += 4)
+                _mm_store_ps(destP, _mm_mul_ps(_mm_load_ps(source1P), _mm_load_ps(source2P)));
+        } else {
+            for (int i = 0; i < groups; ++i, source1P += 4, source2P += 4, destP += 4)
+                _mm_storeu_ps(destP, _mm_mul_ps(_mm_load_ps(source1P), _mm_loadu_ps(source2P)));
+        }
+        n %= 4;
+    }
+#elif CPU(ARM_NEON) && COMPILER(GCC)
+    if (sourceStride1 == 1 && sourceStride2 == 1 && destStride == 1) {
+        int groups = n / 4;
+        for (int i = 0; i < groups; ++i, source1P += 4, source2P += 4, destP += 4)
+            vst1q_f32(destP, vmulq_f32(vld1q_f32(source1P), vld1q_f32(source2P)));
+        n %= 4;
+    }
+#endif
+
+    while (n--) {
+        *destP = *source1P * *source2P;
+        source1P += sourceStride1;
+        source2P += sourceStride2;
+        destP += destStride;
+    }
+}
+
+void vsma(const float* sourceP, int sourceStride, const float* scale, float* destP, int destStride, size_t framesToProcess)
+{
+    int n = framesToProcess;
+    float k = *scale;
+
+#ifdef __SSE2__
+    if (sourceStride == 1 && destStride == 1) {
+        while (!isAligned16(sourceP) && n) {
+            *destP++ += k * *sourceP++;
+            n--;
+        }
+
+        __m128 mScale = _mm_set_ps1(k);
+        int groups = n / 4;
+        if (isAligned16(destP)) {
+            for (int i = 0; i < groups; ++i, sourceP += 4, destP += 4)
+                _mm_store_ps(destP, _mm_add_ps(_mm_load_ps(destP), _mm_mul_ps(_mm_load_ps(sourceP), mScale)));
+        } else {
+            for (int i = 0; i < groups; ++i, sourceP += 4, destP += 4)
+                _mm_storeu_ps(destP, _mm_add_ps(_mm_loadu_ps(destP), _mm_mul_ps(_mm_load_ps(sourceP), mScale)));
+        }
+        n %= 4;
+    }
+#elif CPU(ARM_NEON) && COMPILER(GCC)
+    if (sourceStride == 1 && destStride == 1) {
+        int groups = n / 4;
+        float32x4_t k4 = vdupq_n_f32(k);
+        for (int i = 0; i < groups; ++i, sourceP += 4, destP += 4)
+            vst1q_f32(destP, vmlaq_f32(vld1q_f32(destP), vld1q_f32(sourceP), k4));
+        n %= 4;
+    }
+#endif
+
+    while (n--) {
+        *destP += k * *sourceP;
+        sourceP += sourceStride;
+        destP += destStride;
+    }
+}
+
+void vmaxmgv(const float* sourceP, int sourceStride, float* maxP, size_t framesToProcess)
+{
+    int n = framesToProcess;
+    float max = 0;
+
+#ifdef __SSE2__
+    if (sourceStride == 1) {
+        while (!isAligned16(sourceP) && n) {
+            max = std::max(max, fabsf(*sourceP++));
+            n--;
+        }
+
+        // Clearing the sign bit gives the absolute value.
+        __m128 mMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        __m128 mMax = _mm_setzero_ps();
+        int groups = n / 4;
+        for (int i = 0; i < groups; ++i, sourceP += 4)
+            mMax = _mm_max_ps(mMax, _mm_and_ps(_mm_load_ps(sourceP), mMask));
+
+        float groupMax[4];
+        _mm_storeu_ps(groupMax, mMax);
+        max = std::max(max, std::max(std::max(groupMax[0], groupMax[1]), std::max(groupMax[2], groupMax[3])));
+        n %= 4;
+    }
+#elif CPU(ARM_NEON) && COMPILER(GCC)
+    if (sourceStride == 1) {
+        float32x4_t fourMax = vdupq_n_f32(0);
+        int groups = n / 4;
+        for (int i = 0; i < groups; ++i, sourceP += 4)
+            fourMax = vmaxq_f32(fourMax, vabsq_f32(vld1q_f32(sourceP)));
+
+        float32x2_t twoMax = vmax_f32(vget_low_f32(fourMax), vget_high_f32(fourMax));
+        float groupMax[2];
+        vst1_f32(groupMax, twoMax);
+        max = std::max(groupMax[0], groupMax[1]);
+        n %= 4;
+    }
+#endif
+
+    while (n--) {
+        max = std::max(max, fabsf(*sourceP));
+        sourceP += sourceStride;
+    }
+
+    *maxP = max;
+}
+
 #endif // OS(DARWIN)
 
 } // namespace VectorMath
@@ -31,9 +31,21 @@ namespace WebCore {
 
 namespace VectorMath {
 
+// Multiplies each element of the source by the scalar: dest = source * scale.
 void vsmul(const float* sourceP, int sourceStride, const float* scale, float* destP, int destStride, size_t framesToProcess);
+
+// Adds the vectors element by element: dest = source1 + source2.
 void vadd(const float* source1P, int sourceStride1, const float* source2P, int sourceStride2, float* destP, int destStride, size_t framesToProcess);
 
+// Multiplies the vectors element by element: dest = source1 * source2.
+void vmul(const float* source1P, int sourceStride1, const float* source2P, int sourceStride2, float* destP, int destStride, size_t framesToProcess);
+
+// Accumulates the source multiplied by the scalar: dest += source * scale.
+void vsma(const float* sourceP, int sourceStride, const float* scale, float* destP, int destStride, size_t framesToProcess);
+
+// Finds the maximum magnitude of the elements of the source.
+void vmaxmgv(const float* sourceP, int sourceStride, float* maxP, size_t framesToProcess);
+
 } // namespace VectorMath
 
 } // namespace WebCore
@@ -0,0 +1,435 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// FFTFrame implementation with no third-party dependency.
+//
+// The real FFT of size N is computed as a complex FFT of size N / 2 whose
+// real and imaginary inputs are the even and odd samples, followed by a split
+// step separating the spectra of the two. The complex FFT is an iterative
+// decimation-in-time transform working in place on the planar real and
+// imaginary data of the frame: a radix-4 first pass followed by radix-2
+// passes, whose butterflies use SSE2 or NEON when available.
+
+#include "config.h"
+
+#if ENABLE(WEB_AUDIO)
+
+#if !OS(DARWIN) && USE(WEBAUDIO_BUILTIN_FFT)
+
+#include "FFTFrame.h"
+
+#include <algorithm>
+#include <wtf/MathExtras.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif CPU(ARM_NEON) && COMPILER(GCC)
+#include <arm_neon.h>
+#endif
+
+namespace WebCore {
+
+const int kMaxFFTPow2Size = 24;
+
+Mutex* FFTFrame::s_tablesLock = 0;
+FFTFrame::FFTTables** FFTFrame::s_tables = 0;
+
+struct FFTFrame::FFTTables {
+    explicit FFTTables(unsigned fftSize);
+
+    // Bit reversal permutation of the indices of the complex FFT.
+    Vector<unsigned> bitReversed;
+
+    // Twiddle factors of the radix-2 passes. The factors of the pass combining
+    // transforms of size h into transforms of size 2h start at index h - 1.
+    AudioFloatArray passCos;
+    AudioFloatArray passSin;
+
+    // exp(-2 pi i k / N) for k in [0, N / 4], used by the split step.
+    AudioFloatArray splitCos;
+    AudioFloatArray splitSin;
+};
+
+FFTFrame::FFTTables::FFTTables(unsigned fftSize)
+    : bitReversed(fftSize / 2)
+    , passCos(fftSize / 2)
+    , passSin(fftSize / 2)
+    , splitCos(fftSize / 4 + 1)
+    , splitSin(fftSize / 4 + 1)
+{
+    unsigned halfSize = fftSize / 2;
+    unsigned log2HalfSize = static_cast<unsigned>(log2(halfSize));
+
+    for (unsigned i = 0; i < halfSize; ++i) {
+        unsigned reversed = 0;
+        for (unsigned bit = 0; bit < log2HalfSize; ++bit)
+            reversed |= ((i >> bit) & 1) << (log2HalfSize - 1 - bit);
+        bitReversed[i] = reversed;
+    }
+
+    for (unsigned h = 1; h < halfSize; h *= 2) {
+        for (unsigned j = 0; j < h; ++j) {
+            double phase = -piDouble * j / h;
+            passCos[h - 1 + j] = static_cast<float>(cos(phase));
+            passSin[h - 1 + j] = static_cast<float>(sin(phase));
+        }
+    }
+
+    for (unsigned k = 0; k <= fftSize / 4; ++k) {
+        double phase = -2 * piDouble * k / fftSize;
+        splitCos[k] = static_cast<float>(cos(phase));
+        splitSin[k] = static_cast<float>(sin(phase));
+    }
+}
+
+namespace {
+
+// Combines the transforms in a[0, count) and b[0, count) into a transform of
+// twice the size: a + w b goes to a and a - w b goes to b.
+void butterflies(float* realA, float* imagA, float* realB, float* imagB, const float* twiddleCos, const float* twiddleSin, unsigned count)
+{
+    unsigned j = 0;
+
+#if defined(__SSE2__)
+    for (; j + 4 <= count; j += 4) {
+        __m128 aReal = _mm_loadu_ps(realA + j);
+        __m128 aImag = _mm_loadu_ps(imagA + j);
+        __m128 bReal = _mm_loadu_ps(realB + j);
+        __m128 bImag = _mm_loadu_ps(imagB + j);
+        __m128 wReal = _mm_loadu_ps(twiddleCos + j);
+        __m128 wImag = _mm_loadu_ps(twiddleSin + j);
+
+        __m128 tReal = _mm_sub_ps(_mm_mul_ps(bReal, wReal), _mm_mul_ps(bImag, wImag));
+        __m128 tImag = _mm_add_ps(_mm_mul_ps(bReal, wImag), _mm_mul_ps(bImag, wReal));
+
+        _mm_storeu_ps(realB + j, _mm_sub_ps(aReal, tReal));
+        _mm_storeu_ps(imagB + j, _mm_sub_ps(aImag, tImag));
+        _mm_storeu_ps(realA + j, _mm_add_ps(aReal, tReal));
+        _mm_storeu_ps(imagA + j, _mm_add_ps(aImag, tImag));
+    }
+#elif CPU(ARM_NEON) && COMPILER(GCC)
+    for (; j + 4 <= count; j += 4) {
+        float32x4_t aReal = vld1q_f32(realA + j);
+        float32x4_t aImag = vld1q_f32(imagA + j);
+        float32x4_t bReal = vld1q_f32(realB + j);
+        float32x4_t bImag = vld1q_f32(imagB + j);
+        float32x4_t wReal = vld1q_f32(twiddleCos + j);
+        float32x4_t wImag = vld1q_f32(twiddleSin + j);
+
+        float32x4_t tReal = vmlsq_f32(vmulq_f32(bReal, wReal), bImag, wImag);
+        float32x4_t tImag = vmlaq_f32(vmulq_f32(bReal, wImag), bImag, wReal);
+
+        vst1q_f32(realB + j, vsubq_f32(aReal, tReal));
+        vst1q_f32(imagB + j, vsubq_f32(aImag, tImag));
+        vst1q_f32(realA + j, vaddq_f32(aReal, tReal));
+        vst1q_f32(imagA + j, vaddq_f32(aImag, tImag));
+    }
+#endif
+
+    for (; j < count; ++j) {
+        float tReal = realB[j] * twiddleCos[j] - imagB[j] * twiddleSin[j];
+        float tImag = realB[j] * twiddleSin[j] + imagB[j] * twiddleCos[j];
+        realB[j] = realA[j] - tReal;
+        imagB[j] = imagA[j] - tImag;
+        realA[j] += tReal;
+        imagA[j] += tImag;
+    }
+}
+
+// Forward complex FFT of size n, in place, of data in bit reversed order.
+// Passing the imaginary data as realP and the real data as imagP computes the
+// unnormalized inverse FFT instead.
+void complexFFT(float* realP, float* imagP, unsigned n, const float* passCos, const float* passSin)
+{
+    if (n == 1)
+        return;
+
+    if (n == 2) {
+        float real1 = realP[1];
+        float imag1 = imagP[1];
+        realP[1] = realP[0] - real1;
+        imagP[1] = imagP[0] - imag1;
+        realP[0] += real1;
+        imagP[0] += imag1;
+        return;
+    }
+
+    // Radix-4 pass combining the first two radix-2 passes, whose twiddle
+    // factors are all 1 or -i.
+    for (unsigned i = 0; i < n; i += 4) {
+        float real0 = realP[i] + realP[i + 1];
+        float imag0 = imagP[i] + imagP[i + 1];
+        float real1 = realP[i] - realP[i + 1];
+        float imag1 = imagP[i] - imagP[i + 1];
+        float real2 = realP[i + 2] + realP[i + 3];
+        float imag2 = imagP[i + 2] + imagP[i + 3];
+        // -i * (x2 - x3)
+        float real3 = imagP[i + 2] - imagP[i + 3];
+        float imag3 = realP[i + 3] - realP[i + 2];
+
+        realP[i] = real0 + real2;
+        imagP[i] = imag0 + imag2;
+        realP[i + 1] = real1 + real3;
+        imagP[i + 1] = imag1 + imag3;
+        realP[i + 2] = real0 - real2;
+        imagP[i + 2] = imag0 - imag2;
+        realP[i + 3] = real1 - real3;
+        imagP[i + 3] = imag1 - imag3;
+    }
+
+    for (unsigned h = 4; h < n; h *= 2) {
+        const float* twiddleCos = passCos + h - 1;
+        const float* twiddleSin = passSin + h - 1;
+        for (unsigned start = 0; start < n; start += 2 * h)
+            butterflies(realP + start, imagP + start, realP + start + h, imagP + start + h, twiddleCos, twiddleSin, h);
+    }
+}
+
+} // anonymous namespace
+
+// Normal constructor: allocates for a given fftSize.
+FFTFrame::FFTFrame(unsigned fftSize)
+    : m_FFTSize(fftSize)
+    , m_log2FFTSize(static_cast<unsigned>(log2(fftSize)))
+    , m_tables(tablesForSize(fftSize))
+    , m_realData(fftSize / 2)
+    , m_imagData(fftSize / 2)
+{
+    // We only allow power of two.
+    ASSERT(1UL << m_log2FFTSize == m_FFTSize);
+    ASSERT(m_FFTSize >= 2);
+}
+
+// Creates a blank/empty frame (interpolate() must later be called).
+FFTFrame::FFTFrame()
+    : m_FFTSize(0)
+    , m_log2FFTSize(0)
+    , m_tables(0)
+{
+}
+
+// Copy constructor.
+FFTFrame::FFTFrame(const FFTFrame& frame)
+    : m_FFTSize(frame.m_FFTSize)
+    , m_log2FFTSize(frame.m_log2FFTSize)
+    , m_tables(frame.m_tables)
+    , m_realData(frame.m_realData)
+    , m_imagData(frame.m_imagData)
+{
+}
+
+FFTFrame::~FFTFrame()
+{
+}
+
+void FFTFrame::multiply(const FFTFrame& frame)
+{
+    FFTFrame& frame1 = *this;
+    FFTFrame& frame2 = const_cast<FFTFrame&>(frame);
+
+    float* realP1 = frame1.realData();
+    float* imagP1 = frame1.imagData();
+    const float* realP2 = frame2.realData();
+    const float* imagP2 = frame2.imagData();
+
+    // Scale accounts for the scaling of the frequency domain data, which
+    // matches vecLib on the Mac. This ensures the right scaling all the way
+    // back to the inverse FFT.
+    float scale = 0.5f;
+
+    // Multiply the packed DC/nyquist component
+    realP1[0] *= scale * realP2[0];
+    imagP1[0] *= scale * imagP2[0];
+
+    unsigned halfSize = fftSize() / 2;
+
+    for (unsigned i = 1; i < halfSize; ++i) {
+        float realResult = realP1[i] * realP2[i] - imagP1[i] * imagP2[i];
+        float imagResult = realP1[i] * imagP2[i] + imagP1[i] * realP2[i];
+
+        realP1[i] = scale * realResult;
+        imagP1[i] = scale * imagResult;
+    }
+}
+
+void FFTFrame::doFFT(float* data)
+{
+    unsigned halfSize = fftSize() / 2;
+    float* realP = realData();
+    float* imagP = imagData();
+
+    // The even samples are the real part and the odd samples the imaginary
+    // part of the input of the complex FFT.
+    const unsigned* bitReversed = m_tables->bitReversed.data();
+    for (unsigned i = 0; i < halfSize; ++i) {
+        unsigned j = bitReversed[i];
+        realP[j] = data[2 * i];
+        imagP[j] = data[2 * i + 1];
+    }
+
+    complexFFT(realP, imagP, halfSize, m_tables->passCos.data(), m_tables->passSin.data());
+
+    // Split step. With Z the complex FFT, the FFTs of the even and odd samples
+    // are E(k) = (Z(k) + Z*(N/2 - k)) / 2 and O(k) = -i (Z(k) - Z*(N/2 - k)) / 2,
+    // and X(k) = E(k) + w^k O(k), X(N/2 - k) = E*(k) - w^-k O*(k). The results
+    // are scaled by 2 to match vecLib on the Mac.
+    float real0 = realP[0];
+    float imag0 = imagP[0];
+    realP[0] = 2 * (real0 + imag0);
+    // The Nyquist component is packed in the imaginary part of the DC component.
+    imagP[0] = 2 * (real0 - imag0);
+
+    const float* splitCos = m_tables->splitCos.data();
+    const float* splitSin = m_tables->splitSin.data();
+    for (unsigned k = 1; k <= halfSize / 2; ++k) {
+        unsigned m = halfSize - k;
+        float evenReal = realP[k] + realP[m];
+        float evenImag = imagP[k] - imagP[m];
+        float oddReal = imagP[k] + imagP[m];
+        float oddImag = realP[m] - realP[k];
+
+        float tReal = splitCos[k] * oddReal - splitSin[k] * oddImag;
+        float tImag = splitCos[k] * oddImag + splitSin[k] * oddReal;
+
+        realP[k] = evenReal + tReal;
+        imagP[k] = evenImag + tImag;
+        realP[m] = evenReal - tReal;
+        imagP[m] = tImag - evenImag;
+    }
+}
+
+// Like vecLib on the Mac, this transforms the frequency domain data in place,
+// so it is no longer valid afterwards.
+void FFTFrame::doInverseFFT(float* data)
+{
+    unsigned halfSize = fftSize() / 2;
+    float* realP = realData();
+    float* imagP = imagData();
+
+    // Undo the split step, giving 4 Z(k).
+    float dc = realP[0];
+    float nyquist = imagP[0];
+    realP[0] = dc + nyquist;
+    imagP[0] = dc - nyquist;
+
+    const float* splitCos = m_tables->splitCos.data();
+    const float* splitSin = m_tables->splitSin.data();
+    for (unsigned k = 1; k <= halfSize / 2; ++k) {
+        unsigned m = halfSize - k;
+        // Sum and difference of X(k) and X*(N/2 - k).
+        float sumReal = realP[k] + realP[m];
+        float sumImag = imagP[k] - imagP[m];
+        float differenceReal = realP[k] - realP[m];
+        float differenceImag = imagP[k] + imagP[m];
+
+        // Difference multiplied by w^-k.
+        float oddReal = splitCos[k] * differenceReal + splitSin[k] * differenceImag;
+        float oddImag = splitCos[k] * differenceImag - splitSin[k] * differenceReal;
+
+        realP[k] = sumReal - oddImag;
+        imagP[k] = sumImag + oddReal;
+        realP[m] = sumReal + oddImag;
+        imagP[m] = oddReal - sumImag;
+    }
+
+    const unsigned* bitReversed = m_tables->bitReversed.data();
+    for (unsigned i = 0; i < halfSize; ++i) {
+        unsigned j = bitReversed[i];
+        if (i < j) {
+            std::swap(realP[i], realP[j]);
+            std::swap(imagP[i], imagP[j]);
+        }
+    }
+
+    complexFFT(imagP, realP, halfSize, m_tables->passCos.data(), m_tables->passSin.data());
+
+    // The inverse complex FFT is unnormalized and its input was scaled by 4,
+    // on top of the factor of 2 of the frequency domain data.
+    float scale = 1.0f / (2 * fftSize());
+    for (unsigned i = 0; i < halfSize; ++i) {
+        data[2 * i] = scale * realP[i];
+        data[2 * i + 1] = scale * imagP[i];
+    }
+}
+
+void FFTFrame::initialize()
+{
+    if (!s_tables) {
+        s_tables = new FFTTables*[kMaxFFTPow2Size];
+        for (int i = 0; i < kMaxFFTPow2Size; ++i)
+            s_tables[i] = 0;
+    }
+
+    if (!s_tablesLock)
+        s_tablesLock = new Mutex();
+}
+
+void FFTFrame::cleanup()
+{
+    if (!s_tables)
+        return;
+
+    for (int i = 0; i < kMaxFFTPow2Size; ++i)
+        delete s_tables[i];
+
+    delete[] s_tables;
+    s_tables = 0;
+
+    delete s_tablesLock;
+    s_tablesLock = 0;
+}
+
+float* FFTFrame::realData() const
+{
+    return const_cast<float*>(m_realData.data());
+}
+
+float* FFTFrame::imagData() const
+{
+    return const_cast<float*>(m_imagData.data());
+}
+
+const FFTFrame::FFTTables* FFTFrame::tablesForSize(unsigned fftSize)
+{
+    // initialize() must be called first.
+    ASSERT(s_tables && s_tablesLock);
+    if (!s_tables || !s_tablesLock)
+        return 0;
+
+    MutexLocker locker(*s_tablesLock);
+
+    ASSERT(fftSize);
+    int pow2size = static_cast<int>(log2(fftSize));
+    ASSERT(pow2size < kMaxFFTPow2Size);
+    if (!s_tables[pow2size])
+        s_tables[pow2size] = new FFTTables(fftSize);
+    return s_tables[pow2size];
+}
+
+} // namespace WebCore
+
+#endif // !OS(DARWIN) && USE(WEBAUDIO_BUILTIN_FFT)
+
+#endif // ENABLE(WEB_AUDIO)
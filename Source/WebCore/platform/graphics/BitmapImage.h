@@ -154,6 +154,9 @@ public:
 
 #if PLATFORM(ANDROID)
     virtual void setURL(const String& str);
+    // Called with the device size the whole image is drawn at, so the decoder
+    // can use a lower resolution for images that are only shown small.
+    void noteDrawnSize(const IntSize&);
 #endif
 
 #if PLATFORM(GTK)
@@ -31,6 +31,7 @@
 #include "GlyphBuffer.h"
 #include "TextRun.h"
 #include "WidthIterator.h"
+#include <wtf/CurrentTime.h>
 #include <wtf/MathExtras.h>
 #include <wtf/UnusedParam.h>
 
@@ -177,7 +178,25 @@ float Font::width(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFo
         // If the complex text implementation cannot return fallback fonts, avoid
         // returning them for simple text as well.
         static bool returnFallbackFonts = canReturnFallbackFontsForComplexText();
-        return floatWidthForSimpleText(run, 0, returnFallbackFonts ? fallbackFonts : 0, codePathToUse == SimpleWithGlyphOverflow || (glyphOverflow && glyphOverflow->computeBounds) ? glyphOverflow : 0);
+        HashSet<const SimpleFontData*>* fallbackFontsToReturn = returnFallbackFonts ? fallbackFonts : 0;
+        GlyphOverflow* glyphOverflowToCompute = codePathToUse == SimpleWithGlyphOverflow || (glyphOverflow && glyphOverflow->computeBounds) ? glyphOverflow : 0;
+
+        // The width cache only knows widths, so it cannot answer callers that
+        // also want fallback fonts or glyph bounds. Spacing is a property of
+        // this Font rather than of the fallback list that owns the cache, and
+        // widths measured while web fonts load are only placeholders.
+        if (fallbackFontsToReturn || glyphOverflowToCompute || wordSpacing() || letterSpacing() || loadingCustomFonts()
+            || !WidthCache::isCacheable(run))
+            return floatWidthForSimpleText(run, 0, fallbackFontsToReturn, glyphOverflowToCompute);
+
+        WidthCache& widthCache = m_fontList->widthCache();
+        if (float* cachedWidth = widthCache.find(run))
+            return *cachedWidth;
+
+        double startTime = WidthCache::shouldTimeNextMiss() ? currentTime() : 0;
+        float width = floatWidthForSimpleText(run, 0);
+        widthCache.add(run, width, startTime ? currentTime() - startTime : -1);
+        return width;
     }
 
     return floatWidthForComplexText(run, fallbackFonts, glyphOverflow);
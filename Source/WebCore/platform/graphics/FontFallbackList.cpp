@@ -56,6 +56,7 @@ void FontFallbackList::invalidate(PassRefPtr<FontSelector> fontSelector)
     m_familyIndex = 0;    
     m_pitch = UnknownPitch;
     m_loadingCustomFonts = false;
+    m_widthCache.clear();
     m_fontSelector = fontSelector;
     m_generation = fontCache()->generation();
 }
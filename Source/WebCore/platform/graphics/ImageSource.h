@@ -89,12 +89,20 @@ typedef QPixmap* NativeImagePtr;
 #ifdef ANDROID_ANIMATED_GIF
 class GIFImageDecoder;
 #endif
+#ifdef ANDROID_PROGRESSIVE_IMAGE_DECODING
+class ImageDecoder;
+#endif
 struct NativeImageSourcePtr {
     SkString m_url;
     PrivateAndroidImageSourceRec* m_image;
 #ifdef ANDROID_ANIMATED_GIF
     GIFImageDecoder* m_gifDecoder;
 #endif
+#ifdef ANDROID_PROGRESSIVE_IMAGE_DECODING
+    // Streaming decoder used to draw the rows received so far while the
+    // image is still loading. Deleted once all the data has arrived.
+    ImageDecoder* m_progressiveDecoder;
+#endif
 };
 typedef const Vector<char>* NativeBytePtr;
 typedef SkBitmapRef* NativeImagePtr;
@@ -210,6 +218,11 @@ public:
 #if PLATFORM(ANDROID)
     void clearURL();
     void setURL(const String& url);
+    void noteDrawnSize(const IntSize&, SharedBuffer* data);
+    // Sets the scale from the drawing canvas to device pixels, which the page is
+    // zoomed by after it is recorded. Returns true if images may now be decoded
+    // too small, in which case the content should be recorded again.
+    static bool setDrawnSizeScale(float);
 #endif
 
 private:
@@ -36,7 +36,10 @@
 #include "Timer.h"
 #include <wtf/MathExtras.h>
 #include <wtf/Noncopyable.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
 #include <wtf/UnusedParam.h>
+#include <wtf/Vector.h>
 
 using namespace std;
 
@@ -162,6 +165,132 @@ ScratchBuffer& ScratchBuffer::shared()
     return scratchBuffer;
 }
 
+// Identifies a blurred and colored shadow template. The template size follows
+// from the blur radius and the corner radii, and is kept to account for memory.
+struct ShadowTemplateKey {
+    ShadowTemplateKey(bool inset, float blurRadius, bool shadowsIgnoreTransforms, const Color& color, ColorSpace colorSpace, const IntSize& templateSize, const RoundedIntRect::Radii& radii)
+        : inset(inset)
+        , blurRadius(blurRadius)
+        , shadowsIgnoreTransforms(shadowsIgnoreTransforms)
+        , color(color)
+        , colorSpace(colorSpace)
+        , templateSize(templateSize)
+        , radii(radii)
+    {
+    }
+
+    bool operator==(const ShadowTemplateKey& other) const
+    {
+        return inset == other.inset && blurRadius == other.blurRadius && shadowsIgnoreTransforms == other.shadowsIgnoreTransforms
+            && color == other.color && colorSpace == other.colorSpace && templateSize == other.templateSize && radii == other.radii;
+    }
+
+    bool inset;
+    float blurRadius;
+    bool shadowsIgnoreTransforms;
+    Color color;
+    ColorSpace colorSpace;
+    IntSize templateSize;
+    RoundedIntRect::Radii radii;
+};
+
+// Keeps the templates of the tiled shadow paths, since pages tend to give many
+// boxes the same shadow and blurring the template is the expensive part of
+// drawing it. Like the scratch buffer, the templates are purged once no shadow
+// has been drawn for a while.
+class ShadowTemplateCache {
+public:
+    ShadowTemplateCache()
+        : m_purgeTimer(this, &ShadowTemplateCache::timerFired)
+        , m_size(0)
+    {
+    }
+
+    ImageBuffer* find(const ShadowTemplateKey& key)
+    {
+        // The cache is small, so a linear search from the most recently used end is cheapest.
+        for (size_t i = m_entries.size(); i; --i) {
+            Entry* entry = m_entries[i - 1];
+            if (entry->key == key) {
+                m_entries.remove(i - 1);
+                m_entries.append(entry);
+                return entry->image.get();
+            }
+        }
+        return 0;
+    }
+
+    // Takes the template and evicts the least recently used ones to make room
+    // for it. A template larger than the whole budget is kept until the next add.
+    ImageBuffer* add(const ShadowTemplateKey& key, PassOwnPtr<ImageBuffer> image)
+    {
+        size_t size = byteSize(key.templateSize);
+        while (!m_entries.isEmpty() && m_size + size > maximumSize) {
+            Entry* entry = m_entries[0];
+            m_entries.remove(0);
+            m_size -= byteSize(entry->key.templateSize);
+            delete entry;
+        }
+
+        Entry* entry = new Entry(key, image);
+        m_entries.append(entry);
+        m_size += size;
+        return entry->image.get();
+    }
+
+    void schedulePurge()
+    {
+        if (m_purgeTimer.isActive())
+            m_purgeTimer.stop();
+
+        const double templateCachePurgeInterval = 2;
+        m_purgeTimer.startOneShot(templateCachePurgeInterval);
+    }
+
+    static ShadowTemplateCache& shared();
+
+private:
+    struct Entry {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        Entry(const ShadowTemplateKey& key, PassOwnPtr<ImageBuffer> image)
+            : key(key)
+            , image(image)
+        {
+        }
+
+        ShadowTemplateKey key;
+        OwnPtr<ImageBuffer> image;
+    };
+
+    static const size_t maximumSize = 2 * 1024 * 1024;
+
+    static size_t byteSize(const IntSize& size) { return static_cast<size_t>(size.width()) * size.height() * 4; }
+
+    void timerFired(Timer<ShadowTemplateCache>*)
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        deleteAllValues(m_entries);
+        m_entries.clear();
+        m_size = 0;
+    }
+
+    // Least recently used first.
+    Vector<Entry*> m_entries;
+    Timer<ShadowTemplateCache> m_purgeTimer;
+    size_t m_size;
+};
+
+ShadowTemplateCache& ShadowTemplateCache::shared()
+{
+    DEFINE_STATIC_LOCAL(ShadowTemplateCache, templateCache, ());
+    return templateCache;
+}
+
 static const int templateSideLength = 1;
 
 ShadowBlur::ShadowBlur(float radius, const FloatSize& offset, const Color& color, ColorSpace colorSpace)
@@ -612,16 +741,20 @@ void ShadowBlur::drawInsetShadowWithTiling(GraphicsContext* graphicsContext, con
     const float roundedRadius = ceilf(m_blurRadius);
     const float twiceRadius = roundedRadius * 2;
 
-    m_layerImage = ScratchBuffer::shared().getScratchBuffer(templateSize);
-    if (!m_layerImage)
-        return;
+    ShadowTemplateKey templateKey(true, m_blurRadius, m_shadowsIgnoreTransforms, m_color, m_colorSpace, templateSize, radii);
+    m_layerImage = ShadowTemplateCache::shared().find(templateKey);
+    if (!m_layerImage) {
+        OwnPtr<ImageBuffer> templateImage = ImageBuffer::create(templateSize);
+        if (!templateImage) {
+            graphicsContext->restore();
+            return;
+        }
+        m_layerImage = ShadowTemplateCache::shared().add(templateKey, templateImage.release());
 
-    // Draw the rectangle with hole.
-    FloatRect templateBounds(0, 0, templateSize.width(), templateSize.height());
-    FloatRect templateHole = FloatRect(roundedRadius, roundedRadius, templateSize.width() - twiceRadius, templateSize.height() - twiceRadius);
+        // Draw the rectangle with hole.
+        FloatRect templateBounds(0, 0, templateSize.width(), templateSize.height());
+        FloatRect templateHole = FloatRect(roundedRadius, roundedRadius, templateSize.width() - twiceRadius, templateSize.height() - twiceRadius);
 
-    if (!ScratchBuffer::shared().matchesLastInsetShadow(m_blurRadius, m_color, m_colorSpace, templateBounds, templateHole, radii)) {
-        // Draw shadow into a new ImageBuffer.
         GraphicsContext* shadowContext = m_layerImage->context();
         shadowContext->save();
         shadowContext->clearRect(templateBounds);
@@ -639,8 +772,6 @@ void ShadowBlur::drawInsetShadowWithTiling(GraphicsContext* graphicsContext, con
 
         blurAndColorShadowBuffer(templateSize);
         shadowContext->restore();
-    
-        ScratchBuffer::shared().setLastInsetShadowValues(m_blurRadius, m_color, m_colorSpace, templateBounds, templateHole, radii);
     }
 
     FloatRect boundingRect = rect;
@@ -667,7 +798,7 @@ void ShadowBlur::drawInsetShadowWithTiling(GraphicsContext* graphicsContext, con
     graphicsContext->restore();
 
     m_layerImage = 0;
-    ScratchBuffer::shared().scheduleScratchBufferPurge();
+    ShadowTemplateCache::shared().schedulePurge();
 }
 
 void ShadowBlur::drawRectShadowWithTiling(GraphicsContext* graphicsContext, const FloatRect& shadowedRect, const RoundedIntRect::Radii& radii, const IntSize& templateSize)
@@ -678,13 +809,18 @@ void ShadowBlur::drawRectShadowWithTiling(GraphicsContext* graphicsContext, cons
     const float roundedRadius = ceilf(m_blurRadius);
     const float twiceRadius = roundedRadius * 2;
 
-    m_layerImage = ScratchBuffer::shared().getScratchBuffer(templateSize);
-    if (!m_layerImage)
-        return;
+    ShadowTemplateKey templateKey(false, m_blurRadius, m_shadowsIgnoreTransforms, m_color, m_colorSpace, templateSize, radii);
+    m_layerImage = ShadowTemplateCache::shared().find(templateKey);
+    if (!m_layerImage) {
+        OwnPtr<ImageBuffer> templateImage = ImageBuffer::create(templateSize);
+        if (!templateImage) {
+            graphicsContext->restore();
+            return;
+        }
+        m_layerImage = ShadowTemplateCache::shared().add(templateKey, templateImage.release());
 
-    FloatRect templateShadow = FloatRect(roundedRadius, roundedRadius, templateSize.width() - twiceRadius, templateSize.height() - twiceRadius);
+        FloatRect templateShadow = FloatRect(roundedRadius, roundedRadius, templateSize.width() - twiceRadius, templateSize.height() - twiceRadius);
 
-    if (!ScratchBuffer::shared().matchesLastShadow(m_blurRadius, m_color, m_colorSpace, templateShadow, radii)) {
         // Draw shadow into the ImageBuffer.
         GraphicsContext* shadowContext = m_layerImage->context();
         shadowContext->save();
@@ -701,8 +837,6 @@ void ShadowBlur::drawRectShadowWithTiling(GraphicsContext* graphicsContext, cons
 
         blurAndColorShadowBuffer(templateSize);
         shadowContext->restore();
-
-        ScratchBuffer::shared().setLastShadowValues(m_blurRadius, m_color, m_colorSpace, templateShadow, radii);
     }
 
     FloatRect shadowBounds = shadowedRect;
@@ -714,7 +848,7 @@ void ShadowBlur::drawRectShadowWithTiling(GraphicsContext* graphicsContext, cons
     graphicsContext->restore();
 
     m_layerImage = 0;
-    ScratchBuffer::shared().scheduleScratchBufferPurge();
+    ShadowTemplateCache::shared().schedulePurge();
 }
 
 void ShadowBlur::drawLayerPieces(GraphicsContext* graphicsContext, const FloatRect& shadowBounds, const RoundedIntRect::Radii& radii, float roundedRadius, const IntSize& templateSize, ShadowDirection direction)
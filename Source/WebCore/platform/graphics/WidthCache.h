@@ -0,0 +1,221 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WidthCache_h
+#define WidthCache_h
+
+#include "TextRun.h"
+#include <wtf/HashMap.h>
+#include <wtf/HashTraits.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/StdLibExtras.h>
+#include <wtf/StringHasher.h>
+
+namespace WebCore {
+
+// Remembers the widths of short runs of simple text, such as the words that
+// line breaking measures one at a time, so that relayouts and lines that
+// repeat a word do not walk the glyph pages again. It is owned by the
+// FontFallbackList and so dropped whenever the fonts are invalidated.
+//
+// All the caches share one budget of entries. When it is exceeded, the caches
+// that were added to least recently are cleared first.
+class WidthCache {
+    WTF_MAKE_NONCOPYABLE(WidthCache);
+public:
+    struct Statistics {
+        Statistics()
+            : hits(0)
+            , misses(0)
+            , timedMisses(0)
+            , timeMeasuringTimedMisses(0)
+        {
+        }
+
+        // Time that the hits would have cost had they been measured, going by
+        // the average cost of the misses that were timed.
+        double estimatedTimeSaved() const { return timedMisses ? hits * timeMeasuringTimedMisses / timedMisses : 0; }
+
+        unsigned hits;
+        unsigned misses;
+        unsigned timedMisses;
+        double timeMeasuringTimedMisses;
+    };
+
+    // Only one miss in this many is timed, to keep the clock off the
+    // measuring path.
+    static const unsigned missTimingInterval = 16;
+
+    WidthCache() { }
+    ~WidthCache() { clear(); }
+
+    // Returns the cached width of |run|, or 0 if it has not been measured.
+    float* find(const TextRun& run)
+    {
+        if (!isCacheable(run))
+            return 0;
+
+        Map::iterator it = m_map.find(SmallStringKey(run.characters(), run.length()));
+        if (it == m_map.end())
+            return 0;
+        ++statistics().hits;
+        return &it->second;
+    }
+
+    // Returns true if the width measured for the next miss should be timed
+    // and passed to add().
+    static bool shouldTimeNextMiss() { return !(statistics().misses % missTimingInterval); }
+
+    // |timeMeasuring| is negative if the miss was not timed.
+    void add(const TextRun& run, float width, double timeMeasuring)
+    {
+        if (!isCacheable(run))
+            return;
+
+        Statistics& stats = statistics();
+        ++stats.misses;
+        if (timeMeasuring >= 0) {
+            ++stats.timedMisses;
+            stats.timeMeasuringTimedMisses += timeMeasuring;
+        }
+
+        if (!m_map.add(SmallStringKey(run.characters(), run.length()), width).second)
+            return;
+        ++totalSize();
+
+        // Guard against pathological growth, for example from a script that
+        // measures a stream of generated strings.
+        ListHashSet<WidthCache*>& caches = cachesByLastAdd();
+        caches.remove(this);
+        caches.add(this);
+        while (totalSize() > maximumTotalSize)
+            caches.first()->clear();
+    }
+
+    void clear()
+    {
+        if (m_map.isEmpty())
+            return;
+        totalSize() -= m_map.size();
+        m_map.clear();
+        cachesByLastAdd().remove(this);
+    }
+
+    static bool isCacheable(const TextRun& run)
+    {
+        // Tabs and justification make the width depend on where the run sits
+        // in the line, and mirroring can change the glyphs of RTL runs.
+        return run.length() && static_cast<unsigned>(run.length()) <= SmallStringKey::capacity
+            && !run.allowTabs() && !run.expansion() && !run.rtl() && run.horizontalGlyphStretch() == 1;
+    }
+
+    static Statistics& statistics()
+    {
+        static Statistics stats;
+        return stats;
+    }
+
+private:
+    // The empty key has length 0, which no cached run has, so that zeroed
+    // memory is the empty value.
+    class SmallStringKey {
+    public:
+        static const unsigned capacity = 15;
+
+        SmallStringKey()
+            : m_length(0)
+            , m_hash(0)
+        {
+        }
+
+        SmallStringKey(WTF::HashTableDeletedValueType)
+            : m_length(deletedValueLength)
+            , m_hash(0)
+        {
+        }
+
+        SmallStringKey(const UChar* characters, unsigned length)
+            : m_length(length)
+        {
+            ASSERT(length && length <= capacity);
+            StringHasher hasher;
+            for (unsigned i = 0; i < length; ++i) {
+                m_characters[i] = characters[i];
+                hasher.addCharacter(characters[i]);
+            }
+            m_hash = hasher.hash();
+        }
+
+        unsigned hash() const { return m_hash; }
+        bool isHashTableDeletedValue() const { return m_length == deletedValueLength; }
+
+        bool operator==(const SmallStringKey& other) const
+        {
+            if (m_hash != other.m_hash || m_length != other.m_length)
+                return false;
+            return m_length > capacity || !memcmp(m_characters, other.m_characters, m_length * sizeof(UChar));
+        }
+
+    private:
+        static const unsigned deletedValueLength = capacity + 1;
+
+        UChar m_characters[capacity];
+        unsigned m_length;
+        unsigned m_hash;
+    };
+
+    struct SmallStringKeyHash {
+        static unsigned hash(const SmallStringKey& key) { return key.hash(); }
+        static bool equal(const SmallStringKey& a, const SmallStringKey& b) { return a == b; }
+        static const bool safeToCompareToEmptyOrDeleted = true;
+    };
+
+    struct SmallStringKeyHashTraits : WTF::SimpleClassHashTraits<SmallStringKey> { };
+
+    typedef HashMap<SmallStringKey, float, SmallStringKeyHash, SmallStringKeyHashTraits> Map;
+
+    // Shared by all the caches, about a megabyte
+    static const unsigned maximumTotalSize = 10000;
+
+    static unsigned& totalSize()
+    {
+        static unsigned size = 0;
+        return size;
+    }
+
+    // The non-empty caches, least recently added to first
+    static ListHashSet<WidthCache*>& cachesByLastAdd()
+    {
+        DEFINE_STATIC_LOCAL(ListHashSet<WidthCache*>, caches, ());
+        return caches;
+    }
+
+    Map m_map;
+};
+
+} // namespace WebCore
+
+#endif // WidthCache_h
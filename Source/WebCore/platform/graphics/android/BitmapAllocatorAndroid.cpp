@@ -23,11 +23,16 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#define LOG_TAG "BitmapAllocatorAndroid"
+
 #include "config.h"
 #include "BitmapAllocatorAndroid.h"
+
+#include "AndroidLog.h"
 #include "SharedBufferStream.h"
 #include "SkImageRef_GlobalPool.h"
 #include "SkImageRef_ashmem.h"
+#include <utils/threads.h>
 
 // made this up, so we don't waste a file-descriptor on small images, plus
 // we don't want to lose too much on the round-up to a page size (4K)
@@ -42,6 +47,74 @@ static bool should_use_ashmem(const SkBitmap& bm) {
 
 namespace WebCore {
 
+static android::Mutex gStatsLock;
+static BitmapAllocatorAndroid::Stats gStats;
+
+/*  Both ashmem and the global pool keep the decoded pixels only while they are
+    locked: unpinned ashmem can be reclaimed by the kernel, and the global pool
+    frees the least recently used unlocked pixels when it is over budget. Either
+    way SkImageRef decodes the pixels again from the stream on the next lock.
+    This wraps them to account for the memory that is locked, and for how much
+    of it had to be decoded again.
+ */
+template <typename ImageRef>
+class DiscardableImageRef : public ImageRef {
+public:
+    DiscardableImageRef(SkStream* stream, SkBitmap::Config config, int sampleSize)
+        : ImageRef(stream, config, sampleSize)
+        , fPixelSize(0)
+        , fLockedSize(0)
+        , fHasDecodedPixels(false) {
+    }
+
+protected:
+    virtual bool onDecode(SkImageDecoder* codec, SkStream* stream,
+                          SkBitmap* bitmap, SkBitmap::Config config,
+                          SkImageDecoder::Mode mode) {
+        bool success = ImageRef::onDecode(codec, stream, bitmap, config, mode);
+        if (mode != SkImageDecoder::kDecodePixels_Mode)
+            return success;
+
+        size_t size = bitmap->getSize();
+        android::Mutex::Autolock lock(gStatsLock);
+        if (fHasDecodedPixels) {
+            gStats.discardedBytes += size;
+            gStats.redecodeCount++;
+            if (success)
+                gStats.redecodedBytes += size;
+        } else if (success)
+            gStats.decodedBytes += size;
+        if (success) {
+            fPixelSize = size;
+            fHasDecodedPixels = true;
+        }
+        return success;
+    }
+
+    // SkPixelRef only calls these for the first lock and the last unlock.
+    virtual void* onLockPixels(SkColorTable** colorTable) {
+        void* pixels = ImageRef::onLockPixels(colorTable);
+        if (pixels) {
+            android::Mutex::Autolock lock(gStatsLock);
+            fLockedSize = fPixelSize;
+            gStats.lockedBytes += fLockedSize;
+        }
+        return pixels;
+    }
+
+    virtual void onUnlockPixels() {
+        ImageRef::onUnlockPixels();
+        android::Mutex::Autolock lock(gStatsLock);
+        gStats.lockedBytes -= fLockedSize;
+        fLockedSize = 0;
+    }
+
+private:
+    size_t fPixelSize;
+    size_t fLockedSize;
+    bool   fHasDecodedPixels;
+};
+
 BitmapAllocatorAndroid::BitmapAllocatorAndroid(SharedBuffer* data,
                                                int sampleSize)
 {
@@ -59,13 +132,36 @@ bool BitmapAllocatorAndroid::allocPixelRef(SkBitmap* bitmap, SkColorTable*)
     SkPixelRef* ref;
     if (should_use_ashmem(*bitmap)) {
 //        SkDebugf("ashmem [%d %d]\n", bitmap->width(), bitmap->height());
-        ref = new SkImageRef_ashmem(fStream, bitmap->config(), fSampleSize);
+        ref = new DiscardableImageRef<SkImageRef_ashmem>(fStream, bitmap->config(), fSampleSize);
     } else {
 //        SkDebugf("globalpool [%d %d]\n", bitmap->width(), bitmap->height());
-        ref = new SkImageRef_GlobalPool(fStream, bitmap->config(), fSampleSize);
+        ref = new DiscardableImageRef<SkImageRef_GlobalPool>(fStream, bitmap->config(), fSampleSize);
     }
     bitmap->setPixelRef(ref)->unref();
     return true;
 }
 
+BitmapAllocatorAndroid::Stats BitmapAllocatorAndroid::stats()
+{
+    android::Mutex::Autolock lock(gStatsLock);
+    return gStats;
+}
+
+void BitmapAllocatorAndroid::dumpStats()
+{
+    Stats current = stats();
+    ALOGD("*** decoded images: %.2f Mb locked, %.2f Mb decoded, %.2f Mb discarded, %.2f Mb re-decoded (%u times)",
+          current.lockedBytes / 1024.0 / 1024.0,
+          current.decodedBytes / 1024.0 / 1024.0,
+          current.discardedBytes / 1024.0 / 1024.0,
+          current.redecodedBytes / 1024.0 / 1024.0,
+          current.redecodeCount);
+}
+
+void BitmapAllocatorAndroid::purgeUnlockedPixels()
+{
+    // Frees every unlocked entry of the pool, without changing its budget.
+    SkImageRef_GlobalPool::SetRAMUsed(0);
+}
+
 }
@@ -46,6 +46,26 @@ namespace WebCore {
         // overrides
         virtual bool allocPixelRef(SkBitmap*, SkColorTable*);
 
+        /** Pixel memory of the images allocated here. Pixels are only
+            guaranteed to stay around while they are locked for drawing;
+            unlocked pixels may be discarded under memory pressure and are
+            decoded again from the encoded data when next locked.
+         */
+        struct Stats {
+            size_t lockedBytes;     // currently locked for drawing
+            size_t decodedBytes;    // decoded for the first time
+            size_t discardedBytes;  // found discarded when locked again
+            size_t redecodedBytes;  // decoded again after being discarded
+            unsigned redecodeCount;
+        };
+        static Stats stats();
+        static void dumpStats();
+
+        /** Discards the unlocked pixels of the images that are not in ashmem.
+            The kernel already reclaims unpinned ashmem pixels on its own.
+         */
+        static void purgeUnlockedPixels();
+
     private:
         SharedBufferStream* fStream;
         int                 fSampleSize;
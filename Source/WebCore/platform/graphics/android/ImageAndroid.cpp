@@ -171,12 +171,29 @@ static void round_scaled(SkIRect* dst, const WebCore::FloatRect& src,
              SkScalarRound(SkFloatToScalar((src.y() + src.height()) * sy)));
 }
 
+// Returns the size on the device of an image of the given size drawn with
+// the given matrix.
+static IntSize drawnImageSize(const SkMatrix& matrix, const IntSize& size)
+{
+    SkRect rect;
+    rect.set(0, 0, SkIntToScalar(size.width()), SkIntToScalar(size.height()));
+    matrix.mapRect(&rect);
+    return IntSize(SkScalarCeil(rect.width()), SkScalarCeil(rect.height()));
+}
+
 void BitmapImage::draw(GraphicsContext* gc, const FloatRect& dstRect,
                    const FloatRect& srcRect, ColorSpace,
                    CompositeOperator compositeOp)
 {
     startAnimation();
 
+    if (!srcRect.isEmpty()) {
+        SkMatrix matrix(gc->platformContext()->getTotalMatrix());
+        matrix.preScale(SkFloatToScalar(dstRect.width() / srcRect.width()),
+                        SkFloatToScalar(dstRect.height() / srcRect.height()));
+        noteDrawnSize(drawnImageSize(matrix, size()));
+    }
+
     SkBitmapRef* image = this->nativeImageForCurrentFrame();
     if (!image) { // If it's too early we won't have an image yet.
         return;
@@ -225,6 +242,11 @@ void BitmapImage::setURL(const String& str)
     m_source.setURL(str);
 }
 
+void BitmapImage::noteDrawnSize(const IntSize& drawnSize)
+{
+    m_source.noteDrawnSize(drawnSize, data());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void Image::drawPattern(GraphicsContext* gc, const FloatRect& srcRect,
@@ -232,8 +254,17 @@ void Image::drawPattern(GraphicsContext* gc, const FloatRect& srcRect,
                         const FloatPoint& phase, ColorSpace,
                         CompositeOperator compositeOp, const FloatRect& destRect)
 {
+    if (destRect.isEmpty())
+        return;
+
+    if (isBitmapImage()) {
+        SkMatrix matrix(gc->platformContext()->getTotalMatrix());
+        matrix.preConcat(patternTransform);
+        static_cast<BitmapImage*>(this)->noteDrawnSize(drawnImageSize(matrix, size()));
+    }
+
     SkBitmapRef* image = this->nativeImageForCurrentFrame();
-    if (!image || destRect.isEmpty())
+    if (!image)
         return;
 
     // in case we get called with an incomplete bitmap
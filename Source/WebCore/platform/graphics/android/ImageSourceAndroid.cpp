@@ -41,6 +41,9 @@
 #include "SkStream.h"
 #include "SkTemplates.h"
 
+#include <algorithm>
+#include <math.h>
+
 #ifdef ANDROID_ANIMATED_GIF
     #include "EmojiFont.h"
     #include "GIFImageDecoder.h"
@@ -48,6 +51,12 @@
     using namespace android;
 #endif
 
+#ifdef ANDROID_PROGRESSIVE_IMAGE_DECODING
+    #include "JPEGImageDecoder.h"
+    #include "PNGImageDecoder.h"
+    #include "WEBPImageDecoder.h"
+#endif
+
 // TODO: We should make use of some of the common code in platform/graphics/ImageSource.cpp.
 
 //#define TRACE_SUBSAMPLE_BITMAPS
@@ -100,11 +109,17 @@ class PrivateAndroidImageSourceRec : public SkBitmapRef {
 public:
     PrivateAndroidImageSourceRec(const SkBitmap& bm, int origWidth,
                                  int origHeight, int sampleSize)
-            : SkBitmapRef(bm), fSampleSize(sampleSize), fAllDataReceived(false) {
+            : SkBitmapRef(bm), fSampleSize(sampleSize), fMinSampleSize(sampleSize),
+              fDrawnWidth(0), fDrawnHeight(0), fAllDataReceived(false) {
         this->setOrigSize(origWidth, origHeight);
     }
 
     int  fSampleSize;
+    // the smallest sample size that keeps the bitmap under the cache limit
+    int  fMinSampleSize;
+    // the largest size the image has been drawn at, 0 until it is drawn
+    int  fDrawnWidth;
+    int  fDrawnHeight;
     bool fAllDataReceived;
 };
 
@@ -118,6 +133,9 @@ ImageSource::ImageSource(AlphaOption alphaOption, GammaAndColorProfileOption gam
 #ifdef ANDROID_ANIMATED_GIF
     m_decoder.m_gifDecoder = 0;
 #endif
+#ifdef ANDROID_PROGRESSIVE_IMAGE_DECODING
+    m_decoder.m_progressiveDecoder = 0;
+#endif
 }
 
 ImageSource::~ImageSource() {
@@ -125,6 +143,9 @@ ImageSource::~ImageSource() {
 #ifdef ANDROID_ANIMATED_GIF
     delete m_decoder.m_gifDecoder;
 #endif
+#ifdef ANDROID_PROGRESSIVE_IMAGE_DECODING
+    delete m_decoder.m_progressiveDecoder;
+#endif
 }
 
 bool ImageSource::initialized() const {
@@ -155,6 +176,65 @@ static int computeSampleSize(const SkBitmap& bitmap) {
     return sampleSize;
 }
 
+// The page zoom, which is applied to the recorded content after it has been
+// drawn, so it is not part of the canvas matrix the drawn sizes come from.
+static float gDrawnSizeScale = 1;
+// Set once any image is decoded smaller than the cache limit allows, that is
+// at a size picked from how it was drawn.
+static bool gHasImagesDecodedAtDrawnSize = false;
+
+// Returns the largest sample size that still decodes the image at least as
+// big as it has been drawn.
+static int computeSampleSizeForDrawnSize(const PrivateAndroidImageSourceRec* decoder) {
+    int sampleSize = decoder->fMinSampleSize;
+    if (!decoder->fDrawnWidth || !decoder->fDrawnHeight)
+        return sampleSize;
+
+    while (decoder->origWidth() / (sampleSize << 1) >= decoder->fDrawnWidth &&
+           decoder->origHeight() / (sampleSize << 1) >= decoder->fDrawnHeight)
+        sampleSize <<= 1;
+    return sampleSize;
+}
+
+// Attaches a pixel ref that decodes the image at the given sample size when
+// its pixels are first locked. If the sample size changed, the bounds are
+// decoded again since the decoders round the sampled dimensions differently.
+static bool allocPixelRef(PrivateAndroidImageSourceRec* decoder, SharedBuffer* data,
+                          int sampleSize, const SkString& url) {
+    SkBitmap* bm = &decoder->bitmap();
+
+    if (sampleSize != decoder->fSampleSize) {
+        SkMemoryStream stream(data->data(), data->size(), false);
+        SkImageDecoder* codec = SkImageDecoder::Factory(&stream);
+        if (!codec)
+            return false;
+
+        SkAutoTDelete<SkImageDecoder> ad(codec);
+        codec->setPrefConfigTable(gPrefConfigTable);
+        codec->setSampleSize(sampleSize);
+        SkBitmap tmp;
+        if (!codec->decode(&stream, &tmp, SkImageDecoder::kDecodeBounds_Mode))
+            return false;
+
+        *bm = tmp;
+        decoder->fSampleSize = sampleSize;
+    }
+    if (sampleSize > decoder->fMinSampleSize)
+        gHasImagesDecodedAtDrawnSize = true;
+
+    BitmapAllocatorAndroid alloc(data, sampleSize);
+    if (!alloc.allocPixelRef(bm, NULL)) {
+        return false;
+    }
+    SkPixelRef* ref = bm->pixelRef();
+
+    // we promise to never change the pixels (makes picture recording fast)
+    ref->setImmutable();
+    // give it the URL if we have one
+    ref->setURI(url);
+    return true;
+}
+
 void ImageSource::clearURL() 
 {
     m_decoder.m_url.reset(); 
@@ -178,6 +258,26 @@ static bool should_use_animated_gif(int width, int height) {
 }
 #endif
 
+#ifdef ANDROID_PROGRESSIVE_IMAGE_DECODING
+// Returns a streaming decoder for the formats whose rows can be drawn before
+// the whole file has arrived, or 0 for anything else.
+static ImageDecoder* createProgressiveDecoder(SharedBuffer* data,
+        ImageSource::AlphaOption alphaOption,
+        ImageSource::GammaAndColorProfileOption gammaAndColorProfileOption) {
+    const char* contents = data->data();
+    size_t length = data->size();
+    if (length >= 4 && !memcmp(contents, "\x89\x50\x4E\x47", 4))
+        return new PNGImageDecoder(alphaOption, gammaAndColorProfileOption);
+    if (length >= 3 && !memcmp(contents, "\xFF\xD8\xFF", 3))
+        return new JPEGImageDecoder(alphaOption, gammaAndColorProfileOption);
+#if USE(WEBP)
+    if (length >= 14 && !memcmp(contents, "RIFF", 4) && !memcmp(contents + 8, "WEBPVP", 6))
+        return new WEBPImageDecoder(alphaOption, gammaAndColorProfileOption);
+#endif
+    return 0;
+}
+#endif
+
 void ImageSource::setData(SharedBuffer* data, bool allDataReceived)
 {
 #ifdef ANDROID_ANIMATED_GIF
@@ -256,22 +356,70 @@ void ImageSource::setData(SharedBuffer* data, bool allDataReceived)
     }
 
     PrivateAndroidImageSourceRec* decoder = m_decoder.m_image;
+#ifdef ANDROID_PROGRESSIVE_IMAGE_DECODING
+    if (decoder && !decoder->fAllDataReceived) {
+        if (allDataReceived) {
+            // The complete image is decoded below into a purgeable pixel ref,
+            // so the partially decoded copy is no longer needed.
+            delete m_decoder.m_progressiveDecoder;
+            m_decoder.m_progressiveDecoder = 0;
+        } else if (decoder->fSampleSize == 1) {
+            // Images that need subsampling are left blank until they are
+            // complete, the streaming decoders only decode at full size.
+            if (!m_decoder.m_progressiveDecoder)
+                m_decoder.m_progressiveDecoder = createProgressiveDecoder(data,
+                        m_alphaOption, m_gammaAndColorProfileOption);
+            // Decoding itself is deferred until the frame is drawn.
+            if (m_decoder.m_progressiveDecoder)
+                m_decoder.m_progressiveDecoder->setData(data, false);
+        }
+    }
+#endif
     if (allDataReceived && decoder && !decoder->fAllDataReceived) {
         decoder->fAllDataReceived = true;
+        allocPixelRef(decoder, data, computeSampleSizeForDrawnSize(decoder),
+                      m_decoder.m_url);
+    }
+}
 
-        SkBitmap* bm = &decoder->bitmap();
+void ImageSource::noteDrawnSize(const IntSize& drawnSize, SharedBuffer* data)
+{
+    PrivateAndroidImageSourceRec* decoder = m_decoder.m_image;
+    if (!decoder || !data || drawnSize.isEmpty())
+        return;
+    IntSize deviceSize(ceilf(drawnSize.width() * gDrawnSizeScale),
+                       ceilf(drawnSize.height() * gDrawnSizeScale));
+    if (deviceSize.width() <= decoder->fDrawnWidth
+            && deviceSize.height() <= decoder->fDrawnHeight)
+        return;
 
-        BitmapAllocatorAndroid alloc(data, decoder->fSampleSize);
-        if (!alloc.allocPixelRef(bm, NULL)) {
-            return;
-        }
-        SkPixelRef* ref = bm->pixelRef();
+    bool firstDraw = !decoder->fDrawnWidth;
+    decoder->fDrawnWidth = std::max(decoder->fDrawnWidth, deviceSize.width());
+    decoder->fDrawnHeight = std::max(decoder->fDrawnHeight, deviceSize.height());
 
-        // we promise to never change the pixels (makes picture recording fast)
-        ref->setImmutable();
-        // give it the URL if we have one
-        ref->setURI(m_decoder.m_url);
-    }
+    // Until all the data is here the drawn size is only recorded, and used
+    // when the pixel ref is attached in setData().
+    if (!decoder->fAllDataReceived)
+        return;
+
+    // The pixel ref attached before the first draw has most likely not been
+    // decoded yet, so it can be swapped for a smaller one for free. After
+    // that only decode again if the image is now drawn larger.
+    int sampleSize = computeSampleSizeForDrawnSize(decoder);
+    if (sampleSize < decoder->fSampleSize
+            || (firstDraw && sampleSize != decoder->fSampleSize))
+        allocPixelRef(decoder, data, sampleSize, m_decoder.m_url);
+}
+
+bool ImageSource::setDrawnSizeScale(float scale)
+{
+    if (scale <= 0)
+        return false;
+    bool grew = scale > gDrawnSizeScale;
+    gDrawnSizeScale = scale;
+    // Images are only decoded again when they are next drawn, which needs
+    // the content to be recorded again.
+    return grew && gHasImagesDecodedAtDrawnSize;
 }
 
 bool ImageSource::isSizeAvailable()
@@ -337,6 +485,23 @@ SkBitmapRef* ImageSource::createFrameAtIndex(size_t index)
     SkASSERT(index == 0);
 #endif
     SkASSERT(m_decoder.m_image != NULL);
+#ifdef ANDROID_PROGRESSIVE_IMAGE_DECODING
+    if (m_decoder.m_progressiveDecoder) {
+        // Hand out the rows decoded so far. The pixel ref is not immutable,
+        // so anything recording it takes a snapshot of the current rows, and
+        // BitmapImage asks for a new frame each time more data arrives.
+        ImageFrame* buffer =
+                m_decoder.m_progressiveDecoder->frameBufferAtIndex(0);
+        if (buffer && buffer->status() != ImageFrame::FrameEmpty
+                && !m_decoder.m_progressiveDecoder->failed()) {
+            SkBitmap& bitmap = buffer->bitmap();
+            SkPixelRef* pixelRef = bitmap.pixelRef();
+            if (pixelRef)
+                pixelRef->setURI(m_decoder.m_url);
+            return new SkBitmapRef(bitmap);
+        }
+    }
+#endif
     m_decoder.m_image->ref();
     return m_decoder.m_image;
 }
@@ -408,6 +573,14 @@ bool ImageSource::frameIsCompleteAtIndex(size_t index)
 
 void ImageSource::clear(bool destroyAll, size_t clearBeforeFrame, SharedBuffer* data, bool allDataReceived)
 {
+#ifdef ANDROID_PROGRESSIVE_IMAGE_DECODING
+    // Drop the partially decoded rows; the decoder is recreated from the
+    // buffered data when the next chunk arrives.
+    if (destroyAll) {
+        delete m_decoder.m_progressiveDecoder;
+        m_decoder.m_progressiveDecoder = 0;
+    }
+#endif
 #ifdef ANDROID_ANIMATED_GIF
     if (!destroyAll) {
         if (m_decoder.m_gifDecoder)
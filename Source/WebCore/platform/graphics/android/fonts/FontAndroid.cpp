@@ -53,10 +53,14 @@
 #include "HarfbuzzSkia.h"
 #include <unicode/normlzr.h>
 #include <unicode/uchar.h>
+#include <wtf/HashMap.h>
 #include <wtf/OwnArrayPtr.h>
 #include <wtf/OwnPtr.h>
 #include <wtf/PassOwnArrayPtr.h>
 #include <wtf/PassOwnPtr.h>
+#include <wtf/StringHasher.h>
+#include <wtf/Vector.h>
+#include <wtf/text/WTFString.h>
 #include <wtf/unicode/CharacterNames.h>
 #include <wtf/unicode/Unicode.h>
 #endif
@@ -404,6 +408,143 @@ static int truncateFixedPointToInteger(HB_Fixed value)
     return value >> 6;
 }
 
+// The output of HB_ShapeItem() for one script run. Word and letter spacing,
+// justification and the starting position are applied afterwards by
+// TextRunWalker::setGlyphPositions(), so they are not part of the key and
+// layout, paint and selection of the same text can all share one entry.
+struct ShapeResult {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    Vector<HB_Glyph> glyphs;
+    Vector<HB_Fixed> advances;
+    Vector<HB_FixedPoint> offsets;
+    Vector<unsigned short> logClusters;
+};
+
+struct ShapeCacheKey {
+    ShapeCacheKey()
+        : m_platformData(0)
+        , m_script(HB_Script_Common)
+        , m_bidiLevel(0)
+    {
+    }
+
+    // |platformData| comes from the fallback table in
+    // TextRunWalker::setupComplexFont(), which is never freed, so the pointer
+    // identifies the font for as long as the cache lives.
+    ShapeCacheKey(const UChar* characters, unsigned length, const FontPlatformData* platformData, HB_Script script, unsigned bidiLevel)
+        : m_text(characters, length)
+        , m_platformData(platformData)
+        , m_script(script)
+        , m_bidiLevel(bidiLevel)
+    {
+    }
+
+    ShapeCacheKey(WTF::HashTableDeletedValueType) : m_platformData(hashTableDeletedPlatformData()) { }
+    bool isHashTableDeletedValue() const { return m_platformData == hashTableDeletedPlatformData(); }
+
+    bool operator==(const ShapeCacheKey& other) const
+    {
+        return m_platformData == other.m_platformData && m_script == other.m_script
+            && m_bidiLevel == other.m_bidiLevel && m_text == other.m_text;
+    }
+
+    String m_text;
+    const FontPlatformData* m_platformData;
+    HB_Script m_script;
+    unsigned m_bidiLevel;
+
+private:
+    static const FontPlatformData* hashTableDeletedPlatformData() { return reinterpret_cast<const FontPlatformData*>(-1); }
+};
+
+struct ShapeCacheKeyHash {
+    static unsigned hash(const ShapeCacheKey& key)
+    {
+        unsigned hashCodes[3] = {
+            key.m_text.impl() ? key.m_text.impl()->hash() : 0,
+            PtrHash<const FontPlatformData*>::hash(key.m_platformData),
+            static_cast<unsigned>(key.m_script) << 1 | (key.m_bidiLevel & 1)
+        };
+        return StringHasher::hashMemory<sizeof(hashCodes)>(hashCodes);
+    }
+
+    static bool equal(const ShapeCacheKey& a, const ShapeCacheKey& b)
+    {
+        return a == b;
+    }
+
+    static const bool safeToCompareToEmptyOrDeleted = true;
+};
+
+struct ShapeCacheKeyTraits : WTF::SimpleClassHashTraits<ShapeCacheKey> { };
+
+// Remembers the shaping of recently seen script runs so that measuring,
+// drawing and hit testing the same text does not run HarfBuzz each time.
+// The cache is simply emptied when it fills up.
+class ShapeCache {
+public:
+    ShapeCache()
+        : m_hits(0)
+        , m_misses(0)
+    {
+    }
+
+    const ShapeResult* get(const ShapeCacheKey& key)
+    {
+        const ShapeResult* result = m_results.get(key);
+        if (result)
+            ++m_hits;
+        else
+            ++m_misses;
+        return result;
+    }
+
+    void add(const ShapeCacheKey& key, const HB_ShaperItem& item)
+    {
+        if (key.m_text.length() > maximumCachedRunLength)
+            return;
+
+        if (m_results.size() >= maximumEntries) {
+            ALOGV("Clearing shape cache: %u hits, %u misses", m_hits, m_misses);
+            clear();
+        }
+
+        ShapeResult* result = new ShapeResult;
+        result->glyphs.append(item.glyphs, item.num_glyphs);
+        result->advances.append(item.advances, item.num_glyphs);
+        result->offsets.append(item.offsets, item.num_glyphs);
+        result->logClusters.append(item.log_clusters, item.item.length);
+
+        if (!m_results.add(key, result).second)
+            delete result;
+    }
+
+    void clear()
+    {
+        deleteAllValues(m_results);
+        m_results.clear();
+    }
+
+    unsigned hits() const { return m_hits; }
+    unsigned misses() const { return m_misses; }
+
+private:
+    static const unsigned maximumEntries = 2048;
+    static const unsigned maximumCachedRunLength = 256;
+
+    typedef HashMap<ShapeCacheKey, ShapeResult*, ShapeCacheKeyHash, ShapeCacheKeyTraits> ShapeResultMap;
+    ShapeResultMap m_results;
+    unsigned m_hits;
+    unsigned m_misses;
+};
+
+static ShapeCache& shapeCache()
+{
+    DEFINE_STATIC_LOCAL(ShapeCache, cache, ());
+    return cache;
+}
+
 // TextRunWalker walks a TextRun and presents each script run in sequence. A
 // TextRun is a sequence of code-points with the same embedding level (i.e. they
 // are all left-to-right or right-to-left). A script run is a subsequence where
@@ -794,6 +935,22 @@ void TextRunWalker::resetGlyphArrays()
 
 void TextRunWalker::shapeGlyphs()
 {
+    ShapeCacheKey key(m_item.string + m_item.item.pos, m_item.item.length,
+        fontPlatformDataForScriptRun(), m_item.item.script, m_item.item.bidiLevel);
+    if (const ShapeResult* result = shapeCache().get(key)) {
+        unsigned numGlyphs = result->glyphs.size();
+        if (numGlyphs > m_glyphsArrayCapacity) {
+            deleteGlyphArrays();
+            createGlyphArrays(numGlyphs);
+        }
+        m_item.num_glyphs = numGlyphs;
+        memcpy(m_item.glyphs, result->glyphs.data(), numGlyphs * sizeof(m_item.glyphs[0]));
+        memcpy(m_item.advances, result->advances.data(), numGlyphs * sizeof(m_item.advances[0]));
+        memcpy(m_item.offsets, result->offsets.data(), numGlyphs * sizeof(m_item.offsets[0]));
+        memcpy(m_item.log_clusters, result->logClusters.data(), result->logClusters.size() * sizeof(m_item.log_clusters[0]));
+        return;
+    }
+
     // HB_ShapeItem() resets m_item.num_glyphs. If the previous call to
     // HB_ShapeItem() used less space than was available, the capacity of
     // the array may be larger than the current value of m_item.num_glyphs.
@@ -807,6 +964,8 @@ void TextRunWalker::shapeGlyphs()
         createGlyphArrays(m_item.num_glyphs << 1);
         resetGlyphArrays();
     }
+
+    shapeCache().add(key, m_item);
 }
 
 void TextRunWalker::setGlyphPositions(bool isRTL)
@@ -172,12 +172,7 @@ LayerAndroid::LayerAndroid(const LayerAndroid& layer) : Layer(layer),
         addChild(layer.getChild(i)->copy())->unref();
 #endif
 
-    KeyframesMap::const_iterator end = layer.m_animations.end();
-    for (KeyframesMap::const_iterator it = layer.m_animations.begin(); it != end; ++it) {
-        // Deep copy the key's string, to avoid cross-thread refptr use
-        pair<String, int> newKey(it->first.first.threadsafeCopy(), it->first.second);
-        m_animations.add(newKey, it->second);
-    }
+    m_animations = layer.m_animations;
 
     if (layer.m_replicatedLayer) {
         // The replicated layer is always the first child
@@ -204,7 +199,6 @@ LayerAndroid::~LayerAndroid()
     SkSafeUnref(m_maskLayer);
     SkSafeUnref(m_content);
     // Don't unref m_surface, owned by BaseLayerAndroid
-    m_animations.clear();
 #ifdef DEBUG_COUNT
     ClassTracker::instance()->remove(this);
     if (m_type == LayerAndroid::WebCoreLayer)
@@ -234,7 +228,7 @@ bool LayerAndroid::hasAnimations() const
         if (getChild(i)->hasAnimations())
             return true;
     }
-    return !!m_animations.size();
+    return !!animationCount();
 }
 
 bool LayerAndroid::evaluateAnimations(double time)
@@ -246,9 +240,11 @@ bool LayerAndroid::evaluateAnimations(double time)
     }
 
     m_hasRunningAnimations = false;
+    if (!m_animations)
+        return hasRunningAnimations;
     int nbAnims = 0;
-    KeyframesMap::const_iterator end = m_animations.end();
-    for (KeyframesMap::const_iterator it = m_animations.begin(); it != end; ++it) {
+    KeyframesMap::const_iterator end = m_animations->map.end();
+    for (KeyframesMap::const_iterator it = m_animations->map.begin(); it != end; ++it) {
         gDebugNbAnims++;
         nbAnims++;
         LayerAndroid* currentLayer = const_cast<LayerAndroid*>(this);
@@ -263,8 +259,10 @@ void LayerAndroid::initAnimations() {
     for (int i = 0; i < countChildren(); i++)
         getChild(i)->initAnimations();
 
-    KeyframesMap::const_iterator localBegin = m_animations.begin();
-    KeyframesMap::const_iterator localEnd = m_animations.end();
+    if (!m_animations)
+        return;
+    KeyframesMap::const_iterator localBegin = m_animations->map.begin();
+    KeyframesMap::const_iterator localEnd = m_animations->map.end();
     for (KeyframesMap::const_iterator localIt = localBegin; localIt != localEnd; ++localIt)
         (localIt->second)->suggestBeginTime(WTF::currentTime());
 }
@@ -302,33 +300,75 @@ void LayerAndroid::addAnimation(PassRefPtr<AndroidAnimation> prpAnim)
     RefPtr<AndroidAnimation> anim = prpAnim;
     pair<String, int> key(anim->nameCopy(), anim->type());
     removeAnimationsForProperty(anim->type());
-    m_animations.add(key, anim);
+    mutableAnimations().add(key, anim);
+}
+
+LayerAndroid::KeyframesMap& LayerAndroid::mutableAnimations()
+{
+    if (!m_animations)
+        m_animations = adoptRef(new SharedKeyframes);
+    else if (!m_animations->hasOneRef()) {
+        // A UI copy still uses the current animations, give this layer its own
+        RefPtr<SharedKeyframes> animations = adoptRef(new SharedKeyframes);
+        KeyframesMap::const_iterator end = m_animations->map.end();
+        for (KeyframesMap::const_iterator it = m_animations->map.begin(); it != end; ++it) {
+            // Deep copy the key's string, to avoid cross-thread refptr use
+            pair<String, int> newKey(it->first.first.threadsafeCopy(), it->first.second);
+            animations->map.add(newKey, it->second);
+        }
+        m_animations = animations.release();
+    }
+    return m_animations->map;
 }
 
 void LayerAndroid::removeAnimationsForProperty(AnimatedPropertyID property)
 {
-    KeyframesMap::const_iterator end = m_animations.end();
+    if (!m_animations)
+        return;
+
+    // Look before getting the animations for writing, so that a UI copy keeps
+    // sharing them if nothing is removed.
+    bool found = false;
+    KeyframesMap::const_iterator sharedEnd = m_animations->map.end();
+    for (KeyframesMap::const_iterator it = m_animations->map.begin(); !found && it != sharedEnd; ++it)
+        found = (it->second)->type() == property;
+    if (!found)
+        return;
+
+    KeyframesMap& animations = mutableAnimations();
+    KeyframesMap::const_iterator end = animations.end();
     Vector<pair<String, int> > toDelete;
-    for (KeyframesMap::const_iterator it = m_animations.begin(); it != end; ++it) {
+    for (KeyframesMap::const_iterator it = animations.begin(); it != end; ++it) {
         if ((it->second)->type() == property)
             toDelete.append(it->first);
     }
 
     for (unsigned int i = 0; i < toDelete.size(); i++)
-        m_animations.remove(toDelete[i]);
+        animations.remove(toDelete[i]);
 }
 
 void LayerAndroid::removeAnimationsForKeyframes(const String& name)
 {
-    KeyframesMap::const_iterator end = m_animations.end();
+    if (!m_animations)
+        return;
+
+    bool found = false;
+    KeyframesMap::const_iterator sharedEnd = m_animations->map.end();
+    for (KeyframesMap::const_iterator it = m_animations->map.begin(); !found && it != sharedEnd; ++it)
+        found = (it->second)->isNamed(name);
+    if (!found)
+        return;
+
+    KeyframesMap& animations = mutableAnimations();
+    KeyframesMap::const_iterator end = animations.end();
     Vector<pair<String, int> > toDelete;
-    for (KeyframesMap::const_iterator it = m_animations.begin(); it != end; ++it) {
+    for (KeyframesMap::const_iterator it = animations.begin(); it != end; ++it) {
         if ((it->second)->isNamed(name))
             toDelete.append(it->first);
     }
 
     for (unsigned int i = 0; i < toDelete.size(); i++)
-        m_animations.remove(toDelete[i]);
+        animations.remove(toDelete[i]);
 }
 
 // We only use the bounding rect of the layer as mask...
@@ -624,13 +664,42 @@ void LayerAndroid::showLayer(int indent)
         this->getChild(i)->showLayer(indent + 2);
 }
 
+// The base layer's id is 0, which HashMap<int> reserves for empty buckets,
+// so layers are indexed by their id plus one.
+static inline int layerIdKey(int uniqueId)
+{
+    return uniqueId + 1;
+}
+
+static void addLayersById(LayerAndroid* layer, HashMap<int, LayerAndroid*>& layers)
+{
+    // Keep the first layer with a given id, as findById() would
+    layers.add(layerIdKey(layer->uniqueId()), layer);
+    int count = layer->countChildren();
+    for (int i = 0; i < count; i++)
+        addLayersById(layer->getChild(i), layers);
+}
+
 void LayerAndroid::mergeInvalsInto(LayerAndroid* replacementTree)
+{
+    HashMap<int, LayerAndroid*> replacementLayers;
+    mergeInvalsInto(replacementTree, replacementLayers);
+}
+
+void LayerAndroid::mergeInvalsInto(LayerAndroid* replacementTree, HashMap<int, LayerAndroid*>& replacementLayers)
 {
     int count = this->countChildren();
     for (int i = 0; i < count; i++)
-        this->getChild(i)->mergeInvalsInto(replacementTree);
+        this->getChild(i)->mergeInvalsInto(replacementTree, replacementLayers);
+
+    if (m_dirtyRegion.isEmpty())
+        return;
 
-    LayerAndroid* replacementLayer = replacementTree->findById(uniqueId());
+    // Only index the replacement tree once something needs to be merged,
+    // rather than searching it for every layer.
+    if (replacementLayers.isEmpty())
+        addLayersById(replacementTree, replacementLayers);
+    LayerAndroid* replacementLayer = replacementLayers.get(layerIdKey(uniqueId()));
     if (replacementLayer)
         replacementLayer->markAsDirty(m_dirtyRegion);
 }
@@ -683,7 +752,7 @@ void LayerAndroid::assignSurfaces(LayerMergeState* mergeState)
           4*mergeState->depth, "", this, m_uniqueId, m_owningLayer,
           needNewSurface ? "NEW" : "joins", mergeState->currentSurface,
           mergeState->nonMergeNestedLevel,
-          isPositionFixed(), m_animations.size() != 0,
+          isPositionFixed(), animationCount() != 0,
           m_intrinsicallyComposited,
           m_haveClip,
           contentIsScrollable(), m_content ? m_content->hasText() : -1,
@@ -35,6 +35,7 @@
 
 #include <utils/threads.h>
 #include <wtf/HashMap.h>
+#include <wtf/ThreadSafeRefCounted.h>
 
 #ifndef BZERO_DEFINED
 #define BZERO_DEFINED
@@ -277,7 +278,7 @@ public:
     void setIntrinsicallyComposited(bool intCom) { m_intrinsicallyComposited = intCom; }
     virtual bool needsIsolatedSurface() {
         return (needsTexture() && m_intrinsicallyComposited)
-            || m_animations.size()
+            || animationCount()
             || m_imageCRC;
     }
 
@@ -312,7 +313,7 @@ private:
     void updateLocalTransformAndClip(const TransformationMatrix& parentMatrix,
                                      const FloatRect& clip);
     bool hasDynamicTransform() {
-        return contentIsScrollable() || isPositionFixed() || (m_animations.size() != 0);
+        return contentIsScrollable() || isPositionFixed() || (animationCount() != 0);
     }
 
     // recurse through the current 3d rendering context, adding layers in the context to the vector
@@ -350,7 +351,22 @@ protected:
 private:
 
     typedef HashMap<pair<String, int>, RefPtr<AndroidAnimation> > KeyframesMap;
-    KeyframesMap m_animations;
+
+    // The animations are shared by refcount between a layer and its UI copies,
+    // and copied again only when the WebKit side changes them. The keys are
+    // only referenced by the map that owns them, so it can be released on
+    // either thread. The layer nodes themselves are still copied for every
+    // UI snapshot, see WebViewCore::createBaseLayer().
+    struct SharedKeyframes : public ThreadSafeRefCounted<SharedKeyframes> {
+        KeyframesMap map;
+    };
+
+    unsigned animationCount() const { return m_animations ? m_animations->map.size() : 0; }
+    KeyframesMap& mutableAnimations();
+
+    void mergeInvalsInto(LayerAndroid* replacementTree, HashMap<int, LayerAndroid*>& replacementLayers);
+
+    RefPtr<SharedKeyframes> m_animations;
 
     TransformationMatrix m_transform;
     TransformationMatrix m_childrenTransform;
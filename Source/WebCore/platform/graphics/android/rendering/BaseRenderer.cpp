@@ -39,7 +39,9 @@
 #include "SkBitmapRef.h"
 #include "SkCanvas.h"
 #include "SkDevice.h"
+#include "SkDrawFilter.h"
 #include "SkPicture.h"
+#include "SkShader.h"
 #include "SkTypeface.h"
 #include "Tile.h"
 #include "TilesManager.h"
@@ -53,6 +55,18 @@ namespace WebCore {
 
 BaseRenderer::RendererType BaseRenderer::g_currentType = BaseRenderer::Raster;
 
+// Skips bitmaps and bitmap patterns, leaving the tile background in their place
+class SkipImagesDrawFilter : public SkDrawFilter {
+public:
+    virtual bool filter(SkPaint* paint, Type type)
+    {
+        if (type == kBitmap_Type)
+            return false;
+        SkShader* shader = paint->getShader();
+        return !shader || shader->asABitmap(0, 0, 0) != SkShader::kDefault_BitmapType;
+    }
+};
+
 BaseRenderer* BaseRenderer::createRenderer()
 {
     if (g_currentType == Raster)
@@ -97,6 +111,8 @@ void BaseRenderer::renderTiledContent(TileRenderInfo& renderInfo)
                                       TilesManager::instance()->tileHeight(),
                                       background ? *background : Color::transparent);
     setupCanvas(renderInfo, &canvas);
+    if (renderInfo.skipImages)
+        canvas.setDrawFilter(new SkipImagesDrawFilter())->unref();
 
     if (!canvas.getDevice()) {
         // TODO: consider ALOGE
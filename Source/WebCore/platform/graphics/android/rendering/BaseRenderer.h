@@ -64,6 +64,9 @@ struct TileRenderInfo {
 
     bool isPureColor;
     Color pureColor;
+
+    // the images drawn by the tile are still being decoded, leave them out
+    bool skipImages;
 };
 
 /**
@@ -0,0 +1,298 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define LOG_TAG "ImagePredecoder"
+#define LOG_NDEBUG 1
+
+#include "config.h"
+#include "ImagePredecoder.h"
+
+#if USE(ACCELERATED_COMPOSITING)
+
+#include "AndroidLog.h"
+#include "SkCanvas.h"
+#include "SkDevice.h"
+#include "SkPixelRef.h"
+#include "SkShader.h"
+#include "TexturesGenerator.h"
+#include "Tile.h"
+#include "TilePainter.h"
+#include "TilesManager.h"
+
+#include <cutils/atomic.h>
+
+// Decoding is mostly limited by the CPU, so a couple of threads is enough to
+// keep the TexturesGenerator from waiting on a single large image.
+#define NUM_IMAGE_DECODE_THREADS 2
+
+// How many decoded images are remembered, so that tiles drawing them are not
+// held back again. Images purged from the cache since are decoded while
+// painting, as they were before predecoding.
+#define MAX_DECODED_IMAGES 1024
+
+namespace WebCore {
+
+// A canvas that draws nothing, and only remembers the pixel refs of the
+// bitmaps drawn into it that do not have their pixels in memory yet.
+class ImageCollectingCanvas : public SkCanvas {
+public:
+    ImageCollectingCanvas(int width, int height)
+    {
+        SkBitmap bitmap;
+        bitmap.setConfig(SkBitmap::kNo_Config, width, height);
+        setDevice(new SkDevice(bitmap))->unref();
+    }
+
+    const Vector<SkPixelRef*>& pixelRefs() const { return m_pixelRefs; }
+
+    // overrides from SkCanvas
+    virtual int saveLayer(const SkRect* bounds, const SkPaint* paint, SaveFlags flags)
+    {
+        // no need for an offscreen, nothing is drawn
+        return save(flags);
+    }
+
+    virtual void clear(SkColor color) { }
+    virtual void drawPaint(const SkPaint& paint) { addShader(paint); }
+    virtual void drawPoints(PointMode mode, size_t count, const SkPoint pts[],
+            const SkPaint& paint) { }
+    virtual void drawRect(const SkRect& rect, const SkPaint& paint) { addShader(paint); }
+    virtual void drawPath(const SkPath& path, const SkPaint& paint) { addShader(paint); }
+
+    virtual void drawBitmap(const SkBitmap& bitmap, SkScalar left,
+            SkScalar top, const SkPaint* paint)
+    {
+        addBitmap(bitmap);
+    }
+
+    virtual void drawBitmapRectToRect(const SkBitmap& bitmap, const SkRect* src,
+            const SkRect& dst, const SkPaint* paint)
+    {
+        addBitmap(bitmap);
+    }
+
+    virtual void drawBitmapMatrix(const SkBitmap& bitmap,
+            const SkMatrix& matrix, const SkPaint* paint)
+    {
+        addBitmap(bitmap);
+    }
+
+    virtual void drawBitmapNine(const SkBitmap& bitmap, const SkIRect& center,
+                                const SkRect& dst, const SkPaint* paint = 0)
+    {
+        addBitmap(bitmap);
+    }
+
+    virtual void drawSprite(const SkBitmap& bitmap, int left, int top,
+            const SkPaint* paint)
+    {
+        addBitmap(bitmap);
+    }
+
+    virtual void drawText(const void* text, size_t byteLength, SkScalar x,
+            SkScalar y, const SkPaint& paint) { }
+    virtual void drawPosText(const void* text, size_t byteLength,
+            const SkPoint pos[], const SkPaint& paint) { }
+    virtual void drawPosTextH(const void* text, size_t byteLength,
+            const SkScalar xpos[], SkScalar constY, const SkPaint& paint) { }
+    virtual void drawTextOnPath(const void* text, size_t byteLength,
+            const SkPath& path, const SkMatrix* matrix, const SkPaint& paint) { }
+    virtual void drawVertices(VertexMode mode, int vertexCount,
+            const SkPoint vertices[], const SkPoint texs[],
+            const SkColor colors[], SkXfermode* xfermode,
+            const uint16_t indices[], int indexCount, const SkPaint& paint) { }
+    virtual void drawData(const void* data, size_t length) { }
+
+private:
+    void addShader(const SkPaint& paint)
+    {
+        // bitmap patterns are drawn as a rect with a bitmap shader
+        SkShader* shader = paint.getShader();
+        SkBitmap bitmap;
+        if (shader && shader->asABitmap(&bitmap, 0, 0) == SkShader::kDefault_BitmapType)
+            addBitmap(bitmap);
+    }
+
+    void addBitmap(const SkBitmap& bitmap)
+    {
+        SkPixelRef* pixelRef = bitmap.pixelRef();
+        if (!pixelRef || bitmap.getPixels() || m_seen.contains(pixelRef))
+            return;
+        m_seen.add(pixelRef);
+        m_pixelRefs.append(pixelRef);
+    }
+
+    HashSet<SkPixelRef*> m_seen;
+    Vector<SkPixelRef*> m_pixelRefs;
+};
+
+class ImageDecodeThread : public android::Thread {
+public:
+    ImageDecodeThread(ImagePredecoder* predecoder)
+        : Thread(false)
+        , m_predecoder(predecoder)
+    {
+    }
+
+private:
+    virtual bool threadLoop()
+    {
+        m_predecoder->decodeNext();
+        return true;
+    }
+
+    ImagePredecoder* m_predecoder;
+};
+
+ImageDecodeBatch::ImageDecodeBatch(TexturesGenerator* generator, int count)
+    : m_generator(generator)
+    , m_pending(count)
+{
+}
+
+ImageDecodeBatch::~ImageDecodeBatch()
+{
+}
+
+void ImageDecodeBatch::decodeFinished()
+{
+    // android_atomic_dec returns the previous value
+    if (android_atomic_dec(&m_pending) == 1)
+        m_generator->imagesDecoded();
+}
+
+ImagePredecoder* ImagePredecoder::gInstance = 0;
+
+ImagePredecoder* ImagePredecoder::instance()
+{
+    if (!gInstance)
+        gInstance = new ImagePredecoder();
+
+    return gInstance;
+}
+
+ImagePredecoder::ImagePredecoder()
+{
+    for (int i = 0; i < NUM_IMAGE_DECODE_THREADS; i++) {
+        android::sp<ImageDecodeThread> thread = new ImageDecodeThread(this);
+        thread->run("ImageDecodeThread", android::PRIORITY_BACKGROUND);
+        m_threads.append(thread);
+    }
+}
+
+ImageDecodeBatch* ImagePredecoder::predecode(Tile* tile, TilePainter* painter,
+                                             TexturesGenerator* generator)
+{
+    TRACE_METHOD();
+
+    // Walk the tile's content the same way BaseRenderer::renderTiledContent
+    // paints it, without rasterizing anything.
+    const int tileWidth = TilesManager::instance()->tileWidth();
+    const int tileHeight = TilesManager::instance()->tileHeight();
+    ImageCollectingCanvas canvas(tileWidth, tileHeight);
+    canvas.translate(-tile->x() * tileWidth, -tile->y() * tileHeight);
+    canvas.scale(tile->scale(), tile->scale());
+    painter->paint(&canvas);
+
+    const Vector<SkPixelRef*>& pixelRefs = canvas.pixelRefs();
+    if (pixelRefs.isEmpty())
+        return 0;
+
+    ImageDecodeBatch* batch = 0;
+    {
+        android::Mutex::Autolock lock(m_requestsLock);
+        Vector<SkPixelRef*> pending;
+        for (size_t i = 0; i < pixelRefs.size(); i++) {
+            if (!isDecoded(pixelRefs[i]))
+                pending.append(pixelRefs[i]);
+        }
+        if (pending.isEmpty())
+            return 0;
+
+        ALOGV("tile %p (%d, %d) waits for %d images", tile, tile->x(), tile->y(),
+              pending.size());
+
+        batch = new ImageDecodeBatch(generator, pending.size());
+        for (size_t i = 0; i < pending.size(); i++) {
+            DecodeRequest request;
+            request.pixelRef = pending[i];
+            request.batch = batch;
+            request.pixelRef->ref();
+            request.batch->ref();
+            m_requests.append(request);
+        }
+    }
+    m_requestsCond.broadcast();
+    return batch;
+}
+
+// Must be called from within a lock!
+bool ImagePredecoder::isDecoded(SkPixelRef* pixelRef)
+{
+    return m_decodedImages.contains(pixelRef->getGenerationID());
+}
+
+// Must be called from within a lock!
+void ImagePredecoder::setDecoded(SkPixelRef* pixelRef)
+{
+    if (!m_decodedImages.add(pixelRef->getGenerationID()).second)
+        return;
+    m_decodedImagesOrder.append(pixelRef->getGenerationID());
+    if (m_decodedImagesOrder.size() > MAX_DECODED_IMAGES)
+        m_decodedImages.remove(m_decodedImagesOrder.takeFirst());
+}
+
+void ImagePredecoder::decodeNext()
+{
+    DecodeRequest request;
+    bool decoded;
+    {
+        android::Mutex::Autolock lock(m_requestsLock);
+        while (m_requests.isEmpty())
+            m_requestsCond.wait(m_requestsLock);
+        request = m_requests.takeFirst();
+        // another tile may have queued the same image
+        decoded = isDecoded(request.pixelRef);
+    }
+
+    // Locking the pixels decodes them. Once unlocked they stay in the ashmem
+    // or global pool cache until memory is needed, so the tile that draws
+    // them only has to lock them again.
+    if (!decoded) {
+        request.pixelRef->lockPixels();
+        request.pixelRef->unlockPixels();
+
+        android::Mutex::Autolock lock(m_requestsLock);
+        setDecoded(request.pixelRef);
+    }
+
+    request.pixelRef->unref();
+    request.batch->decodeFinished();
+    request.batch->unref();
+}
+
+} // namespace WebCore
+
+#endif // USE(ACCELERATED_COMPOSITING)
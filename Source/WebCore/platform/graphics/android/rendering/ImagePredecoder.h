@@ -0,0 +1,108 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ImagePredecoder_h
+#define ImagePredecoder_h
+
+#if USE(ACCELERATED_COMPOSITING)
+
+#include "SkRefCnt.h"
+#include <wtf/Deque.h>
+#include <wtf/HashSet.h>
+#include <wtf/Vector.h>
+
+#include <utils/threads.h>
+
+class SkPixelRef;
+
+namespace WebCore {
+
+class ImageDecodeThread;
+class TexturesGenerator;
+class Tile;
+class TilePainter;
+
+// Counts the image decodes queued for one tile, and wakes up the
+// TexturesGenerator that owns the tile once they are all done.
+class ImageDecodeBatch : public SkRefCnt {
+public:
+    ImageDecodeBatch(TexturesGenerator* generator, int count);
+    virtual ~ImageDecodeBatch();
+
+    bool isDone() const { return m_pending <= 0; }
+
+    // Called on a decode thread
+    void decodeFinished();
+
+private:
+    android::sp<TexturesGenerator> m_generator;
+    volatile int32_t m_pending;
+};
+
+// Images recorded with a BitmapAllocatorAndroid pixel ref are only decoded
+// when their pixels are first locked, which otherwise happens in the middle
+// of painting a tile. The ImagePredecoder finds the images a tile draws and
+// decodes them on its own threads, so that the TexturesGenerator can paint
+// other tiles in the meantime.
+class ImagePredecoder {
+public:
+    static ImagePredecoder* instance();
+
+    // Called on a TexturesGenerator thread. Queues the images drawn by the
+    // tile that were not decoded yet and returns the batch tracking them, or
+    // 0 if the tile does not draw any image that needs decoding.
+    ImageDecodeBatch* predecode(Tile* tile, TilePainter* painter,
+                                TexturesGenerator* generator);
+
+    // Called by the decode threads, blocks until there is something to decode
+    void decodeNext();
+
+private:
+    ImagePredecoder();
+
+    struct DecodeRequest {
+        SkPixelRef* pixelRef;
+        ImageDecodeBatch* batch;
+    };
+
+    bool isDecoded(SkPixelRef* pixelRef);
+    void setDecoded(SkPixelRef* pixelRef);
+
+    static ImagePredecoder* gInstance;
+
+    android::Mutex m_requestsLock;
+    android::Condition m_requestsCond;
+    Deque<DecodeRequest> m_requests;
+
+    // generation IDs of the most recently decoded pixel refs, oldest first
+    HashSet<uint32_t> m_decodedImages;
+    Deque<uint32_t> m_decodedImagesOrder;
+    Vector<android::sp<ImageDecodeThread> > m_threads;
+};
+
+} // namespace WebCore
+
+#endif // USE(ACCELERATED_COMPOSITING)
+#endif // ImagePredecoder_h
@@ -32,12 +32,17 @@
 #include "AndroidLog.h"
 #include "ClassTracker.h"
 #include "GLWebViewState.h"
+#include "ImagePredecoder.h"
 #include "ImageTexture.h"
 #include "ImagesManager.h"
 #include "LayerAndroid.h"
 #include "TexturesGenerator.h"
 #include "TilesManager.h"
 
+// How long a tile waits for the images it draws to be decoded before it is
+// painted without them. It is painted again once they are decoded.
+#define IMAGE_DECODE_DEADLINE_NSECS 50000000
+
 namespace WebCore {
 
 PaintTileOperation::PaintTileOperation(Tile* tile, TilePainter* painter,
@@ -46,6 +51,9 @@ PaintTileOperation::PaintTileOperation(Tile* tile, TilePainter* painter,
     , m_painter(painter)
     , m_state(state)
     , m_isLowResPrefetch(isLowResPrefetch)
+    , m_imageDecodes(0)
+    , m_prepared(false)
+    , m_imageDecodeDeadline(0)
 {
     if (m_tile)
         m_tile->setRepaintPending(true);
@@ -68,6 +76,7 @@ PaintTileOperation::~PaintTileOperation()
     } else {
         SkSafeUnref(m_painter);
     }
+    SkSafeUnref(m_imageDecodes);
 #ifdef DEBUG_COUNT
     ClassTracker::instance()->decrement("PaintTileOperation");
 #endif
@@ -84,7 +93,9 @@ void PaintTileOperation::run(BaseRenderer* renderer)
     TRACE_METHOD();
 
     if (m_tile) {
-        m_tile->paintBitmap(m_painter, renderer);
+        // past the deadline, leave out the images rather than decoding them here
+        bool skipImages = m_imageDecodes && !m_imageDecodes->isDone();
+        m_tile->paintBitmap(m_painter, renderer, skipImages);
         m_tile->setRepaintPending(false);
         m_tile = 0;
     }
@@ -124,6 +135,27 @@ int PaintTileOperation::priority()
     return priority;
 }
 
+bool PaintTileOperation::prepare(TexturesGenerator* generator)
+{
+    // Image tiles upload an already decoded bitmap
+    if (m_prepared || !m_tile || !m_painter || m_painter->type() == TilePainter::Image)
+        return false;
+
+    m_prepared = true;
+    m_imageDecodes = ImagePredecoder::instance()->predecode(m_tile, m_painter, generator);
+    if (!m_imageDecodes)
+        return false;
+
+    m_imageDecodeDeadline = systemTime() + IMAGE_DECODE_DEADLINE_NSECS;
+    return true;
+}
+
+bool PaintTileOperation::isReady()
+{
+    return !m_imageDecodes || m_imageDecodes->isDone()
+        || systemTime() >= m_imageDecodeDeadline;
+}
+
 void PaintTileOperation::updatePainter(TilePainter* painter)
 {
     if (m_painter == painter)
@@ -30,11 +30,14 @@
 #include "QueuedOperation.h"
 #include "SkRefCnt.h"
 
+#include <utils/Timers.h>
+
 namespace WebCore {
 
 class LayerAndroid;
 class TilePainter;
 class ImageTexture;
+class ImageDecodeBatch;
 
 class PaintTileOperation : public QueuedOperation {
 public:
@@ -46,6 +49,9 @@ public:
     virtual void* uniquePtr() { return m_tile; }
     // returns a rendering priority for m_tile, lower values are processed faster
     virtual int priority();
+    virtual bool prepare(TexturesGenerator* generator);
+    virtual bool isReady();
+    virtual nsecs_t readyDeadline() { return m_imageDecodeDeadline; }
 
     TilePainter* painter() { return m_painter; }
     void updatePainter(TilePainter* painter);
@@ -56,6 +62,11 @@ private:
     TilePainter* m_painter;
     GLWebViewState* m_state;
     bool m_isLowResPrefetch;
+
+    // decodes of the images drawn by the tile, 0 if there are none
+    ImageDecodeBatch* m_imageDecodes;
+    bool m_prepared;
+    nsecs_t m_imageDecodeDeadline;
 };
 
 class ScaleFilter : public OperationFilter {
@@ -26,9 +26,12 @@
 #ifndef QueuedOperation_h
 #define QueuedOperation_h
 
+#include <utils/Timers.h>
+
 namespace WebCore {
 
 class BaseRenderer;
+class TexturesGenerator;
 
 class QueuedOperation {
 public:
@@ -37,6 +40,14 @@ public:
     virtual bool operator==(const QueuedOperation* operation) = 0;
     virtual void* uniquePtr() = 0;
     virtual int priority() = 0;
+    // Called by the TexturesGenerator before running the operation. Returns
+    // true if the operation started work on other threads and should be put
+    // back in the queue until isReady() returns true.
+    virtual bool prepare(TexturesGenerator* generator) { return false; }
+    virtual bool isReady() { return true; }
+    // While isReady() returns false, the time at which the operation becomes
+    // ready even if its work on other threads is not done
+    virtual nsecs_t readyDeadline() { return 0; }
 };
 
 class OperationFilter {
@@ -44,6 +44,7 @@ TexturesGenerator::TexturesGenerator(TilesManager* instance)
   : Thread(false)
   , m_tilesManager(instance)
   , m_deferredMode(false)
+  , m_readyDeadline(0)
   , m_renderer(0)
 {
 }
@@ -81,6 +82,12 @@ void TexturesGenerator::scheduleOperation(QueuedOperation* operation)
         mRequestedOperationsCond.signal();
 }
 
+void TexturesGenerator::imagesDecoded()
+{
+    android::Mutex::Autolock lock(mRequestedOperationsLock);
+    mRequestedOperationsCond.signal();
+}
+
 void TexturesGenerator::removeOperationsForFilter(OperationFilter* filter)
 {
     if (!filter)
@@ -105,23 +112,37 @@ status_t TexturesGenerator::readyToRun()
     return NO_ERROR;
 }
 
+// Must be called from within a lock!
+nsecs_t TexturesGenerator::waitTimeout(nsecs_t timeout)
+{
+    if (!m_readyDeadline)
+        return timeout;
+    return std::max((nsecs_t)0, std::min(timeout, m_readyDeadline - systemTime()));
+}
+
 // Must be called from within a lock!
 QueuedOperation* TexturesGenerator::popNext()
 {
     // Priority can change between when it was added and now
     // Hence why the entire queue is rescanned
-    QueuedOperation* current = mRequestedOperations.last();
-    int currentPriority = current->priority();
-    if (currentPriority < 0) {
-        mRequestedOperations.removeLast();
-        mRequestedOperationsHash.remove(current->uniquePtr());
-        return current;
-    }
-    int currentIndex = mRequestedOperations.size() - 1;
+    QueuedOperation* current = 0;
+    int currentPriority = 0;
+    int currentIndex = -1;
+    bool waitingNonDeferrable = false;
+    m_readyDeadline = 0;
     // Scan from the back to make removing faster (less items to copy)
-    for (int i = mRequestedOperations.size() - 2; i >= 0; i--) {
+    for (int i = mRequestedOperations.size() - 1; i >= 0; i--) {
         QueuedOperation *next = mRequestedOperations[i];
         int nextPriority = next->priority();
+        // Skip operations still waiting for their images to be decoded, but
+        // remember when the first of them will be painted regardless
+        if (!next->isReady()) {
+            nsecs_t deadline = next->readyDeadline();
+            if (!m_readyDeadline || deadline < m_readyDeadline)
+                m_readyDeadline = deadline;
+            waitingNonDeferrable |= nextPriority < gDeferPriorityCutoff;
+            continue;
+        }
         if (nextPriority < 0) {
             // Found a very high priority item, go ahead and just handle it now
             mRequestedOperations.remove(i);
@@ -130,14 +151,20 @@ QueuedOperation* TexturesGenerator::popNext()
         }
         // pick items preferrably by priority, or if equal, by order of
         // insertion (as we add items at the back of the queue)
-        if (nextPriority <= currentPriority) {
+        if (!current || nextPriority <= currentPriority) {
             current = next;
             currentPriority = nextPriority;
             currentIndex = i;
         }
     }
 
+    if (!current)
+        return 0;
+
     if (!m_deferredMode && currentPriority >= gDeferPriorityCutoff) {
+        // non-deferred work waiting for its images is painted first
+        if (waitingNonDeferrable)
+            return 0;
         // finished with non-deferred rendering, enter deferred mode to wait
         m_deferredMode = true;
         return 0;
@@ -158,8 +185,10 @@ bool TexturesGenerator::threadLoop()
         while (!mRequestedOperations.size())
             mRequestedOperationsCond.wait(mRequestedOperationsLock);
     } else {
-        // if we only have deferred work, wait for better work, or a timeout
-        mRequestedOperationsCond.waitRelative(mRequestedOperationsLock, gDeferNsecs);
+        // if we only have deferred work, wait for better work, or a timeout,
+        // waking up early if an operation waiting for its images gets ready
+        mRequestedOperationsCond.waitRelative(mRequestedOperationsLock,
+                                              waitTimeout(gDeferNsecs));
     }
 
     mRequestedOperationsLock.unlock();
@@ -173,8 +202,33 @@ bool TexturesGenerator::threadLoop()
 
         if (mRequestedOperations.size())
             currentOperation = popNext();
+
+        if (!currentOperation && !m_deferredMode && mRequestedOperations.size()) {
+            // everything left is waiting for images to be decoded, until the
+            // decodes are done or the first deadline passes
+            mRequestedOperationsCond.waitRelative(mRequestedOperationsLock,
+                                                  waitTimeout(gDeferNsecs));
+            mRequestedOperationsLock.unlock();
+            continue;
+        }
         mRequestedOperationsLock.unlock();
 
+        if (currentOperation && currentOperation->prepare(this)) {
+            // the images drawn by the operation are being decoded, put it
+            // back and paint other tiles in the meantime, unless another
+            // operation for the same tile was scheduled while it was out
+            bool requeued = false;
+            mRequestedOperationsLock.lock();
+            if (!mRequestedOperationsHash.contains(currentOperation->uniquePtr())) {
+                mRequestedOperations.append(currentOperation);
+                mRequestedOperationsHash.set(currentOperation->uniquePtr(), currentOperation);
+                requeued = true;
+            }
+            mRequestedOperationsLock.unlock();
+            if (requeued)
+                continue;
+        }
+
         if (currentOperation) {
             ALOGV("threadLoop, painting the request with priority %d",
                   currentOperation->priority());
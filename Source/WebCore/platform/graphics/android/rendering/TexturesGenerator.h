@@ -54,12 +54,16 @@ public:
 
     void scheduleOperation(QueuedOperation* operation);
 
+    // Called by the ImagePredecoder when all the images of a tile are decoded
+    void imagesDecoded();
+
     // low res tiles are put at or above this cutoff when not scrolling,
     // signifying that they should be deferred
     static const int gDeferPriorityCutoff = 500000000;
 
 private:
     QueuedOperation* popNext();
+    nsecs_t waitTimeout(nsecs_t timeout);
     virtual bool threadLoop();
     WTF::Vector<QueuedOperation*> mRequestedOperations;
     WTF::HashMap<void*, QueuedOperation*> mRequestedOperationsHash;
@@ -68,6 +72,8 @@ private:
     TilesManager* m_tilesManager;
 
     bool m_deferredMode;
+    // earliest deadline of the operations popNext() skipped, 0 if none
+    nsecs_t m_readyDeadline;
     BaseRenderer* m_renderer;
 
     // defer painting for one second if best in queue has priority
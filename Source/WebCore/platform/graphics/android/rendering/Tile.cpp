@@ -294,7 +294,7 @@ bool Tile::isTileVisible(const IntRect& viewTileBounds)
 }
 
 // This is called from the texture generation thread
-void Tile::paintBitmap(TilePainter* painter, BaseRenderer* renderer)
+void Tile::paintBitmap(TilePainter* painter, BaseRenderer* renderer, bool skipImages)
 {
     // We acquire the values below atomically. This ensures that we are reading
     // values correctly across cores. Further, once we have these values they
@@ -334,6 +334,7 @@ void Tile::paintBitmap(TilePainter* painter, BaseRenderer* renderer)
     renderInfo.tilePainter = painter;
     renderInfo.baseTile = this;
     renderInfo.textureInfo = textureInfo;
+    renderInfo.skipImages = skipImages;
 
     const float tileWidth = renderInfo.tileSize.width();
     const float tileHeight = renderInfo.tileSize.height();
@@ -353,6 +354,10 @@ void Tile::paintBitmap(TilePainter* painter, BaseRenderer* renderer)
         if (m_scale != scale)
             m_dirty = true;
 
+        // repaint once the images are decoded
+        if (skipImages)
+            m_dirty = true;
+
         m_dirtyArea.setEmpty();
 
         ALOGV("painted tile %p (%d, %d), texture %p, dirty=%d", this, x, y, texture, m_dirty);
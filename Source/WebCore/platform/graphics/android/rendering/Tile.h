@@ -106,8 +106,9 @@ public:
                 bool forceBlending, bool usePointSampling,
                 const FloatRect& fillPortion);
 
-    // the only thread-safe function called by the background thread
-    void paintBitmap(TilePainter* painter, BaseRenderer* renderer);
+    // the only thread-safe function called by the background thread. When
+    // skipImages is set, the tile is painted without its images and stays dirty
+    void paintBitmap(TilePainter* painter, BaseRenderer* renderer, bool skipImages = false);
 
     bool intersectWithRect(int x, int y, int tileWidth, int tileHeight,
                            float scale, const SkRect& dirtyRect,
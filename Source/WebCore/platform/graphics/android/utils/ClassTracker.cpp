@@ -30,6 +30,7 @@
 #include "ClassTracker.h"
 
 #include "AndroidLog.h"
+#include "BitmapAllocatorAndroid.h"
 #include "LayerAndroid.h"
 #include "TilesManager.h"
 
@@ -103,6 +104,7 @@ void ClassTracker::show()
          nbAllocatedLayerTextures, nbLayerTextures,
          nbAllocatedLayerTextures * textureSize,
          (nbAllocatedTextures + nbAllocatedLayerTextures) * textureSize);
+   BitmapAllocatorAndroid::dumpStats();
 
 #ifdef DEBUG_LAYERS
    for (unsigned int i = 0; i < m_layers.size(); i++) {
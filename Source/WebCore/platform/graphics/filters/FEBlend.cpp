@@ -26,6 +26,7 @@
 #include "FEBlend.h"
 
 #include "Filter.h"
+#include "FilterResultCache.h"
 #include "FloatPoint.h"
 #include "GraphicsContext.h"
 #include "RenderTreeAsText.h"
@@ -164,6 +165,13 @@ static TextStream& operator<<(TextStream& ts, const BlendModeType& type)
     return ts;
 }
 
+bool FEBlend::addParametersToResultKey(FilterResultKey& key)
+{
+    key.add("feBlend");
+    key.add(m_mode);
+    return true;
+}
+
 TextStream& FEBlend::externalRepresentation(TextStream& ts, int indent) const
 {
     writeIndent(ts, indent);
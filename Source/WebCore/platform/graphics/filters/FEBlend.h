@@ -50,6 +50,8 @@ public:
 
     virtual TextStream& externalRepresentation(TextStream&, int indention) const;
 
+    virtual bool addParametersToResultKey(FilterResultKey&);
+
 private:
     FEBlend(Filter*, BlendModeType);
 
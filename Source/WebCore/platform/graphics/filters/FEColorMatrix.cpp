@@ -26,13 +26,21 @@
 #include "FEColorMatrix.h"
 
 #include "Filter.h"
+#include "FilterResultCache.h"
 #include "GraphicsContext.h"
 #include "RenderTreeAsText.h"
 #include "TextStream.h"
 
+#include <limits>
 #include <wtf/ByteArray.h>
 #include <wtf/MathExtras.h>
 
+#if HAVE(ARM_NEON_INTRINSICS)
+#include "arm/FEColorMatrixNEON.h"
+#elif defined(__SSE2__)
+#include "x86/FEColorMatrixSSE2.h"
+#endif
+
 namespace WebCore {
 
 FEColorMatrix::FEColorMatrix(Filter* filter, ColorMatrixType type, const Vector<float>& values)
@@ -124,15 +132,25 @@ inline void luminance(double& red, double& green, double& blue, double& alpha)
     blue = 0;
 }
 
+// Same as ByteArray::set(double).
+static inline unsigned char clampToByte(double value)
+{
+    if (!(value > 0)) // Clamp NaN to 0
+        return 0;
+    if (value > 255)
+        return 255;
+    return static_cast<unsigned char>(value + 0.5);
+}
+
 template<ColorMatrixType filterType>
-void effectType(ByteArray* pixelArray, const Vector<float>& values)
+void effectType(unsigned char* pixels, unsigned pixelCount, const Vector<float>& values)
 {
-    unsigned pixelArrayLength = pixelArray->length();
+    unsigned pixelArrayLength = pixelCount * 4;
     for (unsigned pixelByteOffset = 0; pixelByteOffset < pixelArrayLength; pixelByteOffset += 4) {
-        double red = pixelArray->get(pixelByteOffset);
-        double green = pixelArray->get(pixelByteOffset + 1);
-        double blue = pixelArray->get(pixelByteOffset + 2);
-        double alpha = pixelArray->get(pixelByteOffset + 3);
+        double red = pixels[pixelByteOffset];
+        double green = pixels[pixelByteOffset + 1];
+        double blue = pixels[pixelByteOffset + 2];
+        double alpha = pixels[pixelByteOffset + 3];
 
         switch (filterType) {
             case FECOLORMATRIX_TYPE_MATRIX:
@@ -149,11 +167,177 @@ void effectType(ByteArray* pixelArray, const Vector<float>& values)
                 break;
         }
 
-        pixelArray->set(pixelByteOffset, red);
-        pixelArray->set(pixelByteOffset + 1, green);
-        pixelArray->set(pixelByteOffset + 2, blue);
-        pixelArray->set(pixelByteOffset + 3, alpha);
+        pixels[pixelByteOffset] = clampToByte(red);
+        pixels[pixelByteOffset + 1] = clampToByte(green);
+        pixels[pixelByteOffset + 2] = clampToByte(blue);
+        pixels[pixelByteOffset + 3] = clampToByte(alpha);
+    }
+}
+
+static void calculateDouble(unsigned char* pixels, unsigned pixelCount, ColorMatrixType type, const Vector<float>& values)
+{
+    switch (type) {
+    case FECOLORMATRIX_TYPE_UNKNOWN:
+        break;
+    case FECOLORMATRIX_TYPE_MATRIX:
+        effectType<FECOLORMATRIX_TYPE_MATRIX>(pixels, pixelCount, values);
+        break;
+    case FECOLORMATRIX_TYPE_SATURATE: 
+        effectType<FECOLORMATRIX_TYPE_SATURATE>(pixels, pixelCount, values);
+        break;
+    case FECOLORMATRIX_TYPE_HUEROTATE:
+        effectType<FECOLORMATRIX_TYPE_HUEROTATE>(pixels, pixelCount, values);
+        break;
+    case FECOLORMATRIX_TYPE_LUMINANCETOALPHA:
+        effectType<FECOLORMATRIX_TYPE_LUMINANCETOALPHA>(pixels, pixelCount, values);
+        break;
+    }
+}
+
+// The fixed point matrix has 16-bit coefficients with this many fractional
+// bits, so it holds coefficients in (-8, 8).
+static const int fixedPointFractionBits = 12;
+
+// Expresses every type as a 4x4 fixed point matrix and the offsets to add to
+// each channel. The offsets are scaled to the 0-255 range and include the
+// rounding term. Returns false if a coefficient or an offset does not fit.
+static bool fixedPointMatrix(ColorMatrixType type, const Vector<float>& values, short coefficients[16], int offsets[4])
+{
+    double m[20] = { 1, 0, 0, 0, 0,
+                     0, 1, 0, 0, 0,
+                     0, 0, 1, 0, 0,
+                     0, 0, 0, 1, 0 };
+
+    switch (type) {
+    case FECOLORMATRIX_TYPE_UNKNOWN:
+        break;
+    case FECOLORMATRIX_TYPE_MATRIX:
+        for (int i = 0; i < 20; ++i)
+            m[i] = values[i];
+        break;
+    case FECOLORMATRIX_TYPE_SATURATE: {
+        double s = values[0];
+        m[0] = 0.213 + 0.787 * s;
+        m[1] = 0.715 - 0.715 * s;
+        m[2] = 0.072 - 0.072 * s;
+        m[5] = 0.213 - 0.213 * s;
+        m[6] = 0.715 + 0.285 * s;
+        m[7] = 0.072 - 0.072 * s;
+        m[10] = 0.213 - 0.213 * s;
+        m[11] = 0.715 - 0.715 * s;
+        m[12] = 0.072 + 0.928 * s;
+        break;
+    }
+    case FECOLORMATRIX_TYPE_HUEROTATE: {
+        double cosHue = cos(values[0] * piDouble / 180);
+        double sinHue = sin(values[0] * piDouble / 180);
+        m[0] = 0.213 + cosHue * 0.787 - sinHue * 0.213;
+        m[1] = 0.715 - cosHue * 0.715 - sinHue * 0.715;
+        m[2] = 0.072 - cosHue * 0.072 + sinHue * 0.928;
+        m[5] = 0.213 - cosHue * 0.213 + sinHue * 0.143;
+        m[6] = 0.715 + cosHue * 0.285 + sinHue * 0.140;
+        m[7] = 0.072 - cosHue * 0.072 - sinHue * 0.283;
+        m[10] = 0.213 - cosHue * 0.213 - sinHue * 0.787;
+        m[11] = 0.715 - cosHue * 0.715 + sinHue * 0.715;
+        m[12] = 0.072 + cosHue * 0.928 + sinHue * 0.072;
+        break;
+    }
+    case FECOLORMATRIX_TYPE_LUMINANCETOALPHA:
+        for (int i = 0; i < 20; ++i)
+            m[i] = 0;
+        m[15] = 0.2125;
+        m[16] = 0.7154;
+        m[17] = 0.0721;
+        break;
+    }
+
+    const double scale = 1 << fixedPointFractionBits;
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            double coefficient = floor(m[row * 5 + column] * scale + 0.5);
+            // Also rejects NaN.
+            if (!(fabs(coefficient) <= std::numeric_limits<short>::max()))
+                return false;
+            coefficients[row * 4 + column] = static_cast<short>(coefficient);
+        }
+        // Four products are below 2^25, so an offset below 2^30 cannot overflow the sum.
+        double offset = floor(m[row * 5 + 4] * 255 * scale + 0.5) + scale / 2;
+        if (!(fabs(offset) < (1 << 30)))
+            return false;
+        offsets[row] = static_cast<int>(offset);
+    }
+    return true;
+}
+
+static inline unsigned char clampFixedPointToByte(int value)
+{
+    value >>= fixedPointFractionBits;
+    if (value < 0)
+        return 0;
+    if (value > 255)
+        return 255;
+    return value;
+}
+
+static void calculateFixedPoint(unsigned char* pixels, unsigned pixelCount, const short* coefficients, const int* offsets, bool vectorized)
+{
+    unsigned i = 0;
+    if (vectorized) {
+#if HAVE(ARM_NEON_INTRINSICS)
+        i = colorMatrixNEON<fixedPointFractionBits>(pixels, pixelCount, coefficients, offsets);
+#elif defined(__SSE2__)
+        i = colorMatrixSSE2<fixedPointFractionBits>(pixels, pixelCount, coefficients, offsets);
+#endif
+    }
+
+    for (unsigned char* pixel = pixels + i * 4; i < pixelCount; ++i, pixel += 4) {
+        int red = pixel[0];
+        int green = pixel[1];
+        int blue = pixel[2];
+        int alpha = pixel[3];
+        for (int row = 0; row < 4; ++row) {
+            const short* m = coefficients + row * 4;
+            pixel[row] = clampFixedPointToByte(m[0] * red + m[1] * green + m[2] * blue + m[3] * alpha + offsets[row]);
+        }
+    }
+}
+
+static void calculate(unsigned char* pixels, unsigned pixelCount, ColorMatrixType type, const Vector<float>& values, bool vectorized)
+{
+    if (type == FECOLORMATRIX_TYPE_UNKNOWN)
+        return;
+
+    short coefficients[16];
+    int offsets[4];
+    if (!fixedPointMatrix(type, values, coefficients, offsets)) {
+        calculateDouble(pixels, pixelCount, type, values);
+        return;
     }
+    calculateFixedPoint(pixels, pixelCount, coefficients, offsets, vectorized);
+}
+
+void FEColorMatrix::calculate(unsigned char* pixels, unsigned pixelCount, ColorMatrixType type, const Vector<float>& values)
+{
+    WebCore::calculate(pixels, pixelCount, type, values, true);
+}
+
+void FEColorMatrix::calculateScalar(unsigned char* pixels, unsigned pixelCount, ColorMatrixType type, const Vector<float>& values)
+{
+    WebCore::calculate(pixels, pixelCount, type, values, false);
+}
+
+struct ColorMatrixPaintingData {
+    unsigned char* pixels;
+    int width;
+    ColorMatrixType type;
+    const Vector<float>* values;
+};
+
+static void calculateRowBand(void* context, int startY, int endY)
+{
+    ColorMatrixPaintingData* paintingData = static_cast<ColorMatrixPaintingData*>(context);
+    FEColorMatrix::calculate(paintingData->pixels + startY * paintingData->width * 4, (endY - startY) * paintingData->width,
+                             paintingData->type, *paintingData->values);
 }
 
 void FEColorMatrix::apply()
@@ -174,23 +358,10 @@ void FEColorMatrix::apply()
     IntRect imageRect(IntPoint(), absolutePaintRect().size());
     RefPtr<ByteArray> pixelArray = resultImage->getUnmultipliedImageData(imageRect);
 
-    switch (m_type) {
-    case FECOLORMATRIX_TYPE_UNKNOWN:
-        break;
-    case FECOLORMATRIX_TYPE_MATRIX:
-        effectType<FECOLORMATRIX_TYPE_MATRIX>(pixelArray.get(), m_values);
-        break;
-    case FECOLORMATRIX_TYPE_SATURATE: 
-        effectType<FECOLORMATRIX_TYPE_SATURATE>(pixelArray.get(), m_values);
-        break;
-    case FECOLORMATRIX_TYPE_HUEROTATE:
-        effectType<FECOLORMATRIX_TYPE_HUEROTATE>(pixelArray.get(), m_values);
-        break;
-    case FECOLORMATRIX_TYPE_LUMINANCETOALPHA:
-        effectType<FECOLORMATRIX_TYPE_LUMINANCETOALPHA>(pixelArray.get(), m_values);
+    ColorMatrixPaintingData paintingData = { pixelArray->data(), imageRect.width(), m_type, &m_values };
+    applyInRowBands(&calculateRowBand, &paintingData, imageRect.width(), imageRect.height());
+    if (m_type == FECOLORMATRIX_TYPE_LUMINANCETOALPHA)
         setIsAlphaImage(true);
-        break;
-    }
 
     resultImage->putUnmultipliedImageData(pixelArray.get(), imageRect.size(), imageRect, IntPoint());
 }
@@ -221,6 +392,14 @@ static TextStream& operator<<(TextStream& ts, const ColorMatrixType& type)
     return ts;
 }
 
+bool FEColorMatrix::addParametersToResultKey(FilterResultKey& key)
+{
+    key.add("feColorMatrix");
+    key.add(m_type);
+    key.add(m_values);
+    return true;
+}
+
 TextStream& FEColorMatrix::externalRepresentation(TextStream& ts, int indent) const
 {
     writeIndent(ts, indent);
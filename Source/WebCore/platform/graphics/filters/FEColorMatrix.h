@@ -53,6 +53,14 @@ public:
 
     virtual TextStream& externalRepresentation(TextStream&, int indention) const;
 
+    virtual bool addParametersToResultKey(FilterResultKey&);
+
+    // Transforms unmultiplied pixels in place, with a fixed point matrix when
+    // the coefficients fit in one. calculate() uses SSE2 or NEON when
+    // available, and always gives the same result as calculateScalar().
+    static void calculate(unsigned char* pixels, unsigned pixelCount, ColorMatrixType, const Vector<float>& values);
+    static void calculateScalar(unsigned char* pixels, unsigned pixelCount, ColorMatrixType, const Vector<float>& values);
+
 private:
     FEColorMatrix(Filter*, ColorMatrixType, const Vector<float>&);
 
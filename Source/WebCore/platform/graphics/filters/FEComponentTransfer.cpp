@@ -27,6 +27,7 @@
 #include "FEComponentTransfer.h"
 
 #include "Filter.h"
+#include "FilterResultCache.h"
 #include "GraphicsContext.h"
 #include "RenderTreeAsText.h"
 #include "TextStream.h"
@@ -224,6 +225,27 @@ static TextStream& operator<<(TextStream& ts, const ComponentTransferFunction& f
     return ts;
 }
 
+static void addFunctionToKey(FilterResultKey& key, const ComponentTransferFunction& function)
+{
+    key.add(function.type);
+    key.add(function.slope);
+    key.add(function.intercept);
+    key.add(function.amplitude);
+    key.add(function.exponent);
+    key.add(function.offset);
+    key.add(function.tableValues);
+}
+
+bool FEComponentTransfer::addParametersToResultKey(FilterResultKey& key)
+{
+    key.add("feComponentTransfer");
+    addFunctionToKey(key, m_redFunc);
+    addFunctionToKey(key, m_greenFunc);
+    addFunctionToKey(key, m_blueFunc);
+    addFunctionToKey(key, m_alphaFunc);
+    return true;
+}
+
 TextStream& FEComponentTransfer::externalRepresentation(TextStream& ts, int indent) const
 {
     writeIndent(ts, indent);
@@ -83,6 +83,8 @@ public:
 
     virtual TextStream& externalRepresentation(TextStream&, int indention) const;
 
+    virtual bool addParametersToResultKey(FilterResultKey&);
+
 private:
     FEComponentTransfer(Filter*, const ComponentTransferFunction& redFunc, const ComponentTransferFunction& greenFunc,
                         const ComponentTransferFunction& blueFunc, const ComponentTransferFunction& alphaFunc);
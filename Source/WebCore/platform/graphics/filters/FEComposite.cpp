@@ -27,12 +27,19 @@
 #include "FEComposite.h"
 
 #include "Filter.h"
+#include "FilterResultCache.h"
 #include "GraphicsContext.h"
 #include "RenderTreeAsText.h"
 #include "TextStream.h"
 
 #include <wtf/ByteArray.h>
 
+#if HAVE(ARM_NEON_INTRINSICS)
+#include "arm/FECompositeArithmeticNEON.h"
+#elif defined(__SSE2__)
+#include "x86/FECompositeArithmeticSSE2.h"
+#endif
+
 namespace WebCore {
 
 FEComposite::FEComposite(Filter* filter, const CompositeOperationType& type, float k1, float k2, float k3, float k4)
@@ -116,7 +123,7 @@ bool FEComposite::setK4(float k4)
 }
 
 template <int b1, int b2, int b3, int b4>
-inline void computeArithmeticPixels(unsigned char* source, unsigned char* destination, int pixelArrayLength,
+inline void computeArithmeticPixels(const unsigned char* source, unsigned char* destination, int pixelArrayLength,
                                     float k1, float k2, float k3, float k4)
 {
     float scaledK4;
@@ -150,29 +157,72 @@ inline void computeArithmeticPixels(unsigned char* source, unsigned char* destin
     }
 }
 
-inline void arithmetic(ByteArray* srcPixelArrayA, ByteArray* srcPixelArrayB,
-                       float k1, float k2, float k3, float k4)
+void FEComposite::computeArithmeticScalar(const unsigned char* source, unsigned char* destination, unsigned length,
+                                          float k1, float k2, float k3, float k4)
 {
-    int pixelArrayLength = srcPixelArrayA->length();
-    ASSERT(pixelArrayLength == static_cast<int>(srcPixelArrayB->length()));
-    unsigned char* source = srcPixelArrayA->data();
-    unsigned char* destination = srcPixelArrayB->data();
-
     if (!k4) {
         if (!k1) {
-            computeArithmeticPixels<0, 1, 1, 0>(source, destination, pixelArrayLength, k1, k2, k3, k4);
+            computeArithmeticPixels<0, 1, 1, 0>(source, destination, length, k1, k2, k3, k4);
             return;
         }
 
-        computeArithmeticPixels<1, 1, 1, 0>(source, destination, pixelArrayLength, k1, k2, k3, k4);
+        computeArithmeticPixels<1, 1, 1, 0>(source, destination, length, k1, k2, k3, k4);
         return;
     }
 
     if (!k1) {
-        computeArithmeticPixels<0, 1, 1, 1>(source, destination, pixelArrayLength, k1, k2, k3, k4);
+        computeArithmeticPixels<0, 1, 1, 1>(source, destination, length, k1, k2, k3, k4);
         return;
     }
-    computeArithmeticPixels<1, 1, 1, 1>(source, destination, pixelArrayLength, k1, k2, k3, k4);
+    computeArithmeticPixels<1, 1, 1, 1>(source, destination, length, k1, k2, k3, k4);
+}
+
+void FEComposite::computeArithmetic(const unsigned char* source, unsigned char* destination, unsigned length,
+                                    float k1, float k2, float k3, float k4)
+{
+#if HAVE(ARM_NEON_INTRINSICS)
+    ASSERT(!(length % 4));
+    if (!k4) {
+        if (!k1)
+            computeArithmeticPixelsNEON<0, 0>(source, destination, length, k1, k2, k3, k4);
+        else
+            computeArithmeticPixelsNEON<1, 0>(source, destination, length, k1, k2, k3, k4);
+    } else if (!k1)
+        computeArithmeticPixelsNEON<0, 1>(source, destination, length, k1, k2, k3, k4);
+    else
+        computeArithmeticPixelsNEON<1, 1>(source, destination, length, k1, k2, k3, k4);
+#elif defined(__SSE2__)
+    ASSERT(!(length % 4));
+    if (!k4) {
+        if (!k1)
+            computeArithmeticPixelsSSE2<0, 0>(source, destination, length, k1, k2, k3, k4);
+        else
+            computeArithmeticPixelsSSE2<1, 0>(source, destination, length, k1, k2, k3, k4);
+    } else if (!k1)
+        computeArithmeticPixelsSSE2<0, 1>(source, destination, length, k1, k2, k3, k4);
+    else
+        computeArithmeticPixelsSSE2<1, 1>(source, destination, length, k1, k2, k3, k4);
+#else
+    computeArithmeticScalar(source, destination, length, k1, k2, k3, k4);
+#endif
+}
+
+struct ArithmeticPaintingData {
+    const unsigned char* source;
+    unsigned char* destination;
+    int width;
+    float k1;
+    float k2;
+    float k3;
+    float k4;
+};
+
+static void computeArithmeticRowBand(void* context, int startY, int endY)
+{
+    ArithmeticPaintingData* paintingData = static_cast<ArithmeticPaintingData*>(context);
+    int offset = startY * paintingData->width * 4;
+    FEComposite::computeArithmetic(paintingData->source + offset, paintingData->destination + offset, (endY - startY) * paintingData->width * 4,
+                                   paintingData->k1, paintingData->k2, paintingData->k3, paintingData->k4);
 }
 
 void FEComposite::determineAbsolutePaintRect()
@@ -218,7 +268,10 @@ void FEComposite::apply()
         IntRect effectBDrawingRect = requestedRegionOfInputImageData(in2->absolutePaintRect());
         in2->copyPremultipliedImage(dstPixelArray, effectBDrawingRect);
 
-        arithmetic(srcPixelArray.get(), dstPixelArray, m_k1, m_k2, m_k3, m_k4);
+        ASSERT(srcPixelArray->length() == dstPixelArray->length());
+        IntSize paintSize = absolutePaintRect().size();
+        ArithmeticPaintingData paintingData = { srcPixelArray->data(), dstPixelArray->data(), paintSize.width(), m_k1, m_k2, m_k3, m_k4 };
+        applyInRowBands(&computeArithmeticRowBand, &paintingData, paintSize.width(), paintSize.height());
         return;
     }
 
@@ -288,6 +341,17 @@ static TextStream& operator<<(TextStream& ts, const CompositeOperationType& type
     return ts;
 }
 
+bool FEComposite::addParametersToResultKey(FilterResultKey& key)
+{
+    key.add("feComposite");
+    key.add(m_type);
+    key.add(m_k1);
+    key.add(m_k2);
+    key.add(m_k3);
+    key.add(m_k4);
+    return true;
+}
+
 TextStream& FEComposite::externalRepresentation(TextStream& ts, int indent) const
 {
     writeIndent(ts, indent);
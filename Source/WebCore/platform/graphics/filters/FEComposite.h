@@ -66,6 +66,16 @@ public:
 
     virtual TextStream& externalRepresentation(TextStream&, int indention) const;
 
+    virtual bool addParametersToResultKey(FilterResultKey&);
+
+    // Computes the arithmetic operator of |length| premultiplied bytes into
+    // |destination|, using SSE2 or NEON when available. Those add the terms in
+    // the same order as computeArithmeticScalar, so the result is the same.
+    static void computeArithmetic(const unsigned char* source, unsigned char* destination, unsigned length,
+                                  float k1, float k2, float k3, float k4);
+    static void computeArithmeticScalar(const unsigned char* source, unsigned char* destination, unsigned length,
+                                        float k1, float k2, float k3, float k4);
+
 private:
     FEComposite(Filter*, const CompositeOperationType&, float, float, float, float);
 
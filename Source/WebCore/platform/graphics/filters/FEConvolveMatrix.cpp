@@ -27,6 +27,7 @@
 #include "FEConvolveMatrix.h"
 
 #include "Filter.h"
+#include "FilterResultCache.h"
 #include "RenderTreeAsText.h"
 #include "TextStream.h"
 
@@ -237,11 +238,11 @@ ALWAYS_INLINE void setDestinationPixels(ByteArray* image, int& pixel, float* tot
 
 // Only for region C
 template<bool preserveAlphaValues>
-ALWAYS_INLINE void FEConvolveMatrix::fastSetInteriorPixels(PaintingData& paintingData, int clipRight, int clipBottom)
+ALWAYS_INLINE void FEConvolveMatrix::fastSetInteriorPixels(PaintingData& paintingData, int clipRight, int yStart, int yEnd)
 {
     // edge mode does not affect these pixels
-    int pixel = (m_targetOffset.y() * paintingData.width + m_targetOffset.x()) * 4;
-    int startKernelPixel = 0;
+    int pixel = ((m_targetOffset.y() + yStart) * paintingData.width + m_targetOffset.x()) * 4;
+    int startKernelPixel = yStart * paintingData.width * 4;
     int kernelIncrease = clipRight * 4;
     int xIncrease = (m_kernelSize.width() - 1) * 4;
     // Contains the sum of rgb(a) components
@@ -250,7 +251,7 @@ ALWAYS_INLINE void FEConvolveMatrix::fastSetInteriorPixels(PaintingData& paintin
     // m_divisor cannot be 0, SVGFEConvolveMatrixElement ensures this
     ASSERT(m_divisor);
 
-    for (int y = clipBottom + 1; y > 0; --y) {
+    for (int y = yEnd - yStart; y > 0; --y) {
         for (int x = clipRight + 1; x > 0; --x) {
             int kernelValue = m_kernelMatrix.size() - 1;
             int kernelPixel = startKernelPixel;
@@ -370,14 +371,20 @@ void FEConvolveMatrix::fastSetOuterPixels(PaintingData& paintingData, int x1, in
     }
 }
 
-ALWAYS_INLINE void FEConvolveMatrix::setInteriorPixels(PaintingData& paintingData, int clipRight, int clipBottom)
+ALWAYS_INLINE void FEConvolveMatrix::setInteriorPixels(PaintingData& paintingData, int clipRight, int yStart, int yEnd)
 {
     // Must be implemented here, since it refers another ALWAYS_INLINE
     // function, which defined in this C++ source file as well
     if (m_preserveAlpha)
-        fastSetInteriorPixels<true>(paintingData, clipRight, clipBottom);
+        fastSetInteriorPixels<true>(paintingData, clipRight, yStart, yEnd);
     else
-        fastSetInteriorPixels<false>(paintingData, clipRight, clipBottom);
+        fastSetInteriorPixels<false>(paintingData, clipRight, yStart, yEnd);
+}
+
+void FEConvolveMatrix::setInteriorPixelsWorker(void* parameters, int yStart, int yEnd)
+{
+    InteriorPixelParameters* interiorPixelParameters = static_cast<InteriorPixelParameters*>(parameters);
+    interiorPixelParameters->filter->setInteriorPixels(*interiorPixelParameters->paintingData, interiorPixelParameters->clipRight, yStart, yEnd);
 }
 
 ALWAYS_INLINE void FEConvolveMatrix::setOuterPixels(PaintingData& paintingData, int x1, int y1, int x2, int y2)
@@ -428,7 +435,9 @@ void FEConvolveMatrix::apply()
     int clipBottom = paintSize.height() - m_kernelSize.height();
 
     if (clipRight >= 0 && clipBottom >= 0) {
-        setInteriorPixels(paintingData, clipRight, clipBottom);
+        // The interior rows do not depend on each other, so they are computed in parallel.
+        InteriorPixelParameters parameters = { this, &paintingData, clipRight };
+        applyInRowBands(&setInteriorPixelsWorker, &parameters, paintSize.width(), clipBottom + 1);
 
         clipRight += m_targetOffset.x() + 1;
         clipBottom += m_targetOffset.y() + 1;
@@ -469,6 +478,22 @@ static TextStream& operator<<(TextStream& ts, const EdgeModeType& type)
     return ts;
 }
 
+bool FEConvolveMatrix::addParametersToResultKey(FilterResultKey& key)
+{
+    key.add("feConvolveMatrix");
+    key.add(m_kernelSize.width());
+    key.add(m_kernelSize.height());
+    key.add(m_divisor);
+    key.add(m_bias);
+    key.add(m_targetOffset.x());
+    key.add(m_targetOffset.y());
+    key.add(m_edgeMode);
+    key.add(m_kernelUnitLength);
+    key.add(m_preserveAlpha);
+    key.add(m_kernelMatrix);
+    return true;
+}
+
 TextStream& FEConvolveMatrix::externalRepresentation(TextStream& ts, int indent) const
 {
     writeIndent(ts, indent);
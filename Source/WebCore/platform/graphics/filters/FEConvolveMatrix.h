@@ -79,6 +79,8 @@ public:
 
     virtual TextStream& externalRepresentation(TextStream&, int indention) const;
 
+    virtual bool addParametersToResultKey(FilterResultKey&);
+
 private:
     FEConvolveMatrix(Filter*, const IntSize&, float, float,
             const IntPoint&, EdgeModeType, const FloatPoint&, bool, const Vector<float>&);
@@ -91,8 +93,16 @@ private:
         float bias;
     };
 
+    struct InteriorPixelParameters {
+        FEConvolveMatrix* filter;
+        PaintingData* paintingData;
+        int clipRight;
+    };
+
+    static void setInteriorPixelsWorker(void* parameters, int yStart, int yEnd);
+
     template<bool preserveAlphaValues>
-    ALWAYS_INLINE void fastSetInteriorPixels(PaintingData&, int clipRight, int clipBottom);
+    ALWAYS_INLINE void fastSetInteriorPixels(PaintingData&, int clipRight, int yStart, int yEnd);
 
     ALWAYS_INLINE int getPixelValue(PaintingData&, int x, int y);
 
@@ -100,7 +110,7 @@ private:
     void fastSetOuterPixels(PaintingData&, int x1, int y1, int x2, int y2);
 
     // Wrapper functions
-    ALWAYS_INLINE void setInteriorPixels(PaintingData& paintingData, int clipRight, int clipBottom);
+    ALWAYS_INLINE void setInteriorPixels(PaintingData& paintingData, int clipRight, int yStart, int yEnd);
     ALWAYS_INLINE void setOuterPixels(PaintingData& paintingData, int x1, int y1, int x2, int y2);
 
     IntSize m_kernelSize;
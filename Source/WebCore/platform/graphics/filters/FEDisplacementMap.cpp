@@ -27,6 +27,7 @@
 #include "FEDisplacementMap.h"
 
 #include "Filter.h"
+#include "FilterResultCache.h"
 #include "GraphicsContext.h"
 #include "RenderTreeAsText.h"
 #include "TextStream.h"
@@ -165,6 +166,15 @@ static TextStream& operator<<(TextStream& ts, const ChannelSelectorType& type)
     return ts;
 }
 
+bool FEDisplacementMap::addParametersToResultKey(FilterResultKey& key)
+{
+    key.add("feDisplacementMap");
+    key.add(m_xChannelSelector);
+    key.add(m_yChannelSelector);
+    key.add(m_scale);
+    return true;
+}
+
 TextStream& FEDisplacementMap::externalRepresentation(TextStream& ts, int indent) const
 {
     writeIndent(ts, indent);
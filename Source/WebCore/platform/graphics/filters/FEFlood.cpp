@@ -26,6 +26,7 @@
 #include "FEFlood.h"
 
 #include "Filter.h"
+#include "FilterResultCache.h"
 #include "GraphicsContext.h"
 #include "RenderTreeAsText.h"
 #include "TextStream.h"
@@ -86,6 +87,14 @@ void FEFlood::dump()
 {
 }
 
+bool FEFlood::addParametersToResultKey(FilterResultKey& key)
+{
+    key.add("feFlood");
+    key.add(m_floodColor);
+    key.add(m_floodOpacity);
+    return true;
+}
+
 TextStream& FEFlood::externalRepresentation(TextStream& ts, int indent) const
 {
     writeIndent(ts, indent);
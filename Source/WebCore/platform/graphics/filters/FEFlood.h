@@ -46,6 +46,8 @@ public:
 
     virtual TextStream& externalRepresentation(TextStream&, int indention) const;
 
+    virtual bool addParametersToResultKey(FilterResultKey&);
+
 private:
     FEFlood(Filter*, const Color&, float);
 
@@ -28,6 +28,7 @@
 #include "FEGaussianBlur.h"
 
 #include "Filter.h"
+#include "FilterResultCache.h"
 #include "GraphicsContext.h"
 #include "RenderTreeAsText.h"
 #include "TextStream.h"
@@ -35,6 +36,12 @@
 #include <wtf/ByteArray.h>
 #include <wtf/MathExtras.h>
 
+#if HAVE(ARM_NEON_INTRINSICS)
+#include "arm/FEGaussianBlurNEON.h"
+#elif defined(__SSE2__)
+#include "x86/FEGaussianBlurSSE2.h"
+#endif
+
 using std::max;
 
 static const float gGaussianKernelFactor = 3 / 4.f * sqrtf(2 * piFloat);
@@ -74,26 +81,26 @@ void FEGaussianBlur::setStdDeviationY(float y)
     m_stdY = y;
 }
 
-inline void boxBlur(ByteArray* srcPixelArray, ByteArray* dstPixelArray,
-                    unsigned dx, int dxLeft, int dxRight, int stride, int strideLine, int effectWidth, int effectHeight, bool alphaImage)
+void FEGaussianBlur::boxBlurScalar(const unsigned char* srcPixels, unsigned char* dstPixels,
+                                   unsigned dx, int dxLeft, int dxRight, int stride, int strideLine, int effectWidth, int startLine, int endLine, bool alphaImage)
 {
-    for (int y = 0; y < effectHeight; ++y) {
+    for (int y = startLine; y < endLine; ++y) {
         int line = y * strideLine;
         for (int channel = 3; channel >= 0; --channel) {
             int sum = 0;
             // Fill the kernel
             int maxKernelSize = std::min(dxRight, effectWidth);
             for (int i = 0; i < maxKernelSize; ++i)
-                sum += srcPixelArray->get(line + i * stride + channel);
+                sum += srcPixels[line + i * stride + channel];
 
             // Blurring
             for (int x = 0; x < effectWidth; ++x) {
                 int pixelByteOffset = line + x * stride + channel;
-                dstPixelArray->set(pixelByteOffset, static_cast<unsigned char>(sum / dx));
+                dstPixels[pixelByteOffset] = static_cast<unsigned char>(sum / dx);
                 if (x >= dxLeft)
-                    sum -= srcPixelArray->get(pixelByteOffset - dxLeft * stride);
+                    sum -= srcPixels[pixelByteOffset - dxLeft * stride];
                 if (x + dxRight < effectWidth)
-                    sum += srcPixelArray->get(pixelByteOffset + dxRight * stride);
+                    sum += srcPixels[pixelByteOffset + dxRight * stride];
             }
             if (alphaImage) // Source image is black, it just has different alpha values
                 break;
@@ -101,6 +108,49 @@ inline void boxBlur(ByteArray* srcPixelArray, ByteArray* dstPixelArray,
     }
 }
 
+void FEGaussianBlur::boxBlur(const unsigned char* srcPixels, unsigned char* dstPixels,
+                             unsigned dx, int dxLeft, int dxRight, int stride, int strideLine, int effectWidth, int startLine, int endLine, bool alphaImage)
+{
+    // Alpha images only blur one channel, which the vectorized code does not save time on.
+    if (!alphaImage) {
+#if HAVE(ARM_NEON_INTRINSICS)
+        boxBlurNEON(srcPixels, dstPixels, dx, dxLeft, dxRight, stride, strideLine, effectWidth, startLine, endLine);
+        return;
+#elif defined(__SSE2__)
+        boxBlurSSE2(srcPixels, dstPixels, dx, dxLeft, dxRight, stride, strideLine, effectWidth, startLine, endLine);
+        return;
+#endif
+    }
+    boxBlurScalar(srcPixels, dstPixels, dx, dxLeft, dxRight, stride, strideLine, effectWidth, startLine, endLine, alphaImage);
+}
+
+struct BoxBlurPass {
+    ByteArray* srcPixelArray;
+    ByteArray* dstPixelArray;
+    unsigned dx;
+    int dxLeft;
+    int dxRight;
+    int stride;
+    int strideLine;
+    int effectWidth;
+    bool alphaImage;
+};
+
+static void boxBlurLines(void* context, int startLine, int endLine)
+{
+    BoxBlurPass* pass = static_cast<BoxBlurPass*>(context);
+    FEGaussianBlur::boxBlur(pass->srcPixelArray->data(), pass->dstPixelArray->data(), pass->dx, pass->dxLeft, pass->dxRight,
+                            pass->stride, pass->strideLine, pass->effectWidth, startLine, endLine, pass->alphaImage);
+}
+
+// The lines of one pass are independent of each other, so they are blurred in parallel.
+static void boxBlurInParallel(ByteArray* srcPixelArray, ByteArray* dstPixelArray,
+                              unsigned dx, int dxLeft, int dxRight, int stride, int strideLine, int effectWidth, int effectHeight, bool alphaImage)
+{
+    BoxBlurPass pass = { srcPixelArray, dstPixelArray, dx, dxLeft, dxRight, stride, strideLine, effectWidth, alphaImage };
+    FilterEffect::applyInRowBands(&boxBlurLines, &pass, effectWidth, effectHeight);
+}
+
 inline void kernelPosition(int boxBlur, unsigned& std, int& dLeft, int& dRight)
 {
     // check http://www.w3.org/TR/SVG/filters.html#feGaussianBlurElement for details
@@ -201,7 +251,7 @@ void FEGaussianBlur::apply()
     for (int i = 0; i < 3; ++i) {
         if (kernelSizeX) {
             kernelPosition(i, kernelSizeX, dxLeft, dxRight);
-            boxBlur(srcPixelArray, tmpPixelArray, kernelSizeX, dxLeft, dxRight, 4, stride, paintSize.width(), paintSize.height(), isAlphaImage());
+            boxBlurInParallel(srcPixelArray, tmpPixelArray, kernelSizeX, dxLeft, dxRight, 4, stride, paintSize.width(), paintSize.height(), isAlphaImage());
         } else {
             ByteArray* auxPixelArray = tmpPixelArray;
             tmpPixelArray = srcPixelArray;
@@ -210,7 +260,7 @@ void FEGaussianBlur::apply()
 
         if (kernelSizeY) {
             kernelPosition(i, kernelSizeY, dyLeft, dyRight);
-            boxBlur(tmpPixelArray, srcPixelArray, kernelSizeY, dyLeft, dyRight, stride, 4, paintSize.height(), paintSize.width(), isAlphaImage());
+            boxBlurInParallel(tmpPixelArray, srcPixelArray, kernelSizeY, dyLeft, dyRight, stride, 4, paintSize.height(), paintSize.width(), isAlphaImage());
         } else {
             ByteArray* auxPixelArray = tmpPixelArray;
             tmpPixelArray = srcPixelArray;
@@ -223,6 +273,14 @@ void FEGaussianBlur::dump()
 {
 }
 
+bool FEGaussianBlur::addParametersToResultKey(FilterResultKey& key)
+{
+    key.add("feGaussianBlur");
+    key.add(m_stdX);
+    key.add(m_stdY);
+    return true;
+}
+
 TextStream& FEGaussianBlur::externalRepresentation(TextStream& ts, int indent) const
 {
     writeIndent(ts, indent);
@@ -40,6 +40,13 @@ public:
 
     static float calculateStdDeviation(float);
 
+    // Runs one box blur pass over the lines [startLine, endLine), using SSE2 or
+    // NEON when available. The result is always the same as boxBlurScalar.
+    static void boxBlur(const unsigned char* srcPixels, unsigned char* dstPixels,
+                        unsigned dx, int dxLeft, int dxRight, int stride, int strideLine, int effectWidth, int startLine, int endLine, bool alphaImage);
+    static void boxBlurScalar(const unsigned char* srcPixels, unsigned char* dstPixels,
+                              unsigned dx, int dxLeft, int dxRight, int stride, int strideLine, int effectWidth, int startLine, int endLine, bool alphaImage);
+
     virtual void apply();
     virtual void dump();
     
@@ -47,6 +54,8 @@ public:
 
     virtual TextStream& externalRepresentation(TextStream&, int indention) const;
 
+    virtual bool addParametersToResultKey(FilterResultKey&);
+
 private:
     FEGaussianBlur(Filter*, float, float);
 
@@ -29,6 +29,8 @@
 #if ENABLE(FILTERS)
 #include "FELighting.h"
 
+#include "DistantLightSource.h"
+#include "FilterResultCache.h"
 #include "LightSource.h"
 #include "PointLightSource.h"
 #include "SpotLightSource.h"
@@ -365,6 +367,42 @@ void FELighting::apply()
     drawLighting(srcPixelArray, absolutePaintSize.width(), absolutePaintSize.height());
 }
 
+bool FELighting::addParametersToResultKey(FilterResultKey& key)
+{
+    key.add("feLighting");
+    key.add(m_lightingType);
+    key.add(m_lightingColor);
+    key.add(m_surfaceScale);
+    key.add(m_diffuseConstant);
+    key.add(m_specularConstant);
+    key.add(m_specularExponent);
+    key.add(m_kernelUnitLengthX);
+    key.add(m_kernelUnitLengthY);
+
+    LightSource* lightSource = m_lightSource.get();
+    key.add(lightSource->type());
+    switch (lightSource->type()) {
+    case LS_DISTANT: {
+        DistantLightSource* distantLightSource = static_cast<DistantLightSource*>(lightSource);
+        key.add(distantLightSource->azimuth());
+        key.add(distantLightSource->elevation());
+        break;
+    }
+    case LS_POINT:
+        key.add(static_cast<PointLightSource*>(lightSource)->position());
+        break;
+    case LS_SPOT: {
+        SpotLightSource* spotLightSource = static_cast<SpotLightSource*>(lightSource);
+        key.add(spotLightSource->position());
+        key.add(spotLightSource->direction());
+        key.add(spotLightSource->specularExponent());
+        key.add(spotLightSource->limitingConeAngle());
+        break;
+    }
+    }
+    return true;
+}
+
 #if CPU(ARM_NEON) && COMPILER(GCC)
 
 static int getPowerCoefficients(float exponent)
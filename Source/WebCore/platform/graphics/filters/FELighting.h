@@ -45,6 +45,8 @@ public:
 
     virtual void determineAbsolutePaintRect() { setAbsolutePaintRect(enclosingIntRect(maxEffectRect())); }
 
+    virtual bool addParametersToResultKey(FilterResultKey&);
+
 protected:
     enum LightingType {
         DiffuseLighting,
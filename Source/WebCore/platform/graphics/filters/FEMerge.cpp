@@ -25,6 +25,7 @@
 #include "FEMerge.h"
 
 #include "Filter.h"
+#include "FilterResultCache.h"
 #include "GraphicsContext.h"
 #include "RenderTreeAsText.h"
 #include "TextStream.h"
@@ -69,6 +70,12 @@ void FEMerge::dump()
 {
 }
 
+bool FEMerge::addParametersToResultKey(FilterResultKey& key)
+{
+    key.add("feMerge");
+    return true;
+}
+
 TextStream& FEMerge::externalRepresentation(TextStream& ts, int indent) const
 {
     writeIndent(ts, indent);
@@ -27,12 +27,20 @@
 #include "FEMorphology.h"
 
 #include "Filter.h"
+#include "FilterResultCache.h"
 #include "RenderTreeAsText.h"
 #include "TextStream.h"
 
 #include <wtf/ByteArray.h>
+#include <wtf/UnusedParam.h>
 #include <wtf/Vector.h>
 
+#if HAVE(ARM_NEON_INTRINSICS)
+#include "arm/FEMorphologyNEON.h"
+#elif defined(__SSE2__)
+#include "x86/FEMorphologySSE2.h"
+#endif
+
 using std::min;
 using std::max;
 
@@ -100,6 +108,135 @@ bool FEMorphology::setRadiusY(float radiusY)
     return true;
 }
 
+template<bool erode>
+static inline unsigned char extrema(unsigned char a, unsigned char b)
+{
+    return erode ? min(a, b) : max(a, b);
+}
+
+template<bool erode>
+static inline int columnExtremaVectorized(unsigned char* extrema, const unsigned char* row, int length)
+{
+#if HAVE(ARM_NEON_INTRINSICS)
+    return columnExtremaNEON<erode>(extrema, row, length);
+#elif defined(__SSE2__)
+    return columnExtremaSSE2<erode>(extrema, row, length);
+#else
+    UNUSED_PARAM(extrema);
+    UNUSED_PARAM(row);
+    UNUSED_PARAM(length);
+    return 0;
+#endif
+}
+
+template<bool erode>
+static inline int rowExtremaVectorized(unsigned char* dstPixels, const unsigned char* extrema, int x, int endX, int radiusX)
+{
+#if HAVE(ARM_NEON_INTRINSICS)
+    return rowExtremaNEON<erode>(dstPixels, extrema, x, endX, radiusX);
+#elif defined(__SSE2__)
+    return rowExtremaSSE2<erode>(dstPixels, extrema, x, endX, radiusX);
+#else
+    UNUSED_PARAM(dstPixels);
+    UNUSED_PARAM(extrema);
+    UNUSED_PARAM(endX);
+    UNUSED_PARAM(radiusX);
+    return x;
+#endif
+}
+
+// The first column of the window of pixel x. The window used to be a queue
+// of column extrema that dropped its first column one pixel late while x was
+// in [radiusX, 2 * radiusX), and that is kept so that the output does not
+// change.
+static inline int windowStart(int x, int radiusX)
+{
+    if (x < radiusX)
+        return 0;
+    if (x < 2 * radiusX)
+        return x - radiusX + 1;
+    return x - radiusX;
+}
+
+// The operator is separable: every output row is computed from the extrema of
+// each column over the rows within radiusY, and then the extrema of those over
+// the columns of the window.
+template<bool erode, bool vectorized>
+static void applyToRows(const unsigned char* srcPixels, unsigned char* dstPixels, int width, int height, int radiusX, int radiusY, int startY, int endY)
+{
+    int rowBytes = width * 4;
+    Vector<unsigned char> columnExtrema(rowBytes);
+    unsigned char* extremaRow = columnExtrema.data();
+
+    for (int y = startY; y < endY; ++y) {
+        int startRow = max(0, y - radiusY);
+        int endRow = min(height - 1, y + radiusY);
+        memcpy(extremaRow, srcPixels + startRow * rowBytes, rowBytes);
+        for (int row = startRow + 1; row <= endRow; ++row) {
+            const unsigned char* srcRow = srcPixels + row * rowBytes;
+            int i = vectorized ? columnExtremaVectorized<erode>(extremaRow, srcRow, rowBytes) : 0;
+            for (; i < rowBytes; ++i)
+                extremaRow[i] = extrema<erode>(extremaRow[i], srcRow[i]);
+        }
+
+        unsigned char* dstRow = dstPixels + y * rowBytes;
+        // From 2 * radiusX up to width - radiusX every window is complete.
+        int fullWindowsStart = min(2 * radiusX, width);
+        int x = 0;
+        while (x < width) {
+            if (vectorized && x == fullWindowsStart)
+                x = rowExtremaVectorized<erode>(dstRow, extremaRow, x, width - radiusX, radiusX);
+            if (x >= width)
+                break;
+
+            int startX = windowStart(x, radiusX);
+            int endX = min(x + radiusX, width - 1);
+            for (int channel = 0; channel < 4; ++channel) {
+                unsigned char value = extremaRow[startX * 4 + channel];
+                for (int column = startX + 1; column <= endX; ++column)
+                    value = extrema<erode>(value, extremaRow[column * 4 + channel]);
+                dstRow[x * 4 + channel] = value;
+            }
+            ++x;
+        }
+    }
+}
+
+void FEMorphology::platformApply(const unsigned char* srcPixels, unsigned char* dstPixels, MorphologyOperatorType type,
+                                 int width, int height, int radiusX, int radiusY, int startY, int endY)
+{
+    if (type == FEMORPHOLOGY_OPERATOR_ERODE)
+        applyToRows<true, true>(srcPixels, dstPixels, width, height, radiusX, radiusY, startY, endY);
+    else
+        applyToRows<false, true>(srcPixels, dstPixels, width, height, radiusX, radiusY, startY, endY);
+}
+
+void FEMorphology::platformApplyScalar(const unsigned char* srcPixels, unsigned char* dstPixels, MorphologyOperatorType type,
+                                       int width, int height, int radiusX, int radiusY, int startY, int endY)
+{
+    if (type == FEMORPHOLOGY_OPERATOR_ERODE)
+        applyToRows<true, false>(srcPixels, dstPixels, width, height, radiusX, radiusY, startY, endY);
+    else
+        applyToRows<false, false>(srcPixels, dstPixels, width, height, radiusX, radiusY, startY, endY);
+}
+
+struct MorphologyPaintingData {
+    const unsigned char* srcPixels;
+    unsigned char* dstPixels;
+    MorphologyOperatorType type;
+    int width;
+    int height;
+    int radiusX;
+    int radiusY;
+};
+
+static void applyToRowBand(void* context, int startY, int endY)
+{
+    MorphologyPaintingData* paintingData = static_cast<MorphologyPaintingData*>(context);
+    FEMorphology::platformApply(paintingData->srcPixels, paintingData->dstPixels, paintingData->type,
+                                paintingData->width, paintingData->height, paintingData->radiusX, paintingData->radiusY, startY, endY);
+}
+
 void FEMorphology::apply()
 {
     if (hasResult())
@@ -124,54 +261,13 @@ void FEMorphology::apply()
     IntRect effectDrawingRect = requestedRegionOfInputImageData(in->absolutePaintRect());
     RefPtr<ByteArray> srcPixelArray = in->asPremultipliedImage(effectDrawingRect);
 
-    int effectWidth = effectDrawingRect.width() * 4;
-    
     // Limit the radius size to effect dimensions
     radiusX = min(effectDrawingRect.width() - 1, radiusX);
     radiusY = min(effectDrawingRect.height() - 1, radiusY);
-    
-    Vector<unsigned char> extrema;
-    for (int y = 0; y < effectDrawingRect.height(); ++y) {
-        int startY = max(0, y - radiusY);
-        int endY = min(effectDrawingRect.height() - 1, y + radiusY);
-        for (unsigned channel = 0; channel < 4; ++channel) {
-            // Fill the kernel
-            extrema.clear();
-            for (int j = 0; j <= radiusX; ++j) {
-                unsigned char columnExtrema = srcPixelArray->get(startY * effectWidth + 4 * j + channel);
-                for (int i = startY; i <= endY; ++i) {
-                    unsigned char pixel = srcPixelArray->get(i * effectWidth + 4 * j + channel);
-                    if ((m_type == FEMORPHOLOGY_OPERATOR_ERODE && pixel <= columnExtrema) ||
-                        (m_type == FEMORPHOLOGY_OPERATOR_DILATE && pixel >= columnExtrema))
-                        columnExtrema = pixel;
-                }
-                extrema.append(columnExtrema);
-            }
-            
-            // Kernel is filled, get extrema of next column 
-            for (int x = 0; x < effectDrawingRect.width(); ++x) {
-                unsigned endX = min(x + radiusX, effectDrawingRect.width() - 1);
-                unsigned char columnExtrema = srcPixelArray->get(startY * effectWidth + endX * 4 + channel);
-                for (int i = startY; i <= endY; ++i) {
-                    unsigned char pixel = srcPixelArray->get(i * effectWidth + endX * 4 + channel);
-                    if ((m_type == FEMORPHOLOGY_OPERATOR_ERODE && pixel <= columnExtrema) ||
-                        (m_type == FEMORPHOLOGY_OPERATOR_DILATE && pixel >= columnExtrema))
-                        columnExtrema = pixel;
-                }
-                if (x - radiusX >= 0)
-                    extrema.remove(0);
-                if (x + radiusX <= effectDrawingRect.width())
-                    extrema.append(columnExtrema);
-                unsigned char entireExtrema = extrema[0];
-                for (unsigned kernelIndex = 0; kernelIndex < extrema.size(); ++kernelIndex) {
-                    if ((m_type == FEMORPHOLOGY_OPERATOR_ERODE && extrema[kernelIndex] <= entireExtrema) ||
-                        (m_type == FEMORPHOLOGY_OPERATOR_DILATE && extrema[kernelIndex] >= entireExtrema))
-                        entireExtrema = extrema[kernelIndex];
-                }
-                dstPixelArray->set(y * effectWidth + 4 * x + channel, entireExtrema);
-            }
-        }
-    }
+
+    MorphologyPaintingData paintingData = { srcPixelArray->data(), dstPixelArray->data(), m_type,
+                                            effectDrawingRect.width(), effectDrawingRect.height(), radiusX, radiusY };
+    applyInRowBands(&applyToRowBand, &paintingData, effectDrawingRect.width(), effectDrawingRect.height());
 }
 
 void FEMorphology::dump()
@@ -194,6 +290,15 @@ static TextStream& operator<<(TextStream& ts, const MorphologyOperatorType& type
     return ts;
 }
 
+bool FEMorphology::addParametersToResultKey(FilterResultKey& key)
+{
+    key.add("feMorphology");
+    key.add(m_type);
+    key.add(m_radiusX);
+    key.add(m_radiusY);
+    return true;
+}
+
 TextStream& FEMorphology::externalRepresentation(TextStream& ts, int indent) const
 {
     writeIndent(ts, indent);
@@ -53,6 +53,16 @@ public:
 
     virtual TextStream& externalRepresentation(TextStream&, int indention) const;
 
+    virtual bool addParametersToResultKey(FilterResultKey&);
+
+    // Applies the operator to the rows [startY, endY) of a premultiplied image,
+    // using SSE2 or NEON when available. The result is always the same as
+    // platformApplyScalar.
+    static void platformApply(const unsigned char* srcPixels, unsigned char* dstPixels, MorphologyOperatorType,
+                              int width, int height, int radiusX, int radiusY, int startY, int endY);
+    static void platformApplyScalar(const unsigned char* srcPixels, unsigned char* dstPixels, MorphologyOperatorType,
+                                    int width, int height, int radiusX, int radiusY, int startY, int endY);
+
 private:
     FEMorphology(Filter*, MorphologyOperatorType, float radiusX, float radiusY);
     
@@ -27,6 +27,7 @@
 #include "FEOffset.h"
 
 #include "Filter.h"
+#include "FilterResultCache.h"
 #include "GraphicsContext.h"
 #include "RenderTreeAsText.h"
 #include "TextStream.h"
@@ -99,6 +100,14 @@ void FEOffset::dump()
 {
 }
 
+bool FEOffset::addParametersToResultKey(FilterResultKey& key)
+{
+    key.add("feOffset");
+    key.add(m_dx);
+    key.add(m_dy);
+    return true;
+}
+
 TextStream& FEOffset::externalRepresentation(TextStream& ts, int indent) const
 {
     writeIndent(ts, indent);
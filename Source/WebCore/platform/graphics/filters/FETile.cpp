@@ -25,6 +25,7 @@
 
 #include "AffineTransform.h"
 #include "Filter.h"
+#include "FilterResultCache.h"
 #include "GraphicsContext.h"
 #include "Pattern.h"
 #include "RenderTreeAsText.h"
@@ -94,6 +95,12 @@ void FETile::dump()
 {
 }
 
+bool FETile::addParametersToResultKey(FilterResultKey& key)
+{
+    key.add("feTile");
+    return true;
+}
+
 TextStream& FETile::externalRepresentation(TextStream& ts, int indent) const
 {
     writeIndent(ts, indent);
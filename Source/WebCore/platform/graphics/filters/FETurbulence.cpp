@@ -27,6 +27,7 @@
 #include "FETurbulence.h"
 
 #include "Filter.h"
+#include "FilterResultCache.h"
 #include "RenderTreeAsText.h"
 #include "TextStream.h"
 
@@ -275,33 +276,43 @@ float FETurbulence::noise2D(PaintingData& paintingData, const FloatPoint& noiseV
     return linearInterpolation(sy, a, b);
 }
 
-unsigned char FETurbulence::calculateTurbulenceValueForPoint(PaintingData& paintingData, const FloatPoint& point)
+// Adjusts the base frequencies if necessary for stitching. This is done once
+// before painting, as the rows may be painted on several threads.
+void FETurbulence::adjustBaseFrequencies(const PaintingData& paintingData)
 {
+    if (!m_stitchTiles)
+        return;
+
     float tileWidth = paintingData.filterSize.width();
     ASSERT(tileWidth > 0);
     float tileHeight = paintingData.filterSize.height();
     ASSERT(tileHeight > 0);
-    // Adjust the base frequencies if necessary for stitching.
+    // When stitching tiled turbulence, the frequencies must be adjusted
+    // so that the tile borders will be continuous.
+    if (m_baseFrequencyX) {
+        float lowFrequency = floorf(tileWidth * m_baseFrequencyX) / tileWidth;
+        float highFrequency = ceilf(tileWidth * m_baseFrequencyX) / tileWidth;
+        // BaseFrequency should be non-negative according to the standard.
+        if (m_baseFrequencyX / lowFrequency < highFrequency / m_baseFrequencyX)
+            m_baseFrequencyX = lowFrequency;
+        else
+            m_baseFrequencyX = highFrequency;
+    }
+    if (m_baseFrequencyY) {
+        float lowFrequency = floorf(tileHeight * m_baseFrequencyY) / tileHeight;
+        float highFrequency = ceilf(tileHeight * m_baseFrequencyY) / tileHeight;
+        if (m_baseFrequencyY / lowFrequency < highFrequency / m_baseFrequencyY)
+            m_baseFrequencyY = lowFrequency;
+        else
+            m_baseFrequencyY = highFrequency;
+    }
+}
+
+unsigned char FETurbulence::calculateTurbulenceValueForPoint(PaintingData& paintingData, const FloatPoint& point)
+{
     if (m_stitchTiles) {
-        // When stitching tiled turbulence, the frequencies must be adjusted
-        // so that the tile borders will be continuous.
-        if (m_baseFrequencyX) {
-            float lowFrequency = floorf(tileWidth * m_baseFrequencyX) / tileWidth;
-            float highFrequency = ceilf(tileWidth * m_baseFrequencyX) / tileWidth;
-            // BaseFrequency should be non-negative according to the standard.
-            if (m_baseFrequencyX / lowFrequency < highFrequency / m_baseFrequencyX)
-                m_baseFrequencyX = lowFrequency;
-            else
-                m_baseFrequencyX = highFrequency;
-        }
-        if (m_baseFrequencyY) {
-            float lowFrequency = floorf(tileHeight * m_baseFrequencyY) / tileHeight;
-            float highFrequency = ceilf(tileHeight * m_baseFrequencyY) / tileHeight;
-            if (m_baseFrequencyY / lowFrequency < highFrequency / m_baseFrequencyY)
-                m_baseFrequencyY = lowFrequency;
-            else
-                m_baseFrequencyY = highFrequency;
-        }
+        float tileWidth = paintingData.filterSize.width();
+        float tileHeight = paintingData.filterSize.height();
         // Set up TurbulenceInitial stitch values.
         paintingData.width = roundf(tileWidth * m_baseFrequencyX);
         paintingData.wrapX = s_perlinNoise + paintingData.width;
@@ -338,6 +349,30 @@ unsigned char FETurbulence::calculateTurbulenceValueForPoint(PaintingData& paint
     return static_cast<unsigned char>(turbulenceFunctionResult * 255);
 }
 
+void FETurbulence::fillRegion(ByteArray* pixelArray, PaintingData& paintingData, int startY, int endY)
+{
+    IntRect filterRegion = absolutePaintRect();
+    FloatPoint point(0, filterRegion.y() + startY);
+    int indexOfPixelChannel = startY * filterRegion.width() * 4;
+    for (int y = startY; y < endY; ++y) {
+        point.setY(point.y() + 1);
+        point.setX(filterRegion.x());
+        for (int x = 0; x < filterRegion.width(); ++x) {
+            point.setX(point.x() + 1);
+            for (paintingData.channel = 0; paintingData.channel < 4; ++paintingData.channel, ++indexOfPixelChannel)
+                pixelArray->set(indexOfPixelChannel, calculateTurbulenceValueForPoint(paintingData, filter()->mapAbsolutePointToLocalPoint(point)));
+        }
+    }
+}
+
+void FETurbulence::fillRegionWorker(void* parameters, int startY, int endY)
+{
+    FillRegionParameters* fillRegionParameters = static_cast<FillRegionParameters*>(parameters);
+    // The stitch values and the channel are updated while painting, so every band needs its own copy.
+    PaintingData paintingData = *fillRegionParameters->paintingData;
+    fillRegionParameters->filter->fillRegion(fillRegionParameters->pixelArray, paintingData, startY, endY);
+}
+
 void FETurbulence::apply()
 {
     if (hasResult())
@@ -351,20 +386,10 @@ void FETurbulence::apply()
 
     PaintingData paintingData(m_seed, roundedIntSize(filterPrimitiveSubregion().size()));
     initPaint(paintingData);
+    adjustBaseFrequencies(paintingData);
 
-    FloatRect filterRegion = absolutePaintRect();
-    FloatPoint point;
-    point.setY(filterRegion.y());
-    int indexOfPixelChannel = 0;
-    for (int y = 0; y < absolutePaintRect().height(); ++y) {
-        point.setY(point.y() + 1);
-        point.setX(filterRegion.x());
-        for (int x = 0; x < absolutePaintRect().width(); ++x) {
-            point.setX(point.x() + 1);
-            for (paintingData.channel = 0; paintingData.channel < 4; ++paintingData.channel, ++indexOfPixelChannel)
-                pixelArray->set(indexOfPixelChannel, calculateTurbulenceValueForPoint(paintingData, filter()->mapAbsolutePointToLocalPoint(point)));
-        }
-    }
+    FillRegionParameters parameters = { this, pixelArray, &paintingData };
+    applyInRowBands(&fillRegionWorker, &parameters, absolutePaintRect().width(), absolutePaintRect().height());
 }
 
 void FETurbulence::dump()
@@ -387,6 +412,18 @@ static TextStream& operator<<(TextStream& ts, const TurbulenceType& type)
     return ts;
 }
 
+bool FETurbulence::addParametersToResultKey(FilterResultKey& key)
+{
+    key.add("feTurbulence");
+    key.add(m_type);
+    key.add(m_baseFrequencyX);
+    key.add(m_baseFrequencyY);
+    key.add(m_numOctaves);
+    key.add(m_seed);
+    key.add(m_stitchTiles);
+    return true;
+}
+
 TextStream& FETurbulence::externalRepresentation(TextStream& ts, int indent) const
 {
     writeIndent(ts, indent);
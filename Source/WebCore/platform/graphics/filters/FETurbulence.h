@@ -65,6 +65,8 @@ public:
 
     virtual TextStream& externalRepresentation(TextStream&, int indention) const;
 
+    virtual bool addParametersToResultKey(FilterResultKey&);
+
 private:
     static const int s_blockSize = 256;
     static const int s_blockMask = s_blockSize - 1;
@@ -86,9 +88,19 @@ private:
 
     FETurbulence(Filter*, TurbulenceType, float, float, int, float, bool);
 
+    struct FillRegionParameters {
+        FETurbulence* filter;
+        ByteArray* pixelArray;
+        PaintingData* paintingData;
+    };
+
+    static void fillRegionWorker(void* parameters, int startY, int endY);
+
     inline void initPaint(PaintingData&);
+    void adjustBaseFrequencies(const PaintingData&);
     float noise2D(PaintingData&, const FloatPoint&);
     unsigned char calculateTurbulenceValueForPoint(PaintingData&, const FloatPoint&);
+    void fillRegion(ByteArray*, PaintingData&, int startY, int endY);
 
     TurbulenceType m_type;
     float m_baseFrequencyX;
@@ -36,11 +36,17 @@ namespace WebCore {
 
     class Filter : public RefCounted<Filter> {
     public:
+        Filter() : m_sourceImageIdentifier(0) { }
         virtual ~Filter() { }
 
         void setSourceImage(PassOwnPtr<ImageBuffer> sourceImage) { m_sourceImage = sourceImage; }
         ImageBuffer* sourceImage() { return m_sourceImage.get(); }
 
+        // Stands for the contents of the source image in FilterResultCache keys: two filters
+        // with the same non-zero identifier have the same source image. 0 if unknown.
+        unsigned sourceImageIdentifier() const { return m_sourceImageIdentifier; }
+        void setSourceImageIdentifier(unsigned identifier) { m_sourceImageIdentifier = identifier; }
+
         FloatSize filterResolution() const { return m_filterResolution; }
         void setFilterResolution(const FloatSize& filterResolution) { m_filterResolution = filterResolution; }
 
@@ -58,6 +64,7 @@ namespace WebCore {
 
     private:
         OwnPtr<ImageBuffer> m_sourceImage;
+        unsigned m_sourceImageIdentifier;
         FloatSize m_filterResolution;
     };
 
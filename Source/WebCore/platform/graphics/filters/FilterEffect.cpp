@@ -28,9 +28,25 @@
 #include "ImageBuffer.h"
 #include "TextStream.h"
 #include <wtf/ByteArray.h>
+#include <wtf/ParallelJobs.h>
 
 namespace WebCore {
 
+// Below this many pixels per band, waking a worker thread costs more than it saves.
+static const int minimalRowBandArea = 100 * 100;
+
+struct RowBand {
+    FilterEffect::RowBandFunction function;
+    void* context;
+    int startY;
+    int endY;
+};
+
+static void rowBandWorker(RowBand* band)
+{
+    band->function(band->context, band->startY, band->endY);
+}
+
 FilterEffect::FilterEffect(Filter* filter)
     : m_alphaImage(false)
     , m_filter(filter)
@@ -272,6 +288,28 @@ ByteArray* FilterEffect::createPremultipliedImageResult()
     return m_premultipliedImageResult.get();
 }
 
+void FilterEffect::applyInRowBands(RowBandFunction function, void* context, int width, int height)
+{
+    int requestedJobs = std::min(height, width * height / minimalRowBandArea);
+    if (requestedJobs <= 1) {
+        function(context, 0, height);
+        return;
+    }
+
+    ParallelJobs<RowBand> parallelJobs(&rowBandWorker, requestedJobs);
+    int numberOfJobs = parallelJobs.numberOfJobs();
+    int startY = 0;
+    for (int job = 0; job < numberOfJobs; ++job) {
+        RowBand& band = parallelJobs.parameter(job);
+        band.function = function;
+        band.context = context;
+        band.startY = startY;
+        startY = height * (job + 1) / numberOfJobs;
+        band.endY = startY;
+    }
+    parallelJobs.execute();
+}
+
 TextStream& FilterEffect::externalRepresentation(TextStream& ts, int) const
 {
     // FIXME: We should dump the subRegions of the filter primitives here later. This isn't
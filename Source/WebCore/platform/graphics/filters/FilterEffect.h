@@ -38,6 +38,7 @@ namespace WebCore {
 
 class Filter;
 class FilterEffect;
+class FilterResultKey;
 class ImageBuffer;
 class TextStream;
 
@@ -88,6 +89,18 @@ public:
 
     virtual TextStream& externalRepresentation(TextStream&, int indention = 0) const;
 
+    // Adds the parameters that the result depends on, other than the inputs and
+    // the filter, to |key|. Effects that can not tell return false, and their
+    // results are not cached.
+    virtual bool addParametersToResultKey(FilterResultKey&) { return false; }
+
+    // Runs |function| over the rows [0, height) of a |width| pixel wide image,
+    // split into disjoint bands. The bands are processed on worker threads when
+    // the image is large enough for that to pay off. Returns once every band
+    // is done.
+    typedef void (*RowBandFunction)(void* context, int startY, int endY);
+    static void applyInRowBands(RowBandFunction, void* context, int width, int height);
+
 public:
     // The following functions are SVG specific and will move to RenderSVGResourceFilterPrimitive.
     // See bug https://bugs.webkit.org/show_bug.cgi?id=45614.
@@ -119,6 +132,8 @@ protected:
     ByteArray* createPremultipliedImageResult();
 
 private:
+    friend class FilterResultCache;
+
     OwnPtr<ImageBuffer> m_imageBufferResult;
     RefPtr<ByteArray> m_unmultipliedImageResult;
     RefPtr<ByteArray> m_premultipliedImageResult;
@@ -0,0 +1,251 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#if ENABLE(FILTERS)
+#include "FilterResultCache.h"
+
+#include "Color.h"
+#include "Filter.h"
+#include "FilterEffect.h"
+#include "FloatPoint3D.h"
+#include "FloatRect.h"
+#include "ImageBuffer.h"
+#include <wtf/StdLibExtras.h>
+
+namespace WebCore {
+
+// Enough for the intermediate results of a few full screen filters on a phone.
+static const size_t defaultCapacity = 8 * 1024 * 1024;
+
+// Keys without a result still take up memory, so their number is capped too.
+static const unsigned maximumEntries = 512;
+
+void FilterResultKey::add(float value)
+{
+    union {
+        float value;
+        unsigned bits;
+    } floatBits;
+    floatBits.value = value;
+    m_words.append(floatBits.bits);
+}
+
+void FilterResultKey::add(const char* name)
+{
+    for (; *name; ++name)
+        m_words.append(static_cast<unsigned char>(*name));
+    m_words.append(0);
+}
+
+void FilterResultKey::add(const Color& color)
+{
+    m_words.append(color.rgb());
+}
+
+void FilterResultKey::add(const FloatPoint& point)
+{
+    add(point.x());
+    add(point.y());
+}
+
+void FilterResultKey::add(const FloatPoint3D& point)
+{
+    add(point.x());
+    add(point.y());
+    add(point.z());
+}
+
+void FilterResultKey::add(const FloatRect& rect)
+{
+    add(rect.location());
+    add(rect.width());
+    add(rect.height());
+}
+
+void FilterResultKey::add(const Vector<float>& values)
+{
+    m_words.append(values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+        add(values[i]);
+}
+
+// What an effect's result depends on besides its own parameters and inputs.
+static void addFilterToKey(FilterResultKey& key, FilterEffect* effect)
+{
+    Filter* filter = effect->filter();
+    key.add(filter->filterResolution().width());
+    key.add(filter->filterResolution().height());
+    key.add(filter->sourceImageRect());
+    key.add(filter->filterRegion());
+    key.add(filter->filterRegionInUserSpace());
+    key.add(filter->effectBoundingBoxMode());
+    key.add(filter->applyHorizontalScale(1));
+    key.add(filter->applyVerticalScale(1));
+    // Three points pin down the affine mapping to local coordinates.
+    key.add(filter->mapAbsolutePointToLocalPoint(FloatPoint()));
+    key.add(filter->mapAbsolutePointToLocalPoint(FloatPoint(1, 0)));
+    key.add(filter->mapAbsolutePointToLocalPoint(FloatPoint(0, 1)));
+
+    key.add(effect->maxEffectRect());
+    key.add(effect->filterPrimitiveSubregion());
+}
+
+FilterResultCache* FilterResultCache::shared()
+{
+    DEFINE_STATIC_LOCAL(FilterResultCache, cache, ());
+    return &cache;
+}
+
+FilterResultCache::FilterResultCache()
+    : m_size(0)
+    , m_capacity(defaultCapacity)
+    , m_lastId(0)
+{
+}
+
+void FilterResultCache::apply(FilterEffect* effect)
+{
+    EffectIdMap ids;
+    applyAndReturnId(effect, ids);
+    prune();
+}
+
+// Returns the id of the effect's key, or 0 if its result can not be cached.
+unsigned FilterResultCache::applyAndReturnId(FilterEffect* effect, EffectIdMap& ids)
+{
+    EffectIdMap::iterator it = ids.find(effect);
+    if (it != ids.end())
+        return it->second;
+
+    FilterResultKey key;
+    bool cacheable = effect->addParametersToResultKey(key);
+    // The inputs are brought up to date even if this effect can not be cached,
+    // so that they are found here next time.
+    unsigned numberOfInputs = effect->numberOfEffectInputs();
+    for (unsigned i = 0; i < numberOfInputs; ++i) {
+        unsigned inputId = applyAndReturnId(effect->inputEffect(i), ids);
+        cacheable = cacheable && inputId;
+        key.add(inputId);
+    }
+
+    unsigned id = 0;
+    if (cacheable) {
+        addFilterToKey(key, effect);
+        Entry* entry = entryForKey(key);
+        if (!effect->hasResult() && entry->pixels) {
+            effect->setAbsolutePaintRect(entry->absolutePaintRect);
+            effect->setIsAlphaImage(entry->alphaImage);
+            if (entry->premultiplied)
+                effect->m_premultipliedImageResult = entry->pixels;
+            else
+                effect->m_unmultipliedImageResult = entry->pixels;
+            ++m_statistics.hits;
+        } else {
+            if (!effect->hasResult())
+                ++m_statistics.misses;
+            effect->apply();
+            if (!entry->pixels)
+                store(entry, effect);
+        }
+        id = entry->id;
+    } else
+        effect->apply();
+
+    ids.set(effect, id);
+    return id;
+}
+
+FilterResultCache::Entry* FilterResultCache::entryForKey(const FilterResultKey& key)
+{
+    EntryMap::iterator it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        Entry* entry = it->second;
+        m_recentlyUsed.remove(entry);
+        m_recentlyUsed.add(entry);
+        return entry;
+    }
+
+    Entry* entry = new Entry(key, ++m_lastId);
+    m_entries.set(key, entry);
+    m_recentlyUsed.add(entry);
+    return entry;
+}
+
+void FilterResultCache::store(Entry* entry, FilterEffect* effect)
+{
+    if (!effect->hasResult())
+        return;
+
+    const IntRect& paintRect = effect->absolutePaintRect();
+    if (static_cast<size_t>(paintRect.width()) * paintRect.height() * 4 > m_capacity)
+        return;
+
+    // The byte arrays are not written to once an effect is applied, so they
+    // can be shared with the effect. An ImageBuffer is read back once, which
+    // also saves the effect's consumers from doing it.
+    if (!effect->m_premultipliedImageResult && !effect->m_unmultipliedImageResult)
+        effect->m_premultipliedImageResult = effect->m_imageBufferResult->getPremultipliedImageData(IntRect(IntPoint(), paintRect.size()));
+
+    if (effect->m_premultipliedImageResult) {
+        entry->pixels = effect->m_premultipliedImageResult;
+        entry->premultiplied = true;
+    } else
+        entry->pixels = effect->m_unmultipliedImageResult;
+    entry->alphaImage = effect->isAlphaImage();
+    entry->absolutePaintRect = paintRect;
+    m_size += entry->size();
+}
+
+void FilterResultCache::evict(Entry* entry)
+{
+    m_size -= entry->size();
+    m_entries.remove(entry->key);
+    m_recentlyUsed.remove(entry);
+    delete entry;
+}
+
+void FilterResultCache::prune()
+{
+    while (!m_recentlyUsed.isEmpty() && (m_size > m_capacity || m_entries.size() > maximumEntries))
+        evict(m_recentlyUsed.first());
+}
+
+void FilterResultCache::setCapacity(size_t capacity)
+{
+    m_capacity = capacity;
+    prune();
+}
+
+void FilterResultCache::evictAll()
+{
+    while (!m_recentlyUsed.isEmpty())
+        evict(m_recentlyUsed.first());
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(FILTERS)
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FilterResultCache_h
+#define FilterResultCache_h
+
+#if ENABLE(FILTERS)
+#include "IntRect.h"
+#include <wtf/ByteArray.h>
+#include <wtf/HashMap.h>
+#include <wtf/HashTraits.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/RefPtr.h>
+#include <wtf/StringHasher.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class Color;
+class FilterEffect;
+class FloatPoint;
+class FloatPoint3D;
+class FloatRect;
+
+// Everything that the result of a filter effect depends on, flattened into words.
+class FilterResultKey {
+public:
+    FilterResultKey()
+        : m_isDeletedValue(false)
+    {
+    }
+
+    FilterResultKey(WTF::HashTableDeletedValueType)
+        : m_isDeletedValue(true)
+    {
+    }
+
+    void add(int value) { m_words.append(value); }
+    void add(unsigned value) { m_words.append(value); }
+    void add(float);
+    void add(const char* name);
+    void add(const Color&);
+    void add(const FloatPoint&);
+    void add(const FloatPoint3D&);
+    void add(const FloatRect&);
+    void add(const Vector<float>&);
+
+    unsigned hash() const { return StringHasher::hashMemory(m_words.data(), m_words.size() * sizeof(unsigned)); }
+    bool isHashTableDeletedValue() const { return m_isDeletedValue; }
+
+    bool operator==(const FilterResultKey& other) const
+    {
+        return m_isDeletedValue == other.m_isDeletedValue && m_words == other.m_words;
+    }
+
+private:
+    Vector<unsigned> m_words;
+    bool m_isDeletedValue;
+};
+
+struct FilterResultKeyHash {
+    static unsigned hash(const FilterResultKey& key) { return key.hash(); }
+    static bool equal(const FilterResultKey& a, const FilterResultKey& b) { return a == b; }
+    static const bool safeToCompareToEmptyOrDeleted = true;
+};
+
+struct FilterResultKeyTraits : WTF::SimpleClassHashTraits<FilterResultKey> { };
+
+// Keeps the results of filter effects across filter graphs, so that repainting
+// a filtered element only runs the effects whose inputs or parameters changed.
+// An effect is keyed by its parameters, the filter's geometry and the keys of
+// its inputs, which come down to the filter's source image identifier. Results are
+// evicted least recently used first once they take more than the capacity.
+class FilterResultCache {
+public:
+    struct Statistics {
+        Statistics()
+            : hits(0)
+            , misses(0)
+        {
+        }
+
+        unsigned hits;
+        unsigned misses;
+    };
+
+    static FilterResultCache* shared();
+
+    // Brings |effect| and the inputs it needs up to date, like FilterEffect::apply().
+    void apply(FilterEffect*);
+
+    size_t capacity() const { return m_capacity; }
+    void setCapacity(size_t);
+    size_t size() const { return m_size; }
+    void evictAll();
+
+    const Statistics& statistics() const { return m_statistics; }
+
+private:
+    FilterResultCache();
+
+    struct Entry {
+        Entry(const FilterResultKey& key, unsigned id)
+            : key(key)
+            , id(id)
+            , premultiplied(false)
+            , alphaImage(false)
+        {
+        }
+
+        size_t size() const { return pixels ? pixels->length() : 0; }
+
+        FilterResultKey key;
+        // Stands for |key| in the keys of the effects that take this result as an input.
+        unsigned id;
+        RefPtr<ByteArray> pixels;
+        bool premultiplied;
+        bool alphaImage;
+        IntRect absolutePaintRect;
+    };
+
+    typedef HashMap<FilterEffect*, unsigned> EffectIdMap;
+    unsigned applyAndReturnId(FilterEffect*, EffectIdMap&);
+    Entry* entryForKey(const FilterResultKey&);
+    void store(Entry*, FilterEffect*);
+    void evict(Entry*);
+    void prune();
+
+    typedef HashMap<FilterResultKey, Entry*, FilterResultKeyHash, FilterResultKeyTraits> EntryMap;
+    EntryMap m_entries;
+    // Least recently used first.
+    ListHashSet<Entry*> m_recentlyUsed;
+    size_t m_size;
+    size_t m_capacity;
+    unsigned m_lastId;
+    Statistics m_statistics;
+};
+
+} // namespace WebCore
+
+#endif // ENABLE(FILTERS)
+
+#endif // FilterResultCache_h
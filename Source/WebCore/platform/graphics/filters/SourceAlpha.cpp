@@ -24,6 +24,7 @@
 
 #include "Color.h"
 #include "Filter.h"
+#include "FilterResultCache.h"
 #include "GraphicsContext.h"
 #include "PlatformString.h"
 #include "RenderTreeAsText.h"
@@ -75,6 +76,16 @@ void SourceAlpha::dump()
 {
 }
 
+bool SourceAlpha::addParametersToResultKey(FilterResultKey& key)
+{
+    unsigned sourceImageIdentifier = filter()->sourceImageIdentifier();
+    if (!sourceImageIdentifier)
+        return false;
+    key.add("SourceAlpha");
+    key.add(sourceImageIdentifier);
+    return true;
+}
+
 TextStream& SourceAlpha::externalRepresentation(TextStream& ts, int indent) const
 {
     writeIndent(ts, indent);
@@ -43,6 +43,8 @@ public:
 
     virtual TextStream& externalRepresentation(TextStream&, int indention) const;
 
+    virtual bool addParametersToResultKey(FilterResultKey&);
+
 private:
     SourceAlpha(Filter* filter)
         : FilterEffect(filter)
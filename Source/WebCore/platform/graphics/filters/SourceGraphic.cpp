@@ -23,6 +23,7 @@
 #include "SourceGraphic.h"
 
 #include "Filter.h"
+#include "FilterResultCache.h"
 #include "GraphicsContext.h"
 #include "PlatformString.h"
 #include "RenderTreeAsText.h"
@@ -67,6 +68,16 @@ void SourceGraphic::dump()
 {
 }
 
+bool SourceGraphic::addParametersToResultKey(FilterResultKey& key)
+{
+    unsigned sourceImageIdentifier = filter()->sourceImageIdentifier();
+    if (!sourceImageIdentifier)
+        return false;
+    key.add("SourceGraphic");
+    key.add(sourceImageIdentifier);
+    return true;
+}
+
 TextStream& SourceGraphic::externalRepresentation(TextStream& ts, int indent) const
 {
     writeIndent(ts, indent);
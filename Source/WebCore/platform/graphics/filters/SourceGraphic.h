@@ -44,6 +44,8 @@ public:
 
     virtual TextStream& externalRepresentation(TextStream&, int indention) const;
 
+    virtual bool addParametersToResultKey(FilterResultKey&);
+
 private:
     SourceGraphic(Filter* filter)
         : FilterEffect(filter)
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FEColorMatrixNEON_h
+#define FEColorMatrixNEON_h
+
+#include <wtf/Platform.h>
+
+#if HAVE(ARM_NEON_INTRINSICS)
+
+#include <arm_neon.h>
+
+namespace WebCore {
+
+// Same as the scalar fixed point code, eight pixels at a time. The sums are
+// exact, and narrowing with saturation clamps them like the scalar code does.
+// Returns the number of pixels done; the caller finishes the rest.
+template<int fractionBits>
+inline unsigned colorMatrixNEON(unsigned char* pixels, unsigned pixelCount, const short* coefficients, const int* offsets)
+{
+    unsigned i = 0;
+    for (; i + 8 <= pixelCount; i += 8, pixels += 32) {
+        uint8x8x4_t channels = vld4_u8(pixels);
+        int16x8_t inputs[4];
+        for (int channel = 0; channel < 4; ++channel)
+            inputs[channel] = vreinterpretq_s16_u16(vmovl_u8(channels.val[channel]));
+
+        for (int row = 0; row < 4; ++row) {
+            const short* m = coefficients + row * 4;
+            int32x4_t low = vdupq_n_s32(offsets[row]);
+            int32x4_t high = low;
+            for (int column = 0; column < 4; ++column) {
+                low = vmlal_n_s16(low, vget_low_s16(inputs[column]), m[column]);
+                high = vmlal_n_s16(high, vget_high_s16(inputs[column]), m[column]);
+            }
+            int16x8_t result = vcombine_s16(vqmovn_s32(vshrq_n_s32(low, fractionBits)), vqmovn_s32(vshrq_n_s32(high, fractionBits)));
+            channels.val[row] = vqmovun_s16(result);
+        }
+        vst4_u8(pixels, channels);
+    }
+    return i;
+}
+
+} // namespace WebCore
+
+#endif // HAVE(ARM_NEON_INTRINSICS)
+
+#endif // FEColorMatrixNEON_h
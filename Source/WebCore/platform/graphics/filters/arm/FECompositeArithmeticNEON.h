@@ -0,0 +1,79 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FECompositeArithmeticNEON_h
+#define FECompositeArithmeticNEON_h
+
+#include <wtf/Platform.h>
+
+#if HAVE(ARM_NEON_INTRINSICS)
+
+#include <arm_neon.h>
+
+namespace WebCore {
+
+static inline float32x4_t loadBytesNEON(const unsigned char* bytes)
+{
+    uint8x8_t loaded = vreinterpret_u8_u32(vld1_dup_u32(reinterpret_cast<const uint32_t*>(bytes)));
+    return vcvtq_f32_u32(vmovl_u16(vget_low_u16(vmovl_u8(loaded))));
+}
+
+// Same as the scalar computeArithmeticPixels, four bytes at a time, with the
+// terms added in the same order. |length| must be a multiple of four.
+template <int b1, int b4>
+inline void computeArithmeticPixelsNEON(const unsigned char* source, unsigned char* destination, unsigned length,
+                                        float k1, float k2, float k3, float k4)
+{
+    float32x4_t scaledK1 = vdupq_n_f32(k1 / 255.f);
+    float32x4_t k2Vector = vdupq_n_f32(k2);
+    float32x4_t k3Vector = vdupq_n_f32(k3);
+    float32x4_t scaledK4 = vdupq_n_f32(k4 * 255.f);
+    float32x4_t zero = vdupq_n_f32(0);
+    float32x4_t maxValue = vdupq_n_f32(255);
+
+    for (unsigned i = 0; i < length; i += 4) {
+        float32x4_t i1 = loadBytesNEON(source + i);
+        float32x4_t i2 = loadBytesNEON(destination + i);
+
+        float32x4_t result = zero;
+        if (b1)
+            result = vaddq_f32(result, vmulq_f32(vmulq_f32(scaledK1, i1), i2));
+        result = vaddq_f32(result, vmulq_f32(k2Vector, i1));
+        result = vaddq_f32(result, vmulq_f32(k3Vector, i2));
+        if (b4)
+            result = vaddq_f32(result, scaledK4);
+        result = vminq_f32(vmaxq_f32(result, zero), maxValue);
+
+        uint16x4_t narrow = vmovn_u32(vcvtq_u32_f32(result));
+        uint8x8_t bytes = vmovn_u16(vcombine_u16(narrow, narrow));
+        vst1_lane_u32(reinterpret_cast<uint32_t*>(destination + i), vreinterpret_u32_u8(bytes), 0);
+    }
+}
+
+} // namespace WebCore
+
+#endif // HAVE(ARM_NEON_INTRINSICS)
+
+#endif // FECompositeArithmeticNEON_h
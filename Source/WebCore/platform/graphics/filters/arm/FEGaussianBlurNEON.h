@@ -0,0 +1,92 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FEGaussianBlurNEON_h
+#define FEGaussianBlurNEON_h
+
+#include <wtf/Platform.h>
+
+#if HAVE(ARM_NEON_INTRINSICS)
+
+#include <arm_neon.h>
+
+namespace WebCore {
+
+static inline uint32x4_t loadPixelNEON(const unsigned char* pixel)
+{
+    uint8x8_t bytes = vreinterpret_u8_u32(vld1_dup_u32(reinterpret_cast<const uint32_t*>(pixel)));
+    return vmovl_u16(vget_low_u16(vmovl_u8(bytes)));
+}
+
+// Divides the channel sums by the kernel size. The quotient is estimated with
+// a float reciprocal and corrected by one when the remainder is out of range,
+// so that it always matches the integer division of the scalar code.
+static inline void storePixelNEON(unsigned char* pixel, uint32x4_t sum, float32x4_t divisor, float32x4_t reciprocal)
+{
+    float32x4_t sumFloat = vcvtq_f32_u32(sum);
+    uint32x4_t quotient = vcvtq_u32_f32(vmulq_f32(sumFloat, reciprocal));
+    float32x4_t remainder = vsubq_f32(sumFloat, vmulq_f32(vcvtq_f32_u32(quotient), divisor));
+    // The comparisons yield all ones, that is -1, in the lanes to adjust.
+    quotient = vsubq_u32(quotient, vcgeq_f32(remainder, divisor));
+    quotient = vaddq_u32(quotient, vcltq_f32(remainder, vdupq_n_f32(0)));
+
+    uint16x4_t narrow = vmovn_u32(quotient);
+    uint8x8_t bytes = vmovn_u16(vcombine_u16(narrow, narrow));
+    vst1_lane_u32(reinterpret_cast<uint32_t*>(pixel), vreinterpret_u32_u8(bytes), 0);
+}
+
+// Same as the scalar box blur, but keeps the sums of all four channels of a
+// pixel in one register.
+inline void boxBlurNEON(const unsigned char* srcPixels, unsigned char* dstPixels,
+                        unsigned dx, int dxLeft, int dxRight, int stride, int strideLine, int effectWidth, int startLine, int endLine)
+{
+    float32x4_t divisor = vdupq_n_f32(dx);
+    float32x4_t reciprocal = vdupq_n_f32(1.0f / dx);
+    int maxKernelSize = std::min(dxRight, effectWidth);
+
+    for (int y = startLine; y < endLine; ++y) {
+        const unsigned char* srcLine = srcPixels + y * strideLine;
+        unsigned char* dstLine = dstPixels + y * strideLine;
+
+        uint32x4_t sum = vdupq_n_u32(0);
+        for (int i = 0; i < maxKernelSize; ++i)
+            sum = vaddq_u32(sum, loadPixelNEON(srcLine + i * stride));
+
+        for (int x = 0; x < effectWidth; ++x) {
+            int pixelByteOffset = x * stride;
+            storePixelNEON(dstLine + pixelByteOffset, sum, divisor, reciprocal);
+            if (x >= dxLeft)
+                sum = vsubq_u32(sum, loadPixelNEON(srcLine + pixelByteOffset - dxLeft * stride));
+            if (x + dxRight < effectWidth)
+                sum = vaddq_u32(sum, loadPixelNEON(srcLine + pixelByteOffset + dxRight * stride));
+        }
+    }
+}
+
+} // namespace WebCore
+
+#endif // HAVE(ARM_NEON_INTRINSICS)
+
+#endif // FEGaussianBlurNEON_h
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FEColorMatrixSSE2_h
+#define FEColorMatrixSSE2_h
+
+#ifdef __SSE2__
+
+#include <emmintrin.h>
+
+namespace WebCore {
+
+// Transforms one pixel, repeated in both halves of |pixel| as 16-bit values.
+// |rows01| and |rows23| hold two rows of the matrix each.
+template<int fractionBits>
+static inline __m128i colorMatrixPixelSSE2(__m128i pixel, __m128i rows01, __m128i rows23, __m128i offsets)
+{
+    // Each product pair is { red and green, blue and alpha } of a row; reorder
+    // them so that the two halves of all four rows can be added.
+    __m128i products01 = _mm_shuffle_epi32(_mm_madd_epi16(pixel, rows01), _MM_SHUFFLE(3, 1, 2, 0));
+    __m128i products23 = _mm_shuffle_epi32(_mm_madd_epi16(pixel, rows23), _MM_SHUFFLE(3, 1, 2, 0));
+    __m128i sum = _mm_add_epi32(_mm_unpacklo_epi64(products01, products23), _mm_unpackhi_epi64(products01, products23));
+    return _mm_srai_epi32(_mm_add_epi32(sum, offsets), fractionBits);
+}
+
+// Same as the scalar fixed point code, four pixels at a time. The sums are
+// exact, and packing with saturation clamps them like the scalar code does.
+// Returns the number of pixels done; the caller finishes the rest.
+template<int fractionBits>
+inline unsigned colorMatrixSSE2(unsigned char* pixels, unsigned pixelCount, const short* coefficients, const int* offsets)
+{
+    __m128i rows01 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(coefficients));
+    __m128i rows23 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(coefficients + 8));
+    __m128i offsetVector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(offsets));
+    __m128i zero = _mm_setzero_si128();
+
+    unsigned i = 0;
+    for (; i + 4 <= pixelCount; i += 4, pixels += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+        __m128i pixels01 = _mm_unpacklo_epi8(bytes, zero);
+        __m128i pixels23 = _mm_unpackhi_epi8(bytes, zero);
+
+        __m128i result01 = _mm_packs_epi32(colorMatrixPixelSSE2<fractionBits>(_mm_unpacklo_epi64(pixels01, pixels01), rows01, rows23, offsetVector),
+                                           colorMatrixPixelSSE2<fractionBits>(_mm_unpackhi_epi64(pixels01, pixels01), rows01, rows23, offsetVector));
+        __m128i result23 = _mm_packs_epi32(colorMatrixPixelSSE2<fractionBits>(_mm_unpacklo_epi64(pixels23, pixels23), rows01, rows23, offsetVector),
+                                           colorMatrixPixelSSE2<fractionBits>(_mm_unpackhi_epi64(pixels23, pixels23), rows01, rows23, offsetVector));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), _mm_packus_epi16(result01, result23));
+    }
+    return i;
+}
+
+} // namespace WebCore
+
+#endif // __SSE2__
+
+#endif // FEColorMatrixSSE2_h
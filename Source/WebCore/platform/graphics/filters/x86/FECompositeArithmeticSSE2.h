@@ -0,0 +1,77 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FECompositeArithmeticSSE2_h
+#define FECompositeArithmeticSSE2_h
+
+#ifdef __SSE2__
+
+#include <emmintrin.h>
+
+namespace WebCore {
+
+static inline __m128 loadBytesSSE2(const unsigned char* bytes)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i loaded = _mm_cvtsi32_si128(*reinterpret_cast<const int*>(bytes));
+    return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(loaded, zero), zero));
+}
+
+// Same as the scalar computeArithmeticPixels, four bytes at a time, with the
+// terms added in the same order. |length| must be a multiple of four.
+template <int b1, int b4>
+inline void computeArithmeticPixelsSSE2(const unsigned char* source, unsigned char* destination, unsigned length,
+                                        float k1, float k2, float k3, float k4)
+{
+    __m128 scaledK1 = _mm_set1_ps(k1 / 255.f);
+    __m128 k2Vector = _mm_set1_ps(k2);
+    __m128 k3Vector = _mm_set1_ps(k3);
+    __m128 scaledK4 = _mm_set1_ps(k4 * 255.f);
+    __m128 zero = _mm_setzero_ps();
+    __m128 maxValue = _mm_set1_ps(255);
+
+    for (unsigned i = 0; i < length; i += 4) {
+        __m128 i1 = loadBytesSSE2(source + i);
+        __m128 i2 = loadBytesSSE2(destination + i);
+
+        __m128 result = zero;
+        if (b1)
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(scaledK1, i1), i2));
+        result = _mm_add_ps(result, _mm_mul_ps(k2Vector, i1));
+        result = _mm_add_ps(result, _mm_mul_ps(k3Vector, i2));
+        if (b4)
+            result = _mm_add_ps(result, scaledK4);
+        result = _mm_min_ps(_mm_max_ps(result, zero), maxValue);
+
+        __m128i narrow = _mm_packs_epi32(_mm_cvttps_epi32(result), _mm_setzero_si128());
+        *reinterpret_cast<int*>(destination + i) = _mm_cvtsi128_si32(_mm_packus_epi16(narrow, narrow));
+    }
+}
+
+} // namespace WebCore
+
+#endif // __SSE2__
+
+#endif // FECompositeArithmeticSSE2_h
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FEGaussianBlurSSE2_h
+#define FEGaussianBlurSSE2_h
+
+#ifdef __SSE2__
+
+#include <emmintrin.h>
+
+namespace WebCore {
+
+static inline __m128i loadPixelSSE2(const unsigned char* pixel)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i bytes = _mm_cvtsi32_si128(*reinterpret_cast<const int*>(pixel));
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero);
+}
+
+// Divides the channel sums by the kernel size. The quotient is estimated with
+// a float reciprocal and corrected by one when the remainder is out of range,
+// so that it always matches the integer division of the scalar code.
+static inline void storePixelSSE2(unsigned char* pixel, __m128i sum, __m128 divisor, __m128 reciprocal)
+{
+    __m128 sumFloat = _mm_cvtepi32_ps(sum);
+    __m128i quotient = _mm_cvttps_epi32(_mm_mul_ps(sumFloat, reciprocal));
+    __m128 remainder = _mm_sub_ps(sumFloat, _mm_mul_ps(_mm_cvtepi32_ps(quotient), divisor));
+    // The comparisons yield all ones, that is -1, in the lanes to adjust.
+    quotient = _mm_sub_epi32(quotient, _mm_castps_si128(_mm_cmpge_ps(remainder, divisor)));
+    quotient = _mm_add_epi32(quotient, _mm_castps_si128(_mm_cmplt_ps(remainder, _mm_setzero_ps())));
+
+    __m128i narrow = _mm_packs_epi32(quotient, quotient);
+    *reinterpret_cast<int*>(pixel) = _mm_cvtsi128_si32(_mm_packus_epi16(narrow, narrow));
+}
+
+// Same as the scalar box blur, but keeps the sums of all four channels of a
+// pixel in one register.
+inline void boxBlurSSE2(const unsigned char* srcPixels, unsigned char* dstPixels,
+                        unsigned dx, int dxLeft, int dxRight, int stride, int strideLine, int effectWidth, int startLine, int endLine)
+{
+    __m128 divisor = _mm_set1_ps(dx);
+    __m128 reciprocal = _mm_set1_ps(1.0f / dx);
+    int maxKernelSize = std::min(dxRight, effectWidth);
+
+    for (int y = startLine; y < endLine; ++y) {
+        const unsigned char* srcLine = srcPixels + y * strideLine;
+        unsigned char* dstLine = dstPixels + y * strideLine;
+
+        __m128i sum = _mm_setzero_si128();
+        for (int i = 0; i < maxKernelSize; ++i)
+            sum = _mm_add_epi32(sum, loadPixelSSE2(srcLine + i * stride));
+
+        for (int x = 0; x < effectWidth; ++x) {
+            int pixelByteOffset = x * stride;
+            storePixelSSE2(dstLine + pixelByteOffset, sum, divisor, reciprocal);
+            if (x >= dxLeft)
+                sum = _mm_sub_epi32(sum, loadPixelSSE2(srcLine + pixelByteOffset - dxLeft * stride));
+            if (x + dxRight < effectWidth)
+                sum = _mm_add_epi32(sum, loadPixelSSE2(srcLine + pixelByteOffset + dxRight * stride));
+        }
+    }
+}
+
+} // namespace WebCore
+
+#endif // __SSE2__
+
+#endif // FEGaussianBlurSSE2_h
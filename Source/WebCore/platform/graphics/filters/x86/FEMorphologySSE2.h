@@ -0,0 +1,75 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FEMorphologySSE2_h
+#define FEMorphologySSE2_h
+
+#ifdef __SSE2__
+
+#include <emmintrin.h>
+
+namespace WebCore {
+
+template<bool erode>
+static inline __m128i extremaSSE2(__m128i a, __m128i b)
+{
+    return erode ? _mm_min_epu8(a, b) : _mm_max_epu8(a, b);
+}
+
+// Folds |row| into the column extrema, 16 bytes at a time. Returns the number
+// of bytes done; the caller finishes the rest.
+template<bool erode>
+inline int columnExtremaSSE2(unsigned char* extrema, const unsigned char* row, int length)
+{
+    int i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i* extremaP = reinterpret_cast<__m128i*>(extrema + i);
+        __m128i rowBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+        _mm_storeu_si128(extremaP, extremaSSE2<erode>(_mm_loadu_si128(extremaP), rowBytes));
+    }
+    return i;
+}
+
+// Computes the pixels from x up to endX four at a time, for pixels whose
+// window is the full [x - radiusX, x + radiusX]. Returns the first pixel that
+// is not done.
+template<bool erode>
+inline int rowExtremaSSE2(unsigned char* dstPixels, const unsigned char* extrema, int x, int endX, int radiusX)
+{
+    for (; x + 4 <= endX; x += 4) {
+        const unsigned char* window = extrema + (x - radiusX) * 4;
+        __m128i result = _mm_loadu_si128(reinterpret_cast<const __m128i*>(window));
+        for (int i = 1; i <= 2 * radiusX; ++i)
+            result = extremaSSE2<erode>(result, _mm_loadu_si128(reinterpret_cast<const __m128i*>(window + i * 4)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dstPixels + x * 4), result);
+    }
+    return x;
+}
+
+} // namespace WebCore
+
+#endif // __SSE2__
+
+#endif // FEMorphologySSE2_h
@@ -30,6 +30,11 @@
 #include <wtf/RefCounted.h>
 #include <wtf/RefPtr.h>
 
+#if PLATFORM(ANDROID)
+#include "SharedBuffer.h"
+#include <wtf/Vector.h>
+#endif
+
 #if USE(CFNETWORK)
 #include <ConditionalMacros.h>
 #include <CFNetwork/CFURLCachePriv.h>
@@ -83,6 +88,13 @@ namespace WebCore {
         virtual void didReceiveDataArray(ResourceHandle*, CFArrayRef) { }
 #endif
 
+#if PLATFORM(ANDROID)
+        // Clients that return true are handed the network buffers themselves
+        // and may keep references to them instead of copying the bytes.
+        virtual bool supportsDataSegments() { return false; }
+        virtual void didReceiveDataSegments(ResourceHandle*, const Vector<RefPtr<SharedBuffer::DataSegment> >&) { }
+#endif
+
         virtual void willCacheResponse(ResourceHandle*, CacheStoragePolicy&) { }
 
         virtual bool shouldUseCredentialStorage(ResourceHandle*) { return false; }
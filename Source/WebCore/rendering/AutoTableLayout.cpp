@@ -35,6 +35,8 @@ AutoTableLayout::AutoTableLayout(RenderTable* table)
     : TableLayout(table)
     , m_hasPercent(false)
     , m_effectiveLogicalWidthDirty(true)
+    , m_needsFullRecalc(true)
+    , m_hasDirtyColumns(false)
 {
 }
 
@@ -42,10 +44,30 @@ AutoTableLayout::~AutoTableLayout()
 {
 }
 
-void AutoTableLayout::recalcColumn(int effCol)
+void AutoTableLayout::cellPreferredLogicalWidthsChanged(int effCol)
+{
+    if (m_needsFullRecalc)
+        return;
+    if (effCol < 0 || static_cast<size_t>(effCol) >= m_layoutStruct.size()) {
+        m_needsFullRecalc = true;
+        return;
+    }
+    m_layoutStruct[effCol].needsRecalc = true;
+    m_hasDirtyColumns = true;
+}
+
+void AutoTableLayout::recalcColumn(int effCol, bool collectSpanCells)
 {
     Layout& columnLayout = m_layoutStruct[effCol];
 
+    // Start over from the width given to the column by a <col> element.
+    Length columnElementLogicalWidth = columnLayout.columnElementLogicalWidth;
+    columnLayout = Layout();
+    columnLayout.columnElementLogicalWidth = columnElementLogicalWidth;
+    columnLayout.logicalWidth = columnElementLogicalWidth;
+    if (columnElementLogicalWidth.isFixed())
+        columnLayout.maxLogicalWidth = max(columnLayout.maxLogicalWidth, columnElementLogicalWidth.value());
+
     RenderTableCell* fixedContributor = 0;
     RenderTableCell* maxContributor = 0;
 
@@ -104,7 +126,7 @@ void AutoTableLayout::recalcColumn(int effCol)
                         }
                         break;
                     case Percent:
-                        m_hasPercent = true;
+                        columnLayout.hasPercentCell = true;
                         if (cellLogicalWidth.isPositive() && (!columnLayout.logicalWidth.isPercent() || cellLogicalWidth.value() > columnLayout.logicalWidth.value()))
                             columnLayout.logicalWidth = cellLogicalWidth;
                         break;
@@ -121,7 +143,8 @@ void AutoTableLayout::recalcColumn(int effCol)
                     // a min/max width of at least 1px for this column now.
                     columnLayout.minLogicalWidth = max(columnLayout.minLogicalWidth, cellHasContent ? 1 : 0);
                     columnLayout.maxLogicalWidth = max(columnLayout.maxLogicalWidth, 1);
-                    insertSpanCell(cell);
+                    if (collectSpanCells)
+                        insertSpanCell(cell);
                 }
             }
         }
@@ -140,7 +163,8 @@ void AutoTableLayout::recalcColumn(int effCol)
 
 void AutoTableLayout::fullRecalc()
 {
-    m_hasPercent = false;
+    m_needsFullRecalc = false;
+    m_hasDirtyColumns = false;
     m_effectiveLogicalWidthDirty = true;
 
     int nEffCols = m_table->numEffCols();
@@ -163,11 +187,8 @@ void AutoTableLayout::fullRecalc()
             if ((colLogicalWidth.isFixed() || colLogicalWidth.isPercent()) && colLogicalWidth.isZero())
                 colLogicalWidth = Length();
             int effCol = m_table->colToEffCol(currentColumn);
-            if (!colLogicalWidth.isAuto() && span == 1 && effCol < nEffCols && m_table->spanOfEffCol(effCol) == 1) {
-                m_layoutStruct[effCol].logicalWidth = colLogicalWidth;
-                if (colLogicalWidth.isFixed() && m_layoutStruct[effCol].maxLogicalWidth < colLogicalWidth.value())
-                    m_layoutStruct[effCol].maxLogicalWidth = colLogicalWidth.value();
-            }
+            if (!colLogicalWidth.isAuto() && span == 1 && effCol < nEffCols && m_table->spanOfEffCol(effCol) == 1)
+                m_layoutStruct[effCol].columnElementLogicalWidth = colLogicalWidth;
             currentColumn += span;
         }
 
@@ -181,8 +202,44 @@ void AutoTableLayout::fullRecalc()
         child = next;
     }
 
-    for (int i = 0; i < nEffCols; i++)
+    m_hasPercent = false;
+    for (int i = 0; i < nEffCols; i++) {
         recalcColumn(i);
+        if (m_layoutStruct[i].hasPercentCell)
+            m_hasPercent = true;
+    }
+}
+
+bool AutoTableLayout::columnElementsNeedRecalc() const
+{
+    for (RenderObject* child = m_table->firstChild(); child; child = child->nextSibling()) {
+        if (!child->isTableCol())
+            continue;
+        if (child->preferredLogicalWidthsDirty())
+            return true;
+        for (RenderObject* col = child->firstChild(); col; col = col->nextSibling()) {
+            if (col->preferredLogicalWidthsDirty())
+                return true;
+        }
+    }
+    return false;
+}
+
+// Only the columns holding a cell whose preferred widths changed are walked
+// again. The spanning cells are kept from the last full recalc, since any
+// change to the spans or to the grid goes through setNeedsFullRecalc().
+void AutoTableLayout::recalcDirtyColumns()
+{
+    m_hasDirtyColumns = false;
+    m_effectiveLogicalWidthDirty = true;
+
+    m_hasPercent = false;
+    for (size_t i = 0; i < m_layoutStruct.size(); ++i) {
+        if (m_layoutStruct[i].needsRecalc)
+            recalcColumn(i, false);
+        if (m_layoutStruct[i].hasPercentCell)
+            m_hasPercent = true;
+    }
 }
 
 // FIXME: This needs to be adapted for vertical writing modes.
@@ -221,7 +278,12 @@ static bool shouldScaleColumns(RenderTable* table)
 
 void AutoTableLayout::computePreferredLogicalWidths(int& minWidth, int& maxWidth)
 {
-    fullRecalc();
+    // With collapsed borders a cell's border box also depends on its neighbours,
+    // which do not mark it dirty when they change.
+    if (m_needsFullRecalc || m_table->collapseBorders() || static_cast<size_t>(m_table->numEffCols()) != m_layoutStruct.size() || columnElementsNeedRecalc())
+        fullRecalc();
+    else if (m_hasDirtyColumns)
+        recalcDirtyColumns();
 
     int spanMaxLogicalWidth = calcEffectiveLogicalWidth();
     minWidth = 0;
@@ -286,6 +348,7 @@ int AutoTableLayout::calcEffectiveLogicalWidth()
         m_layoutStruct[i].effectiveLogicalWidth = m_layoutStruct[i].logicalWidth;
         m_layoutStruct[i].effectiveMinLogicalWidth = m_layoutStruct[i].minLogicalWidth;
         m_layoutStruct[i].effectiveMaxLogicalWidth = m_layoutStruct[i].maxLogicalWidth;
+        m_layoutStruct[i].effectiveEmptyCellsOnly = m_layoutStruct[i].emptyCellsOnly;
     }
 
     for (size_t i = 0; i < m_spanCells.size(); ++i) {
@@ -345,7 +408,7 @@ int AutoTableLayout::calcEffectiveLogicalWidth()
                     totalPercent += columnLayout.effectiveLogicalWidth.percent();
                 allColsAreFixed = false;
             }
-            if (!columnLayout.emptyCellsOnly)
+            if (!columnLayout.effectiveEmptyCellsOnly)
                 spanHasEmptyCellsOnly = false;
             span -= m_table->spanOfEffCol(lastCol);
             spanMinLogicalWidth += columnLayout.effectiveMinLogicalWidth;
@@ -438,7 +501,7 @@ int AutoTableLayout::calcEffectiveLogicalWidth()
         // treat span ranges consisting of empty cells only as if they had content
         if (spanHasEmptyCellsOnly) {
             for (unsigned pos = effCol; pos < lastCol; ++pos)
-                m_layoutStruct[pos].emptyCellsOnly = false;
+                m_layoutStruct[pos].effectiveEmptyCellsOnly = false;
         }
     }
     m_effectiveLogicalWidthDirty = false;
@@ -522,7 +585,7 @@ void AutoTableLayout::layout()
             // fall through
             break;
         case Auto:
-            if (m_layoutStruct[i].emptyCellsOnly)
+            if (m_layoutStruct[i].effectiveEmptyCellsOnly)
                 numAutoEmptyCellsOnly++;
             else {
                 numAuto++;
@@ -591,7 +654,7 @@ void AutoTableLayout::layout()
         available += allocAuto; // this gets redistributed
         for (size_t i = 0; i < nEffCols; ++i) {
             Length& logicalWidth = m_layoutStruct[i].effectiveLogicalWidth;
-            if (logicalWidth.isAuto() && totalAuto && !m_layoutStruct[i].emptyCellsOnly) {
+            if (logicalWidth.isAuto() && totalAuto && !m_layoutStruct[i].effectiveEmptyCellsOnly) {
                 int cellLogicalWidth = max(m_layoutStruct[i].computedLogicalWidth, static_cast<int>(available * static_cast<float>(m_layoutStruct[i].effectiveMaxLogicalWidth) / totalAuto));
                 available -= cellLogicalWidth;
                 totalAuto -= m_layoutStruct[i].effectiveMaxLogicalWidth;
@@ -634,7 +697,7 @@ void AutoTableLayout::layout()
         // still have some width to spread
         for (int i = nEffCols - 1; i >= 0; --i) {
             // variable columns with empty cells only don't get any width
-            if (m_layoutStruct[i].effectiveLogicalWidth.isAuto() && m_layoutStruct[i].emptyCellsOnly)
+            if (m_layoutStruct[i].effectiveLogicalWidth.isAuto() && m_layoutStruct[i].effectiveEmptyCellsOnly)
                 continue;
             int cellLogicalWidth = available / total;
             available -= cellLogicalWidth;
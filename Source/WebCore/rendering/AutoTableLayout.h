@@ -38,9 +38,14 @@ public:
     virtual void computePreferredLogicalWidths(int& minWidth, int& maxWidth);
     virtual void layout();
 
+    virtual void cellPreferredLogicalWidthsChanged(int effCol);
+    virtual void setNeedsFullRecalc() { m_needsFullRecalc = true; }
+
 private:
     void fullRecalc();
-    void recalcColumn(int effCol);
+    void recalcDirtyColumns();
+    void recalcColumn(int effCol, bool collectSpanCells = true);
+    bool columnElementsNeedRecalc() const;
 
     int calcEffectiveLogicalWidth();
 
@@ -54,9 +59,13 @@ private:
             , effectiveMaxLogicalWidth(0)
             , computedLogicalWidth(0)
             , emptyCellsOnly(true)
+            , effectiveEmptyCellsOnly(true)
+            , hasPercentCell(false)
+            , needsRecalc(false)
         {
         }
 
+        Length columnElementLogicalWidth;
         Length logicalWidth;
         Length effectiveLogicalWidth;
         int minLogicalWidth;
@@ -65,12 +74,17 @@ private:
         int effectiveMaxLogicalWidth;
         int computedLogicalWidth;
         bool emptyCellsOnly;
+        bool effectiveEmptyCellsOnly;
+        bool hasPercentCell;
+        bool needsRecalc;
     };
 
     Vector<Layout, 4> m_layoutStruct;
     Vector<RenderTableCell*, 4> m_spanCells;
     bool m_hasPercent : 1;
     mutable bool m_effectiveLogicalWidthDirty : 1;
+    bool m_needsFullRecalc : 1;
+    bool m_hasDirtyColumns : 1;
 };
 
 } // namespace WebCore
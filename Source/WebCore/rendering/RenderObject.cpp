@@ -578,6 +578,8 @@ void RenderObject::setPreferredLogicalWidthsDirty(bool b, bool markParents)
 {
     bool alreadyDirty = m_preferredLogicalWidthsDirty;
     m_preferredLogicalWidthsDirty = b;
+    if (b && !alreadyDirty && isTableCell())
+        toRenderTableCell(this)->preferredLogicalWidthsBecameDirty();
     if (b && !alreadyDirty && markParents && (isText() || (style()->position() != FixedPosition && style()->position() != AbsolutePosition)))
         invalidateContainerPreferredLogicalWidths();
 }
@@ -595,6 +597,8 @@ void RenderObject::invalidateContainerPreferredLogicalWidths()
             break;
 
         o->m_preferredLogicalWidthsDirty = true;
+        if (o->isTableCell())
+            toRenderTableCell(o)->preferredLogicalWidthsBecameDirty();
         if (o->style()->position() == FixedPosition || o->style()->position() == AbsolutePosition)
             // A positioned object has no effect on the min/max width of its containing block ever.
             // We can optimize this case and not go up any further.
@@ -659,6 +659,15 @@ void RenderTable::computePreferredLogicalWidths()
     setPreferredLogicalWidthsDirty(false);
 }
 
+void RenderTable::cellPreferredLogicalWidthsChanged(const RenderTableCell* cell)
+{
+    // Until the sections are recalculated the cell's column may be stale, and
+    // recalculating them makes the table layout start over anyway.
+    if (m_needsSectionRecalc || !m_tableLayout)
+        return;
+    m_tableLayout->cellPreferredLogicalWidthsChanged(colToEffCol(cell->col()));
+}
+
 void RenderTable::splitColumn(int pos, int firstSpan)
 {
     // we need to add a new columnStruct
@@ -838,6 +847,10 @@ void RenderTable::recalcSections() const
     m_columns.resize(maxCols);
     m_columnPos.resize(maxCols + 1);
 
+    // Rows, cells or spans may have come and gone.
+    if (m_tableLayout)
+        m_tableLayout->setNeedsFullRecalc();
+
     ASSERT(selfNeedsLayout());
 
     m_needsSectionRecalc = false;
@@ -196,6 +196,10 @@ public:
     
     bool hasSections() const { return m_head || m_foot || m_firstBody; }
 
+    // Called when the preferred widths of a cell become dirty, so that the
+    // table layout only has to recompute the column holding it.
+    void cellPreferredLogicalWidthsChanged(const RenderTableCell*);
+
     void recalcSectionsIfNeeded() const
     {
         if (m_needsSectionRecalc)
@@ -149,6 +149,14 @@ void RenderTableCell::computePreferredLogicalWidths()
     }
 }
 
+void RenderTableCell::preferredLogicalWidthsBecameDirty()
+{
+    // Cells that are not in a table yet are picked up when the sections are recalculated.
+    if (!parent() || !parent()->parent() || !parent()->parent()->parent() || documentBeingDestroyed())
+        return;
+    table()->cellPreferredLogicalWidthsChanged(this);
+}
+
 void RenderTableCell::computeLogicalWidth()
 {
 #ifdef ANDROID_LAYOUT
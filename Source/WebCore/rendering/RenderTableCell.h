@@ -54,6 +54,7 @@ public:
     Length styleOrColLogicalWidth() const;
 
     virtual void computePreferredLogicalWidths();
+    void preferredLogicalWidthsBecameDirty();
 
     void updateLogicalWidth(int);
 
@@ -41,6 +41,10 @@ public:
     virtual void computePreferredLogicalWidths(int& minWidth, int& maxWidth) = 0;
     virtual void layout() = 0;
 
+    // Let a layout that keeps per column state recompute only what changed.
+    virtual void cellPreferredLogicalWidthsChanged(int /*effCol*/) { }
+    virtual void setNeedsFullRecalc() { }
+
 protected:
     RenderTable* m_table;
 };
@@ -28,6 +28,7 @@
 
 #include "AffineTransform.h"
 #include "FilterEffect.h"
+#include "FilterResultCache.h"
 #include "FloatPoint.h"
 #include "FloatRect.h"
 #include "GraphicsContext.h"
@@ -89,6 +90,7 @@ void RenderSVGResourceFilter::removeClientFromCache(RenderObject* client, bool m
         else
             delete m_filter.take(client);
     }
+    m_sourceImageIdentifiers.remove(client);
 
     markClientForInvalidation(client, markForInvalidation ? BoundariesInvalidation : ParentOnlyInvalidation);
 }
@@ -298,12 +300,21 @@ void RenderSVGResourceFilter::postApplyResource(RenderObject* object, GraphicsCo
         // This is the real filtering of the object. It just needs to be called on the
         // initial filtering process. We just take the stored filter result on a
         // second drawing.
-        if (!filterData->builded)
+        if (!filterData->builded) {
             filterData->filter->setSourceImage(filterData->sourceGraphicBuffer.release());
 
+            static unsigned lastSourceImageIdentifier = 0;
+            pair<HashMap<RenderObject*, unsigned>::iterator, bool> result = m_sourceImageIdentifiers.add(object, 0);
+            if (result.second)
+                result.first->second = ++lastSourceImageIdentifier;
+            filterData->filter->setSourceImageIdentifier(result.first->second);
+        }
+
         // Always true if filterData is just built (filterData->builded is false).
+        // Effects whose parameters and inputs are unchanged since they were last
+        // applied, for this or another client, take their earlier results.
         if (!lastEffect->hasResult()) {
-            lastEffect->apply();
+            FilterResultCache::shared()->apply(lastEffect);
 #if !USE(CG)
             ImageBuffer* resultImage = lastEffect->asImageBuffer();
             if (resultImage)
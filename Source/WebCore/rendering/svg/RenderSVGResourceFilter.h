@@ -90,6 +90,11 @@ private:
     bool fitsInMaximumImageSize(const FloatSize&, FloatSize&);
 
     HashMap<RenderObject*, FilterData*> m_filter;
+
+    // Identifies what each client paints as the source graphic, for FilterResultCache.
+    // A client gets a new identifier when it is removed from the cache for a change of
+    // its own, but keeps it when only the filter changes.
+    HashMap<RenderObject*, unsigned> m_sourceImageIdentifiers;
 };
 
 }
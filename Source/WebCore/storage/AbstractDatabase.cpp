@@ -450,6 +450,18 @@ bool AbstractDatabase::lastActionWasInsert()
     return m_databaseAuthorizer->lastActionWasInsert();
 }
 
+bool AbstractDatabase::lastActionHadDeletes()
+{
+    ASSERT(m_databaseAuthorizer);
+    return m_databaseAuthorizer->lastActionHadDeletes();
+}
+
+void AbstractDatabase::replayAuthorizerLastAction(bool wasInsert, bool changedDatabase, bool hadDeletes)
+{
+    ASSERT(m_databaseAuthorizer);
+    m_databaseAuthorizer->replayLastAction(wasInsert, changedDatabase, hadDeletes);
+}
+
 void AbstractDatabase::resetDeletes()
 {
     ASSERT(m_databaseAuthorizer);
@@ -83,6 +83,8 @@ public:
     void setAuthorizerPermissions(int permissions);
     bool lastActionChangedDatabase();
     bool lastActionWasInsert();
+    bool lastActionHadDeletes();
+    void replayAuthorizerLastAction(bool wasInsert, bool changedDatabase, bool hadDeletes);
     void resetDeletes();
     bool hadDeletes();
     void resetAuthorizer();
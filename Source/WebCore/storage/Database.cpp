@@ -62,6 +62,9 @@
 
 namespace WebCore {
 
+// How many prepared statements each database keeps around for executeSql().
+static const size_t maximumCachedStatements = 32;
+
 class DatabaseCreationCallbackTask : public ScriptExecutionContext::Task {
 public:
     static PassOwnPtr<DatabaseCreationCallbackTask> create(PassRefPtr<Database> database, PassRefPtr<DatabaseCallback> creationCallback)
@@ -221,6 +224,8 @@ void Database::close()
         m_transactionInProgress = false;
     }
 
+    // The statements have to be finalized before SQLite allows the database to be closed.
+    clearStatementCache();
     closeDatabase();
 
     // Must ref() before calling databaseThread()->recordDatabaseClosed().
@@ -390,6 +395,55 @@ SQLTransactionCoordinator* Database::transactionCoordinator() const
     return m_scriptExecutionContext->databaseThread()->transactionCoordinator();
 }
 
+Database::CachedStatement::CachedStatement(PassOwnPtr<SQLiteStatement> statement, int permissions)
+    : statement(statement)
+    , permissions(permissions)
+    , wasInsert(false)
+    , changedDatabase(false)
+    , hadDeletes(false)
+{
+}
+
+Database::CachedStatement::~CachedStatement()
+{
+}
+
+PassOwnPtr<Database::CachedStatement> Database::takeCachedStatement(const String& query, int permissions)
+{
+    ASSERT(currentThread() == m_scriptExecutionContext->databaseThread()->getThreadID());
+
+    // The cache is small, so a linear search from the most recently used end is cheapest.
+    for (size_t i = m_statementCache.size(); i > 0; --i) {
+        CachedStatement* cached = m_statementCache[i - 1].get();
+        if (cached->permissions != permissions || cached->statement->query() != query)
+            continue;
+
+        OwnPtr<CachedStatement> result = m_statementCache[i - 1].release();
+        m_statementCache.remove(i - 1);
+
+        // A schema change on this connection expires every statement prepared before it. Prepare
+        // those again, so that they go through the authorizer and the prepare() error handling.
+        if (result->statement->isExpired())
+            return 0;
+        return result.release();
+    }
+    return 0;
+}
+
+void Database::cacheStatement(PassOwnPtr<CachedStatement> statement)
+{
+    ASSERT(currentThread() == m_scriptExecutionContext->databaseThread()->getThreadID());
+
+    if (m_statementCache.size() >= maximumCachedStatements)
+        m_statementCache.remove(0);
+    m_statementCache.append(statement);
+}
+
+void Database::clearStatementCache()
+{
+    m_statementCache.clear();
+}
+
 Vector<String> Database::tableNames()
 {
     // FIXME: Not using threadsafeCopy on these strings looks ok since threads take strict turns
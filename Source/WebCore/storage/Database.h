@@ -36,12 +36,16 @@
 
 #include <wtf/Deque.h>
 #include <wtf/Forward.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
 
 namespace WebCore {
 
 class DatabaseCallback;
 class ScriptExecutionContext;
 class SecurityOrigin;
+class SQLiteStatement;
 class SQLTransaction;
 class SQLTransactionCallback;
 class SQLTransactionClient;
@@ -82,6 +86,25 @@ public:
     SQLTransactionClient* transactionClient() const;
     SQLTransactionCoordinator* transactionCoordinator() const;
 
+    // Prepared statements are kept between executeSql() calls, so that a statement that is
+    // run over and over again is only compiled once. Only used on the database thread.
+    struct CachedStatement {
+        WTF_MAKE_NONCOPYABLE(CachedStatement); WTF_MAKE_FAST_ALLOCATED;
+    public:
+        CachedStatement(PassOwnPtr<SQLiteStatement>, int permissions);
+        ~CachedStatement();
+
+        OwnPtr<SQLiteStatement> statement;
+        int permissions;
+
+        // What the DatabaseAuthorizer reported when the statement was prepared.
+        bool wasInsert;
+        bool changedDatabase;
+        bool hadDeletes;
+    };
+    PassOwnPtr<CachedStatement> takeCachedStatement(const String& query, int permissions);
+    void cacheStatement(PassOwnPtr<CachedStatement>);
+
 private:
     class DatabaseOpenTask;
     class DatabaseCloseTask;
@@ -103,6 +126,8 @@ private:
 
     static void deliverPendingCallback(void*);
 
+    void clearStatementCache();
+
     Deque<RefPtr<SQLTransaction> > m_transactionQueue;
     Mutex m_transactionInProgressMutex;
     bool m_transactionInProgress;
@@ -111,6 +136,9 @@ private:
     RefPtr<SecurityOrigin> m_databaseThreadSecurityOrigin;
 
     bool m_deleted;
+
+    // Least recently used first.
+    Vector<OwnPtr<CachedStatement> > m_statementCache;
 };
 
 } // namespace WebCore
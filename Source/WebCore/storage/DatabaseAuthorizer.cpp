@@ -53,6 +53,7 @@ void DatabaseAuthorizer::reset()
 {
     m_lastActionWasInsert = false;
     m_lastActionChangedDatabase = false;
+    m_lastActionHadDeletes = false;
     m_permissions = ReadWriteMask;
 }
 
@@ -61,6 +62,15 @@ void DatabaseAuthorizer::resetDeletes()
     m_hadDeletes = false;
 }
 
+void DatabaseAuthorizer::replayLastAction(bool wasInsert, bool changedDatabase, bool hadDeletes)
+{
+    m_lastActionWasInsert = wasInsert;
+    m_lastActionChangedDatabase = changedDatabase;
+    m_lastActionHadDeletes = hadDeletes;
+    if (hadDeletes)
+        m_hadDeletes = true;
+}
+
 void DatabaseAuthorizer::addWhitelistedFunctions()
 {
     // SQLite functions used to help implement some operations
@@ -270,6 +280,7 @@ int DatabaseAuthorizer::dropView(const String&)
         return SQLAuthDeny;
 
     m_hadDeletes = true;
+    m_lastActionHadDeletes = true;
     return SQLAuthAllow;
 }
 
@@ -282,6 +293,7 @@ int DatabaseAuthorizer::dropTempView(const String&)
         return SQLAuthDeny;
 
     m_hadDeletes = true;
+    m_lastActionHadDeletes = true;
     return SQLAuthAllow;
 }
 
@@ -428,8 +440,10 @@ int DatabaseAuthorizer::denyBasedOnTableName(const String& tableName) const
 int DatabaseAuthorizer::updateDeletesBasedOnTableName(const String& tableName)
 {
     int allow = denyBasedOnTableName(tableName);
-    if (allow)
+    if (allow) {
         m_hadDeletes = true;
+        m_lastActionHadDeletes = true;
+    }
     return allow;
 }
 
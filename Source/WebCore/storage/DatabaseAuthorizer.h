@@ -101,8 +101,13 @@ public:
 
     bool lastActionWasInsert() const { return m_lastActionWasInsert; }
     bool lastActionChangedDatabase() const { return m_lastActionChangedDatabase; }
+    bool lastActionHadDeletes() const { return m_lastActionHadDeletes; }
     bool hadDeletes() const { return m_hadDeletes; }
 
+    // Statements reused from the Database's statement cache are not prepared again, so the
+    // callbacks above are not invoked for them. This restores what they reported back then.
+    void replayLastAction(bool wasInsert, bool changedDatabase, bool hadDeletes);
+
 private:
     DatabaseAuthorizer(const String& databaseInfoTableName);
     void addWhitelistedFunctions();
@@ -114,6 +119,7 @@ private:
     bool m_securityEnabled : 1;
     bool m_lastActionWasInsert : 1;
     bool m_lastActionChangedDatabase : 1;
+    bool m_lastActionHadDeletes : 1;
     bool m_hadDeletes : 1;
 
     const String m_databaseInfoTableName;
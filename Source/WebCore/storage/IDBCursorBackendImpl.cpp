@@ -33,21 +33,49 @@
 #include "IDBCallbacks.h"
 #include "IDBDatabaseError.h"
 #include "IDBDatabaseException.h"
+#include "IDBIndexBackendImpl.h"
 #include "IDBKeyRange.h"
 #include "IDBObjectStoreBackendImpl.h"
 #include "IDBRequest.h"
+#include "IDBTransaction.h"
 #include "IDBTransactionBackendInterface.h"
 #include "SerializedScriptValue.h"
 
 namespace WebCore {
 
-IDBCursorBackendImpl::IDBCursorBackendImpl(PassRefPtr<IDBBackingStore::Cursor> cursor, IDBCursor::Direction direction, CursorType cursorType, IDBTransactionBackendInterface* transaction, IDBObjectStoreBackendInterface* objectStore)
+// Number of consecutive continue() calls without a key after which records
+// start being read ahead, and the bounds on how many are read at once. The
+// batch doubles each time it is used up, so a short walk over a few records
+// does not pay for a large read ahead.
+static const unsigned prefetchThreshold = 2;
+static const size_t minimumPrefetchSize = 4;
+static const size_t maximumPrefetchSize = 256;
+
+IDBCursorBackendImpl::IDBCursorBackendImpl(PassRefPtr<IDBBackingStore::Cursor> cursor, PassRefPtr<IDBKeyRange> range, IDBCursor::Direction direction, CursorType cursorType, IDBTransactionBackendInterface* transaction, IDBObjectStoreBackendImpl* objectStore, IDBIndexBackendImpl* index)
     : m_cursor(cursor)
+    , m_range(range)
     , m_direction(direction)
     , m_cursorType(cursorType)
     , m_transaction(transaction)
     , m_objectStore(objectStore)
+    , m_index(index)
+    , m_backingStoreCursorAtEnd(false)
+    , m_prefetchedRecordIndex(0)
+    , m_prefetchModificationCount(0)
+    , m_continueCallsWithoutKey(0)
+    , m_prefetchSize(minimumPrefetchSize)
 {
+    ASSERT(m_cursorType == ObjectStoreCursor || m_index);
+    m_currentRecord = currentBackingStoreRecord();
+
+    // After a write, prefetched records are thrown away and the backing store
+    // cursor is reopened just past the current record. That is only exact
+    // when the cursor never visits two records with the same key; index
+    // cursors that do are only read ahead when nothing can write the store.
+    m_prefetchEnabled = m_cursorType == ObjectStoreCursor
+        || m_direction == IDBCursor::NEXT_NO_DUPLICATE
+        || m_direction == IDBCursor::PREV_NO_DUPLICATE
+        || m_transaction->mode() == IDBTransaction::READ_ONLY;
 }
 
 IDBCursorBackendImpl::~IDBCursorBackendImpl()
@@ -61,28 +89,28 @@ unsigned short IDBCursorBackendImpl::direction() const
 
 PassRefPtr<IDBKey> IDBCursorBackendImpl::key() const
 {
-    return m_cursor->key();
+    return m_currentRecord.key;
 }
 
 PassRefPtr<IDBKey> IDBCursorBackendImpl::primaryKey() const
 {
-    return m_cursor->primaryKey();
+    return m_currentRecord.primaryKey;
 }
 
 PassRefPtr<SerializedScriptValue> IDBCursorBackendImpl::value() const
 {
     ASSERT(m_cursorType != IndexKeyCursor);
-    return SerializedScriptValue::createFromWire(m_cursor->value());
+    return SerializedScriptValue::createFromWire(m_currentRecord.value);
 }
 
 void IDBCursorBackendImpl::update(PassRefPtr<SerializedScriptValue> value, PassRefPtr<IDBCallbacks> callbacks, ExceptionCode& ec)
 {
-    if (!m_cursor || m_cursorType == IndexKeyCursor) {
+    if (!m_currentRecord.key || m_cursorType == IndexKeyCursor) {
         ec = IDBDatabaseException::NOT_ALLOWED_ERR;
         return;
     }
 
-    m_objectStore->put(value, m_cursor->primaryKey(), IDBObjectStoreBackendInterface::CursorUpdate, callbacks, m_transaction.get(), ec);
+    m_objectStore->put(value, m_currentRecord.primaryKey, IDBObjectStoreBackendInterface::CursorUpdate, callbacks, m_transaction.get(), ec);
 }
 
 void IDBCursorBackendImpl::continueFunction(PassRefPtr<IDBKey> prpKey, PassRefPtr<IDBCallbacks> prpCallbacks, ExceptionCode& ec)
@@ -101,8 +129,10 @@ void IDBCursorBackendImpl::continueFunctionInternal(ScriptExecutionContext*, Pas
     RefPtr<IDBCursorBackendImpl> cursor = prpCursor;
     RefPtr<IDBKey> key = prpKey;
 
-    if (!cursor->m_cursor || !cursor->m_cursor->continueFunction(key.get())) {
+    if (!cursor->advance(key.get())) {
         cursor->m_cursor = 0;
+        cursor->m_currentRecord = Record();
+        cursor->m_prefetchedRecords.clear();
         callbacks->onSuccess(SerializedScriptValue::nullValue());
         return;
     }
@@ -110,14 +140,117 @@ void IDBCursorBackendImpl::continueFunctionInternal(ScriptExecutionContext*, Pas
     callbacks->onSuccess(cursor.get());
 }
 
+bool IDBCursorBackendImpl::advance(IDBKey* key)
+{
+    if (!m_currentRecord.key)
+        return false;
+
+    bool hasReadAhead = m_prefetchedRecordIndex < m_prefetchedRecords.size() || m_backingStoreCursorAtEnd;
+    if (hasReadAhead && m_objectStore->modificationCount() != m_prefetchModificationCount) {
+        // The store was written since the records were read, so they may be
+        // stale and records may have been added in between or, if the read
+        // ahead reached the end, after the last of them. Reading ahead
+        // again would most likely be wasted too: a loop that updates or
+        // deletes each record invalidates every batch.
+        m_prefetchedRecords.clear();
+        m_prefetchedRecordIndex = 0;
+        m_prefetchEnabled = false;
+        if (!reopenAfterCurrentRecord())
+            return false;
+        if (!key || !isBefore(m_cursor->key().get(), key)) {
+            m_currentRecord = currentBackingStoreRecord();
+            return true;
+        }
+    } else {
+        while (m_prefetchedRecordIndex < m_prefetchedRecords.size()) {
+            Record& record = m_prefetchedRecords[m_prefetchedRecordIndex++];
+            if (key && isBefore(record.key.get(), key))
+                continue;
+            m_currentRecord = record;
+            if (m_prefetchedRecordIndex == m_prefetchedRecords.size()) {
+                m_prefetchedRecords.clear();
+                m_prefetchedRecordIndex = 0;
+                m_prefetchSize = std::min(m_prefetchSize * 2, maximumPrefetchSize);
+            }
+            return true;
+        }
+        m_prefetchedRecords.clear();
+        m_prefetchedRecordIndex = 0;
+
+        if (m_backingStoreCursorAtEnd)
+            return false;
+    }
+
+    if (!m_cursor->continueFunction(key))
+        return false;
+    m_currentRecord = currentBackingStoreRecord();
+
+    if (key) {
+        m_continueCallsWithoutKey = 0;
+        m_prefetchSize = minimumPrefetchSize;
+    } else if (++m_continueCallsWithoutKey >= prefetchThreshold)
+        prefetch();
+    return true;
+}
+
+bool IDBCursorBackendImpl::isBefore(const IDBKey* a, const IDBKey* b) const
+{
+    if (m_direction == IDBCursor::NEXT || m_direction == IDBCursor::NEXT_NO_DUPLICATE)
+        return a->isLessThan(b);
+    return b->isLessThan(a);
+}
+
+IDBCursorBackendImpl::Record IDBCursorBackendImpl::currentBackingStoreRecord() const
+{
+    Record record;
+    record.key = m_cursor->key();
+    record.primaryKey = m_cursor->primaryKey();
+    if (m_cursorType != IndexKeyCursor)
+        record.value = m_cursor->value();
+    return record;
+}
+
+void IDBCursorBackendImpl::prefetch()
+{
+    ASSERT(m_prefetchedRecords.isEmpty());
+    if (!m_prefetchEnabled || m_backingStoreCursorAtEnd)
+        return;
+
+    m_prefetchModificationCount = m_objectStore->modificationCount();
+    m_prefetchedRecords.reserveInitialCapacity(m_prefetchSize);
+    while (m_prefetchedRecords.size() < m_prefetchSize) {
+        if (!m_cursor->continueFunction(0)) {
+            m_backingStoreCursorAtEnd = true;
+            break;
+        }
+        m_prefetchedRecords.append(currentBackingStoreRecord());
+    }
+}
+
+bool IDBCursorBackendImpl::reopenAfterCurrentRecord()
+{
+    RefPtr<IDBKeyRange> range;
+    if (m_direction == IDBCursor::NEXT || m_direction == IDBCursor::NEXT_NO_DUPLICATE)
+        range = IDBKeyRange::create(m_currentRecord.key, m_range ? m_range->upper() : 0, true, m_range && m_range->upperOpen());
+    else
+        range = IDBKeyRange::create(m_range ? m_range->lower() : 0, m_currentRecord.key, m_range && m_range->lowerOpen(), true);
+
+    if (m_cursorType == ObjectStoreCursor)
+        m_cursor = m_objectStore->openBackingStoreCursor(range.get(), m_direction);
+    else
+        m_cursor = m_index->openBackingStoreCursor(range.get(), m_direction, m_cursorType);
+    m_backingStoreCursorAtEnd = false;
+    return m_cursor.get();
+}
+
 void IDBCursorBackendImpl::deleteFunction(PassRefPtr<IDBCallbacks> prpCallbacks, ExceptionCode& ec)
 {
-    if (!m_cursor || m_cursorType == IndexKeyCursor) {
+    if (!m_currentRecord.key || m_cursorType == IndexKeyCursor) {
         ec = IDBDatabaseException::NOT_ALLOWED_ERR;
         return;
     }
 
-    m_objectStore->deleteFunction(m_cursor->primaryKey(), prpCallbacks, m_transaction.get(), ec);
+    m_objectStore->deleteFunction(m_currentRecord.primaryKey, prpCallbacks, m_transaction.get(), ec);
 }
 
 } // namespace WebCore
@@ -32,25 +32,28 @@
 #include "IDBBackingStore.h"
 #include "IDBCursor.h"
 #include "IDBCursorBackendInterface.h"
+#include "IDBKey.h"
+#include "PlatformString.h"
 #include <wtf/OwnPtr.h>
 #include <wtf/PassOwnPtr.h>
 #include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
 
 namespace WebCore {
 
 class IDBDatabaseBackendImpl;
 class IDBIndexBackendImpl;
 class IDBKeyRange;
-class IDBObjectStoreBackendInterface;
+class IDBObjectStoreBackendImpl;
 class IDBBackingStore;
 class IDBTransactionBackendInterface;
 class SerializedScriptValue;
 
 class IDBCursorBackendImpl : public IDBCursorBackendInterface {
 public:
-    static PassRefPtr<IDBCursorBackendImpl> create(PassRefPtr<IDBBackingStore::Cursor> cursor, IDBCursor::Direction direction, CursorType cursorType, IDBTransactionBackendInterface* transaction, IDBObjectStoreBackendInterface* objectStore)
+    static PassRefPtr<IDBCursorBackendImpl> create(PassRefPtr<IDBBackingStore::Cursor> cursor, PassRefPtr<IDBKeyRange> range, IDBCursor::Direction direction, CursorType cursorType, IDBTransactionBackendInterface* transaction, IDBObjectStoreBackendImpl* objectStore, IDBIndexBackendImpl* index = 0)
     {
-        return adoptRef(new IDBCursorBackendImpl(cursor, direction, cursorType, transaction, objectStore));
+        return adoptRef(new IDBCursorBackendImpl(cursor, range, direction, cursorType, transaction, objectStore, index));
     }
     virtual ~IDBCursorBackendImpl();
 
@@ -63,15 +66,44 @@ public:
     virtual void deleteFunction(PassRefPtr<IDBCallbacks>, ExceptionCode&);
 
 private:
-    IDBCursorBackendImpl(PassRefPtr<IDBBackingStore::Cursor>, IDBCursor::Direction, CursorType, IDBTransactionBackendInterface*, IDBObjectStoreBackendInterface*);
+    IDBCursorBackendImpl(PassRefPtr<IDBBackingStore::Cursor>, PassRefPtr<IDBKeyRange>, IDBCursor::Direction, CursorType, IDBTransactionBackendInterface*, IDBObjectStoreBackendImpl*, IDBIndexBackendImpl*);
 
     static void continueFunctionInternal(ScriptExecutionContext*, PassRefPtr<IDBCursorBackendImpl>, PassRefPtr<IDBKey>, PassRefPtr<IDBCallbacks>);
 
+    struct Record {
+        RefPtr<IDBKey> key;
+        RefPtr<IDBKey> primaryKey;
+        String value;
+    };
+
+    bool advance(IDBKey*);
+    bool isBefore(const IDBKey*, const IDBKey*) const;
+    Record currentBackingStoreRecord() const;
+    void prefetch();
+    bool reopenAfterCurrentRecord();
+
     RefPtr<IDBBackingStore::Cursor> m_cursor;
+    RefPtr<IDBKeyRange> m_range;
     IDBCursor::Direction m_direction;
     CursorType m_cursorType;
     RefPtr<IDBTransactionBackendInterface> m_transaction;
-    RefPtr<IDBObjectStoreBackendInterface> m_objectStore;
+    RefPtr<IDBObjectStoreBackendImpl> m_objectStore;
+    RefPtr<IDBIndexBackendImpl> m_index;
+
+    // The record the cursor is positioned on. Once records have been
+    // prefetched, m_cursor sits on the last of them rather than on this one.
+    Record m_currentRecord;
+    bool m_backingStoreCursorAtEnd;
+
+    // Records read ahead of the current one, served by continue() calls
+    // without a key until m_prefetchedRecords is used up or the object store
+    // is written to.
+    Vector<Record> m_prefetchedRecords;
+    size_t m_prefetchedRecordIndex;
+    unsigned m_prefetchModificationCount;
+    unsigned m_continueCallsWithoutKey;
+    size_t m_prefetchSize;
+    bool m_prefetchEnabled;
 };
 
 } // namespace WebCore
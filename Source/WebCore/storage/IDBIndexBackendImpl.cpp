@@ -68,25 +68,26 @@ IDBIndexBackendImpl::~IDBIndexBackendImpl()
 {
 }
 
-void IDBIndexBackendImpl::openCursorInternal(ScriptExecutionContext*, PassRefPtr<IDBIndexBackendImpl> index, PassRefPtr<IDBKeyRange> range, unsigned short untypedDirection, IDBCursorBackendInterface::CursorType cursorType, PassRefPtr<IDBCallbacks> callbacks, PassRefPtr<IDBTransactionBackendInterface> transaction)
+PassRefPtr<IDBBackingStore::Cursor> IDBIndexBackendImpl::openBackingStoreCursor(IDBKeyRange* range, IDBCursor::Direction direction, IDBCursorBackendInterface::CursorType cursorType)
 {
-    IDBCursor::Direction direction = static_cast<IDBCursor::Direction>(untypedDirection);
-
-    RefPtr<IDBBackingStore::Cursor> backingStoreCursor;
-
     switch (cursorType) {
     case IDBCursorBackendInterface::IndexKeyCursor:
-        backingStoreCursor = index->m_backingStore->openIndexKeyCursor(index->m_databaseId, index->m_objectStoreBackend->id(), index->id(), range.get(), direction);
-        break;
+        return m_backingStore->openIndexKeyCursor(m_databaseId, m_objectStoreBackend->id(), id(), range, direction);
     case IDBCursorBackendInterface::IndexCursor:
-        backingStoreCursor = index->m_backingStore->openIndexCursor(index->m_databaseId, index->m_objectStoreBackend->id(), index->id(), range.get(), direction);
-        break;
+        return m_backingStore->openIndexCursor(m_databaseId, m_objectStoreBackend->id(), id(), range, direction);
     case IDBCursorBackendInterface::ObjectStoreCursor:
     case IDBCursorBackendInterface::InvalidCursorType:
         ASSERT_NOT_REACHED();
         break;
     }
+    return 0;
+}
+
+void IDBIndexBackendImpl::openCursorInternal(ScriptExecutionContext*, PassRefPtr<IDBIndexBackendImpl> index, PassRefPtr<IDBKeyRange> range, unsigned short untypedDirection, IDBCursorBackendInterface::CursorType cursorType, PassRefPtr<IDBCallbacks> callbacks, PassRefPtr<IDBTransactionBackendInterface> transaction)
+{
+    IDBCursor::Direction direction = static_cast<IDBCursor::Direction>(untypedDirection);
 
+    RefPtr<IDBBackingStore::Cursor> backingStoreCursor = index->openBackingStoreCursor(range.get(), direction, cursorType);
     if (!backingStoreCursor) {
         callbacks->onSuccess(SerializedScriptValue::nullValue());
         return;
@@ -96,7 +97,9 @@ void IDBIndexBackendImpl::openCursorInternal(ScriptExecutionContext*, PassRefPtr
     RefPtr<IDBObjectStoreBackendInterface> objectStore = transaction->objectStore(index->m_storeName, ec);
     ASSERT(objectStore && !ec);
 
-    RefPtr<IDBCursorBackendInterface> cursor = IDBCursorBackendImpl::create(backingStoreCursor.get(), direction, cursorType, transaction.get(), objectStore.get());
+    // The transaction hands out the database's own object store backends.
+    IDBObjectStoreBackendImpl* objectStoreBackend = static_cast<IDBObjectStoreBackendImpl*>(objectStore.get());
+    RefPtr<IDBCursorBackendInterface> cursor = IDBCursorBackendImpl::create(backingStoreCursor.release(), range, direction, cursorType, transaction.get(), objectStoreBackend, index.get());
     callbacks->onSuccess(cursor.release());
 }
 
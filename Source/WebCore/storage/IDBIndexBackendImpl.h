@@ -28,6 +28,8 @@
 
 #if ENABLE(INDEXED_DATABASE)
 
+#include "IDBBackingStore.h"
+#include "IDBCursor.h"
 #include "IDBCursorBackendInterface.h"
 #include "IDBIndexBackendInterface.h"
 
@@ -35,6 +37,7 @@ namespace WebCore {
 
 class IDBBackingStore;
 class IDBKey;
+class IDBKeyRange;
 class IDBObjectStoreBackendImpl;
 class ScriptExecutionContext;
 
@@ -60,6 +63,8 @@ public:
 
     bool addingKeyAllowed(IDBKey*);
 
+    PassRefPtr<IDBBackingStore::Cursor> openBackingStoreCursor(IDBKeyRange*, IDBCursor::Direction, IDBCursorBackendInterface::CursorType);
+
     // Implements IDBIndexBackendInterface.
     virtual String name() { return m_name; }
     virtual String storeName() { return m_storeName; }
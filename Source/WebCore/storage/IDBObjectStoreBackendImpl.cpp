@@ -58,6 +58,7 @@ IDBObjectStoreBackendImpl::IDBObjectStoreBackendImpl(IDBBackingStore* backingSto
     , m_keyPath(keyPath)
     , m_autoIncrement(autoIncrement)
     , m_autoIncrementNumber(-1)
+    , m_modificationCount(0)
 {
     loadIndexes();
 }
@@ -70,6 +71,7 @@ IDBObjectStoreBackendImpl::IDBObjectStoreBackendImpl(IDBBackingStore* backingSto
     , m_keyPath(keyPath)
     , m_autoIncrement(autoIncrement)
     , m_autoIncrementNumber(-1)
+    , m_modificationCount(0)
 {
 }
 
@@ -238,6 +240,7 @@ void IDBObjectStoreBackendImpl::putInternal(ScriptExecutionContext*, PassRefPtr<
     }
 
     // Before this point, don't do any mutation.  After this point, rollback the transaction in case of error.
+    ++objectStore->m_modificationCount;
 
     if (!objectStore->m_backingStore->putObjectStoreRecord(objectStore->m_databaseId, objectStore->id(), *key, value->toWireString(), recordIdentifier.get())) {
         // FIXME: The Indexed Database specification does not have an error code dedicated to I/O errors.
@@ -292,6 +295,7 @@ void IDBObjectStoreBackendImpl::deleteInternal(ScriptExecutionContext*, PassRefP
         return;
     }
 
+    ++objectStore->m_modificationCount;
     for (IndexMap::iterator it = objectStore->m_indexes.begin(); it != objectStore->m_indexes.end(); ++it) {
         if (!it->second->hasValidId())
             continue; // The index object has been created, but does not exist in the database yet.
@@ -320,6 +324,7 @@ void IDBObjectStoreBackendImpl::clear(PassRefPtr<IDBCallbacks> prpCallbacks, IDB
 
 void IDBObjectStoreBackendImpl::clearInternal(ScriptExecutionContext*, PassRefPtr<IDBObjectStoreBackendImpl> objectStore, PassRefPtr<IDBCallbacks> callbacks)
 {
+    ++objectStore->m_modificationCount;
     objectStore->m_backingStore->clearObjectStore(objectStore->m_databaseId, objectStore->id());
     callbacks->onSuccess(SerializedScriptValue::undefinedValue());
 }
@@ -459,17 +464,22 @@ void IDBObjectStoreBackendImpl::openCursor(PassRefPtr<IDBKeyRange> prpRange, uns
         ec = IDBDatabaseException::NOT_ALLOWED_ERR;
 }
 
+PassRefPtr<IDBBackingStore::Cursor> IDBObjectStoreBackendImpl::openBackingStoreCursor(IDBKeyRange* range, IDBCursor::Direction direction)
+{
+    return m_backingStore->openObjectStoreCursor(m_databaseId, id(), range, direction);
+}
+
 void IDBObjectStoreBackendImpl::openCursorInternal(ScriptExecutionContext*, PassRefPtr<IDBObjectStoreBackendImpl> objectStore, PassRefPtr<IDBKeyRange> range, unsigned short tmpDirection, PassRefPtr<IDBCallbacks> callbacks, PassRefPtr<IDBTransactionBackendInterface> transaction)
 {
     IDBCursor::Direction direction = static_cast<IDBCursor::Direction>(tmpDirection);
 
-    RefPtr<IDBBackingStore::Cursor> backingStoreCursor = objectStore->m_backingStore->openObjectStoreCursor(objectStore->m_databaseId, objectStore->id(), range.get(), direction);
+    RefPtr<IDBBackingStore::Cursor> backingStoreCursor = objectStore->openBackingStoreCursor(range.get(), direction);
     if (!backingStoreCursor) {
         callbacks->onSuccess(SerializedScriptValue::nullValue());
         return;
     }
 
-    RefPtr<IDBCursorBackendInterface> cursor = IDBCursorBackendImpl::create(backingStoreCursor.release(), direction, IDBCursorBackendInterface::ObjectStoreCursor, transaction.get(), objectStore.get());
+    RefPtr<IDBCursorBackendInterface> cursor = IDBCursorBackendImpl::create(backingStoreCursor.release(), range, direction, IDBCursorBackendInterface::ObjectStoreCursor, transaction.get(), objectStore.get());
     callbacks->onSuccess(cursor.release());
 }
 
@@ -26,6 +26,8 @@
 #ifndef IDBObjectStoreBackendImpl_h
 #define IDBObjectStoreBackendImpl_h
 
+#include "IDBBackingStore.h"
+#include "IDBCursor.h"
 #include "IDBObjectStoreBackendInterface.h"
 #include <wtf/HashMap.h>
 #include <wtf/text/StringHash.h>
@@ -37,6 +39,7 @@ namespace WebCore {
 class IDBBackingStore;
 class IDBDatabaseBackendImpl;
 class IDBIndexBackendImpl;
+class IDBKeyRange;
 class IDBTransactionBackendInterface;
 class ScriptExecutionContext;
 
@@ -61,6 +64,12 @@ public:
     void setId(int64_t id) { m_id = id; }
     int64_t databaseId() const { return m_databaseId; }
 
+    // Incremented every time a record in this object store is written, so
+    // that cursors can tell whether records they prefetched are still valid.
+    unsigned modificationCount() const { return m_modificationCount; }
+
+    PassRefPtr<IDBBackingStore::Cursor> openBackingStoreCursor(IDBKeyRange*, IDBCursor::Direction);
+
     virtual String name() const { return m_name; }
     virtual String keyPath() const { return m_keyPath; }
     virtual PassRefPtr<DOMStringList> indexNames() const;
@@ -109,6 +118,7 @@ private:
     typedef HashMap<String, RefPtr<IDBIndexBackendImpl> > IndexMap;
     IndexMap m_indexes;
     int m_autoIncrementNumber;
+    unsigned m_modificationCount;
 };
 
 } // namespace WebCore
@@ -39,6 +39,8 @@
 #include "SQLStatementErrorCallback.h"
 #include "SQLTransaction.h"
 #include "SQLValue.h"
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
 #include <wtf/text/CString.h>
 
 namespace WebCore {
@@ -73,15 +75,30 @@ bool SQLStatement::execute(Database* db)
 
     SQLiteDatabase* database = &db->sqliteDatabase();
 
-    SQLiteStatement statement(*database, m_statement);
-    int result = statement.prepare();
+    // Statements that were executed successfully before are reused without being compiled again.
+    // The authorizer only sees a statement while it is prepared, so what it reported then is replayed.
+    OwnPtr<Database::CachedStatement> cachedStatement = db->takeCachedStatement(m_statement, m_permissions);
+    if (cachedStatement)
+        db->replayAuthorizerLastAction(cachedStatement->wasInsert, cachedStatement->changedDatabase, cachedStatement->hadDeletes);
+    else {
+        OwnPtr<SQLiteStatement> newStatement = adoptPtr(new SQLiteStatement(*database, m_statement));
+        int result = newStatement->prepare();
 
-    if (result != SQLResultOk) {
-        LOG(StorageAPI, "Unable to verify correctness of statement %s - error %i (%s)", m_statement.ascii().data(), result, database->lastErrorMsg());
-        m_error = SQLError::create(result == SQLResultInterrupt ? SQLError::DATABASE_ERR : SQLError::SYNTAX_ERR, database->lastErrorMsg());
-        return false;
+        if (result != SQLResultOk) {
+            LOG(StorageAPI, "Unable to verify correctness of statement %s - error %i (%s)", m_statement.ascii().data(), result, database->lastErrorMsg());
+            m_error = SQLError::create(result == SQLResultInterrupt ? SQLError::DATABASE_ERR : SQLError::SYNTAX_ERR, database->lastErrorMsg());
+            return false;
+        }
+
+        cachedStatement = adoptPtr(new Database::CachedStatement(newStatement.release(), m_permissions));
+        cachedStatement->wasInsert = db->lastActionWasInsert();
+        cachedStatement->changedDatabase = db->lastActionChangedDatabase();
+        cachedStatement->hadDeletes = db->lastActionHadDeletes();
     }
 
+    SQLiteStatement& statement = *cachedStatement->statement;
+    int result;
+
     // FIXME:  If the statement uses the ?### syntax supported by sqlite, the bind parameter count is very likely off from the number of question marks.
     // If this is the case, they might be trying to do something fishy or malicious
     if (statement.bindParameterCount() != m_arguments.size()) {
@@ -144,6 +161,10 @@ bool SQLStatement::execute(Database* db)
     // For now, this seems sufficient
     resultSet->setRowsAffected(database->lastChanges());
 
+    // Statements that failed are finalized rather than cached, as they are unlikely to be run again.
+    statement.reset();
+    db->cacheStatement(cachedStatement.release());
+
     m_resultSet = resultSet;
     return true;
 }
@@ -129,6 +129,10 @@ String StorageAreaImpl::key(unsigned index) const
 String StorageAreaImpl::getItem(const String& key) const
 {
     ASSERT(!m_isShutdown);
+
+    String value;
+    if (m_storageAreaSync && m_storageAreaSync->getItemDuringImport(key, value))
+        return value;
     blockUntilImportComplete();
 
     return m_storageMap->getItem(key);
@@ -210,15 +214,20 @@ bool StorageAreaImpl::clear(Frame* frame)
 bool StorageAreaImpl::contains(const String& key) const
 {
     ASSERT(!m_isShutdown);
+
+    String value;
+    if (m_storageAreaSync && m_storageAreaSync->getItemDuringImport(key, value))
+        return !value.isNull();
     blockUntilImportComplete();
 
     return m_storageMap->contains(key);
 }
 
-void StorageAreaImpl::importItem(const String& key, const String& value)
+void StorageAreaImpl::importItems(HashMap<String, String>& items)
 {
+    ASSERT(isMainThread());
     ASSERT(!m_isShutdown);
-    m_storageMap->importItem(key, value);
+    m_storageMap->importItems(items);
 }
 
 void StorageAreaImpl::close()
@@ -256,6 +265,11 @@ void StorageAreaImpl::sync()
         m_storageAreaSync->scheduleSync();
 }
 
+bool StorageAreaImpl::isImportComplete() const
+{
+    return !m_storageAreaSync || m_storageAreaSync->isImportComplete();
+}
+
 void StorageAreaImpl::blockUntilImportComplete() const
 {
     if (m_storageAreaSync)
@@ -30,8 +30,10 @@
 
 #include "StorageArea.h"
 
+#include <wtf/HashMap.h>
 #include <wtf/PassRefPtr.h>
 #include <wtf/RefPtr.h>
+#include <wtf/text/StringHash.h>
 
 namespace WebCore {
 
@@ -56,14 +58,18 @@ namespace WebCore {
         PassRefPtr<StorageAreaImpl> copy();
         void close();
 
-        // Only called from a background thread.
-        void importItem(const String& key, const String& value);
+        // Called by StorageAreaSync once the import has completed.
+        void importItems(HashMap<String, String>&);
 
         // Used to clear a StorageArea and close db before backing db file is deleted.
         void clearForOriginDeletion();
 
         void sync();
 
+        // Whether the items have been read from the database, so that using the
+        // area will not block.
+        bool isImportComplete() const;
+
     private:
         StorageAreaImpl(StorageType, PassRefPtr<SecurityOrigin>, PassRefPtr<StorageSyncManager>, unsigned quota);
         StorageAreaImpl(StorageAreaImpl*);
@@ -31,6 +31,7 @@
 #include "EventNames.h"
 #include "FileSystem.h"
 #include "HTMLElement.h"
+#include "Logging.h"
 #include "SQLiteFileSystem.h"
 #include "SQLiteStatement.h"
 #include "SecurityOrigin.h"
@@ -38,6 +39,7 @@
 #include "StorageSyncManager.h"
 #include "StorageTracker.h"
 #include "SuddenTermination.h"
+#include <wtf/CurrentTime.h>
 #include <wtf/text/CString.h>
 
 namespace WebCore {
@@ -50,6 +52,9 @@ static const double StorageSyncInterval = 1.0;
 // much harder to starve the rest of LocalStorage and the OS's IO subsystem in general.
 static const int MaxiumItemsToSync = 100;
 
+// Only updated on the main thread.
+static StorageAreaSync::ImportStatistics s_importStatistics;
+
 inline StorageAreaSync::StorageAreaSync(PassRefPtr<StorageSyncManager> storageSyncManager, PassRefPtr<StorageAreaImpl> storageArea, const String& databaseIdentifier)
     : m_syncTimer(this, &StorageAreaSync::syncTimerFired)
     , m_itemsCleared(false)
@@ -61,8 +66,10 @@ inline StorageAreaSync::StorageAreaSync(PassRefPtr<StorageSyncManager> storageSy
     , m_syncScheduled(false)
     , m_syncInProgress(false)
     , m_databaseOpenFailed(false)
+    , m_lookupDatabaseOpenFailed(false)
     , m_syncCloseDatabase(false)
     , m_importComplete(false)
+    , m_importStarted(false)
 {
     ASSERT(isMainThread());
     ASSERT(m_storageArea);
@@ -275,6 +282,14 @@ void StorageAreaSync::performImport()
         return;
     }
 
+    // From now on the main thread can look up single items in the database
+    // itself rather than wait for all of them to be read.
+    {
+        MutexLocker locker(m_importLock);
+        m_importDatabaseFilename = m_syncManager->fullDatabaseFilename(m_databaseIdentifier).crossThreadString();
+        m_importStarted = true;
+    }
+
     SQLiteStatement query(m_database, "SELECT key, value FROM ItemTable");
     if (query.prepare() != SQLResultOk) {
         LOG_ERROR("Unable to select items from ItemTable for local storage");
@@ -296,13 +311,12 @@ void StorageAreaSync::performImport()
         return;
     }
 
-    HashMap<String, String>::iterator it = itemMap.begin();
-    HashMap<String, String>::iterator end = itemMap.end();
-
-    for (; it != end; ++it)
-        m_storageArea->importItem(it->first, it->second);
-
-    markImported();
+    // The strings are not referenced by this thread any more once they have
+    // been handed over, so the main thread can adopt them without copying.
+    MutexLocker locker(m_importLock);
+    m_importedItems.swap(itemMap);
+    m_importComplete = true;
+    m_importCondition.signal();
 }
 
 void StorageAreaSync::markImported()
@@ -312,13 +326,11 @@ void StorageAreaSync::markImported()
     m_importCondition.signal();
 }
 
-// FIXME: In the future, we should allow use of StorageAreas while it's importing (when safe to do so).
-// Blocking everything until the import is complete is by far the simplest and safest thing to do, but
-// there is certainly room for safe optimization: Key/length will never be able to make use of such an
-// optimization (since the order of iteration can change as items are being added). Get can return any
-// item currently in the map. Get/remove can work whether or not it's in the map, but we'll need a list
-// of items the import should not overwrite. Clear can also work, but it'll need to kill the import
-// job first.
+// FIXME: Only getItem() and contains() can be used while the import is running, through
+// getItemDuringImport(). Key/length will never be able to make use of such an optimization
+// (since the order of iteration can change as items are being added). Set/remove can work
+// whether or not the item has been read, but we'll need a list of items the import should
+// not overwrite. Clear can also work, but it'll need to kill the import job first.
 void StorageAreaSync::blockUntilImportComplete()
 {
     ASSERT(isMainThread());
@@ -327,10 +339,93 @@ void StorageAreaSync::blockUntilImportComplete()
     if (!m_storageArea)
         return;
 
-    MutexLocker locker(m_importLock);
-    while (!m_importComplete)
-        m_importCondition.wait(m_importLock);
+    HashMap<String, String> importedItems;
+    {
+        MutexLocker locker(m_importLock);
+        if (!m_importComplete) {
+            double startTime = currentTime();
+            while (!m_importComplete)
+                m_importCondition.wait(m_importLock);
+            double blockedTime = currentTime() - startTime;
+
+            s_importStatistics.blockedCount++;
+            s_importStatistics.totalBlockedTime += blockedTime;
+            if (blockedTime > s_importStatistics.maxBlockedTime)
+                s_importStatistics.maxBlockedTime = blockedTime;
+            LOG(StorageAPI, "Blocked for %.1fms waiting for the local storage import of %s", blockedTime * 1000, m_databaseIdentifier.utf8().data());
+        }
+        m_importedItems.swap(importedItems);
+    }
+
+    m_storageArea->importItems(importedItems);
     m_storageArea = 0;
+
+    m_lookupStatement.clear();
+    if (m_lookupDatabase.isOpen())
+        m_lookupDatabase.close();
+}
+
+bool StorageAreaSync::isImportComplete() const
+{
+    ASSERT(isMainThread());
+    MutexLocker locker(m_importLock);
+    return m_importComplete;
+}
+
+bool StorageAreaSync::getItemDuringImport(const String& key, String& value)
+{
+    ASSERT(isMainThread());
+
+    if (!m_storageArea || m_lookupDatabaseOpenFailed)
+        return false;
+
+    String databaseFilename;
+    {
+        MutexLocker locker(m_importLock);
+        // Once the import is complete the items are in the StorageMap, and before it has
+        // started the database may not even exist yet.
+        if (m_importComplete || !m_importStarted)
+            return false;
+        databaseFilename = m_importDatabaseFilename;
+    }
+
+    if (!m_lookupDatabase.isOpen()) {
+        if (!m_lookupDatabase.open(databaseFilename)) {
+            LOG_ERROR("Failed to open database file %s for local storage lookups", databaseFilename.utf8().data());
+            m_lookupDatabaseOpenFailed = true;
+            return false;
+        }
+        m_lookupStatement = adoptPtr(new SQLiteStatement(m_lookupDatabase, "SELECT value FROM ItemTable WHERE key=?"));
+        if (m_lookupStatement->prepare() != SQLResultOk) {
+            LOG_ERROR("Failed to prepare lookup statement for local storage");
+            m_lookupStatement.clear();
+            m_lookupDatabase.close();
+            m_lookupDatabaseOpenFailed = true;
+            return false;
+        }
+    }
+
+    m_lookupStatement->bindText(1, key);
+    int result = m_lookupStatement->step();
+    if (result == SQLResultRow)
+        value = m_lookupStatement->getColumnText(0);
+    else if (result == SQLResultDone)
+        value = String();
+    m_lookupStatement->reset();
+
+    if (result != SQLResultRow && result != SQLResultDone) {
+        // The database is probably locked. Wait for the import instead.
+        return false;
+    }
+
+    s_importStatistics.lookupsDuringImport++;
+    return true;
+}
+
+const StorageAreaSync::ImportStatistics& StorageAreaSync::importStatistics()
+{
+    ASSERT(isMainThread());
+    return s_importStatistics;
 }
 
 void StorageAreaSync::sync(bool clearItems, const HashMap<String, String>& items)
@@ -31,11 +31,13 @@
 #include "SQLiteDatabase.h"
 #include "Timer.h"
 #include <wtf/HashMap.h>
+#include <wtf/OwnPtr.h>
 #include <wtf/text/StringHash.h>
 
 namespace WebCore {
 
     class Frame;
+    class SQLiteStatement;
     class StorageAreaImpl;
     class StorageSyncManager;
 
@@ -46,6 +48,22 @@ namespace WebCore {
 
         void scheduleFinalSync();
         void blockUntilImportComplete();
+        bool isImportComplete() const;
+
+        // Looks up a single item with an indexed query while the import is
+        // still reading the database, instead of waiting for it to finish.
+        // Returns false if the caller has to block until the import is complete.
+        bool getItemDuringImport(const String& key, String& value);
+
+        // How often and for how long the main thread had to wait for imports,
+        // and how many lookups were answered without waiting.
+        struct ImportStatistics {
+            unsigned blockedCount;
+            double totalBlockedTime;
+            double maxBlockedTime;
+            unsigned lookupsDuringImport;
+        };
+        static const ImportStatistics& importStatistics();
 
         void scheduleItemForSync(const String& key, const String& value);
         void scheduleClear();
@@ -70,6 +88,12 @@ namespace WebCore {
         // The database handle will only ever be opened and used on the background thread.
         SQLiteDatabase m_database;
 
+        // A second, read only, connection used on the main thread by getItemDuringImport().
+        // It is closed as soon as the import is complete.
+        SQLiteDatabase m_lookupDatabase;
+        OwnPtr<SQLiteStatement> m_lookupStatement;
+        bool m_lookupDatabaseOpenFailed;
+
     // The following members are subject to thread synchronization issues.
     public:
         // Called from the background thread
@@ -101,6 +125,13 @@ namespace WebCore {
         mutable Mutex m_importLock;
         mutable ThreadCondition m_importCondition;
         mutable bool m_importComplete;
+        // Set once the background thread has opened the database and started
+        // reading it. Until then getItemDuringImport() can't use it.
+        bool m_importStarted;
+        String m_importDatabaseFilename;
+        // Read on the background thread, and handed over to the StorageAreaImpl
+        // on the main thread by blockUntilImportComplete().
+        HashMap<String, String> m_importedItems;
         void markImported();
     };
 
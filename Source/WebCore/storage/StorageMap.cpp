@@ -169,17 +169,31 @@ bool StorageMap::contains(const String& key) const
     return m_map.contains(key);
 }
 
-void StorageMap::importItem(const String& key, const String& value)
+void StorageMap::importItems(HashMap<String, String>& items)
 {
-    // Be sure to copy the keys/values as items imported on a background thread are destined
-    // to cross a thread boundary
-    pair<HashMap<String, String>::iterator, bool> result = m_map.add(key.threadsafeCopy(), value.threadsafeCopy());
-    ASSERT(result.second);  // True if the key didn't exist previously.
-
-    ASSERT(m_currentLength + key.length() >= m_currentLength);
-    m_currentLength += key.length();
-    ASSERT(m_currentLength + value.length() >= m_currentLength);
-    m_currentLength += value.length();
+    // Nothing can be stored before the import is complete, so the map is
+    // normally empty and the imported items can be adopted as they are.
+    if (m_map.isEmpty())
+        m_map.swap(items);
+    else {
+        HashMap<String, String>::iterator end = items.end();
+        for (HashMap<String, String>::iterator it = items.begin(); it != end; ++it) {
+            pair<HashMap<String, String>::iterator, bool> result = m_map.add(it->first, it->second);
+            ASSERT_UNUSED(result, result.second); // True if the key didn't exist previously.
+        }
+        items.clear();
+    }
+    invalidateIterator();
+
+    unsigned currentLength = 0;
+    HashMap<String, String>::iterator end = m_map.end();
+    for (HashMap<String, String>::iterator it = m_map.begin(); it != end; ++it) {
+        ASSERT(currentLength + it->first.length() >= currentLength);
+        currentLength += it->first.length();
+        ASSERT(currentLength + it->second.length() >= currentLength);
+        currentLength += it->second.length();
+    }
+    m_currentLength = currentLength;
 }
 
 }
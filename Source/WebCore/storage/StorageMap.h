@@ -49,7 +49,9 @@ namespace WebCore {
 
         bool contains(const String& key) const;
 
-        void importItem(const String& key, const String& value);
+        // Takes the items read from the database by StorageAreaSync. The
+        // strings must no longer be referenced by the thread that read them.
+        void importItems(HashMap<String, String>&);
 
         unsigned quota() const { return m_quotaSize; }
 
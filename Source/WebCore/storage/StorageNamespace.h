@@ -47,6 +47,8 @@ public:
 
     virtual ~StorageNamespace() { }
     virtual PassRefPtr<StorageArea> storageArea(PassRefPtr<SecurityOrigin>) = 0;
+    // Starts loading the origin's storage area ahead of a likely storageArea() call.
+    virtual void prewarmStorageArea(PassRefPtr<SecurityOrigin>) { }
     virtual PassRefPtr<StorageNamespace> copy() = 0;
     virtual void close() = 0;
     virtual void unlock() = 0;
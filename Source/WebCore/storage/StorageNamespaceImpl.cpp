@@ -28,11 +28,13 @@
 
 #if ENABLE(DOM_STORAGE)
 
+#include "FileSystem.h"
 #include "SecurityOriginHash.h"
 #include "StorageAreaImpl.h"
 #include "StorageMap.h"
 #include "StorageSyncManager.h"
 #include "StorageTracker.h"
+#include <wtf/CurrentTime.h>
 #include <wtf/StdLibExtras.h>
 #include <wtf/text/StringHash.h>
 
@@ -42,6 +44,11 @@
 
 namespace WebCore {
 
+// Only origins whose local storage was written to this recently are imported ahead of use.
+static const double prewarmRecentUseInterval = 7 * 24 * 60 * 60;
+// How long, in seconds, a prewarmed area keeps its items if no script opens it.
+static const double prewarmLifetime = 10;
+
 typedef HashMap<String, StorageNamespace*> LocalStorageNamespaceMap;
 
 static LocalStorageNamespaceMap& localStorageNamespaceMap()
@@ -69,7 +76,8 @@ PassRefPtr<StorageNamespace> StorageNamespaceImpl::sessionStorageNamespace(unsig
 }
 
 StorageNamespaceImpl::StorageNamespaceImpl(StorageType storageType, const String& path, unsigned quota)
-    : m_storageType(storageType)
+    : m_prewarmReleaseTimer(this, &StorageNamespaceImpl::prewarmReleaseTimerFired)
+    , m_storageType(storageType)
     , m_path(path.crossThreadString())
     , m_syncManager(0)
     , m_quota(quota)
@@ -113,14 +121,81 @@ PassRefPtr<StorageArea> StorageNamespaceImpl::storageArea(PassRefPtr<SecurityOri
 
     RefPtr<SecurityOrigin> origin = prpOrigin;
     RefPtr<StorageAreaImpl> storageArea;
-    if ((storageArea = m_storageAreaMap.get(origin)))
+    if ((storageArea = m_storageAreaMap.get(origin))) {
+        m_prewarmedOrigins.remove(origin);
         return storageArea.release();
+    }
 
     storageArea = StorageAreaImpl::create(m_storageType, origin, m_syncManager, m_quota);
     m_storageAreaMap.set(origin.release(), storageArea);
     return storageArea.release();
 }
 
+void StorageNamespaceImpl::prewarmStorageArea(PassRefPtr<SecurityOrigin> prpOrigin)
+{
+    ASSERT(isMainThread());
+
+    RefPtr<SecurityOrigin> origin = prpOrigin;
+    if (m_storageType != LocalStorage || !m_syncManager || m_isShutdown || m_storageAreaMap.contains(origin))
+        return;
+
+    // Most origins never touch local storage, and importing one that was not used
+    // recently is likely wasted.
+    time_t modificationTime;
+    String databaseFilename = m_syncManager->fullDatabaseFilename(origin->databaseIdentifier());
+    if (databaseFilename.isEmpty() || !getFileModificationTime(databaseFilename, modificationTime))
+        return;
+    double now = currentTime();
+    if (now - modificationTime > prewarmRecentUseInterval)
+        return;
+
+    m_storageAreaMap.set(origin, StorageAreaImpl::create(m_storageType, origin, m_syncManager, m_quota));
+    m_prewarmedOrigins.set(origin.release(), now);
+    if (!m_prewarmReleaseTimer.isActive())
+        m_prewarmReleaseTimer.startOneShot(prewarmLifetime);
+}
+
+void StorageNamespaceImpl::prewarmReleaseTimerFired(Timer<StorageNamespaceImpl>*)
+{
+    ASSERT(isMainThread());
+    if (m_isShutdown)
+        return;
+
+    double now = currentTime();
+    double nextRelease = 0;
+    Vector<RefPtr<SecurityOrigin> > expiredOrigins;
+    PrewarmedOriginMap::iterator end = m_prewarmedOrigins.end();
+    for (PrewarmedOriginMap::iterator it = m_prewarmedOrigins.begin(); it != end; ++it) {
+        double releaseTime = it->second + prewarmLifetime;
+        if (releaseTime <= now)
+            expiredOrigins.append(it->first);
+        else if (!nextRelease || releaseTime < nextRelease)
+            nextRelease = releaseTime;
+    }
+
+    // Nothing has been written to these areas, so closing them lets their items go.
+    // Closing waits for the import, so an area still importing gets another lifetime
+    // rather than blocking the main thread here.
+    for (size_t i = 0; i < expiredOrigins.size(); ++i) {
+        StorageAreaMap::iterator storageArea = m_storageAreaMap.find(expiredOrigins[i]);
+        if (storageArea != m_storageAreaMap.end() && !storageArea->second->isImportComplete()) {
+            m_prewarmedOrigins.set(expiredOrigins[i], now);
+            if (!nextRelease || now + prewarmLifetime < nextRelease)
+                nextRelease = now + prewarmLifetime;
+            continue;
+        }
+        m_prewarmedOrigins.remove(expiredOrigins[i]);
+        if (storageArea != m_storageAreaMap.end()) {
+            RefPtr<StorageAreaImpl> area = storageArea->second;
+            m_storageAreaMap.remove(storageArea);
+            area->close();
+        }
+    }
+
+    if (nextRelease)
+        m_prewarmReleaseTimer.startOneShot(nextRelease - now);
+}
+
 void StorageNamespaceImpl::close()
 {
     ASSERT(isMainThread());
@@ -134,6 +209,9 @@ void StorageNamespaceImpl::close()
         return;
     }
 
+    m_prewarmReleaseTimer.stop();
+    m_prewarmedOrigins.clear();
+
     StorageAreaMap::iterator end = m_storageAreaMap.end();
     for (StorageAreaMap::iterator it = m_storageAreaMap.begin(); it != end; ++it)
         it->second->close();
@@ -32,6 +32,7 @@
 #include "SecurityOriginHash.h"
 #include "StorageArea.h"
 #include "StorageNamespace.h"
+#include "Timer.h"
 
 #include <wtf/HashMap.h>
 #include <wtf/RefPtr.h>
@@ -49,6 +50,7 @@ namespace WebCore {
 
         virtual ~StorageNamespaceImpl();
         virtual PassRefPtr<StorageArea> storageArea(PassRefPtr<SecurityOrigin>);
+        virtual void prewarmStorageArea(PassRefPtr<SecurityOrigin>);
         virtual PassRefPtr<StorageNamespace> copy();
         virtual void close();
         virtual void unlock();
@@ -71,6 +73,14 @@ namespace WebCore {
         typedef HashMap<RefPtr<SecurityOrigin>, RefPtr<StorageAreaImpl>, SecurityOriginHash> StorageAreaMap;
         StorageAreaMap m_storageAreaMap;
 
+        // Areas created by prewarmStorageArea() that storageArea() has not handed out yet,
+        // with the time they were created. Their imported items are released if they are
+        // not opened soon.
+        typedef HashMap<RefPtr<SecurityOrigin>, double, SecurityOriginHash> PrewarmedOriginMap;
+        PrewarmedOriginMap m_prewarmedOrigins;
+        Timer<StorageNamespaceImpl> m_prewarmReleaseTimer;
+        void prewarmReleaseTimerFired(Timer<StorageNamespaceImpl>*);
+
         StorageType m_storageType;
 
         // Only used if m_storageType == LocalStorage and the path was not "" in our constructor.
@@ -69,6 +69,7 @@ LOCAL_SRC_FILES += \
 	android/jni/MIMETypeRegistryAndroid.cpp \
 	android/jni/MockGeolocation.cpp \
 	android/jni/PicturePile.cpp \
+	android/jni/TouchHitTestIndex.cpp \
 	android/jni/WebCoreFrameBridge.cpp \
 	android/jni/WebCoreJni.cpp \
 	android/jni/WebFrameView.cpp \
@@ -528,10 +528,8 @@ void WebRequest::startReading()
     if (!bytesRead)
         return finish(true);
 
-    m_loadState = GotData;
     // Read ok, forward buffer to webcore
-    m_urlLoader->maybeCallOnMainThread(NewRunnableMethod(m_urlLoader.get(), &WebUrlLoaderClient::didReceiveData, m_networkBuffer, bytesRead));
-    m_networkBuffer = 0;
+    didReadData(bytesRead);
     MessageLoop::current()->PostTask(FROM_HERE, m_runnableFactory.NewRunnableMethod(&WebRequest::startReading));
 }
 
@@ -541,10 +539,32 @@ bool WebRequest::read(int* bytesRead)
     ASSERT(m_networkBuffer == 0, "Read called with a nonzero buffer");
 
     // TODO: when asserts work, check that the buffer is 0 here
-    m_networkBuffer = new net::IOBuffer(kInitialReadBufSize);
+    if (m_spareNetworkBuffer) {
+        m_networkBuffer = m_spareNetworkBuffer;
+        m_spareNetworkBuffer = 0;
+    } else
+        m_networkBuffer = new net::IOBuffer(kInitialReadBufSize);
     return m_request->Read(m_networkBuffer, kInitialReadBufSize, bytesRead);
 }
 
+void WebRequest::didReadData(int bytesRead)
+{
+    ASSERT(bytesRead > 0, "didReadData called without data");
+    m_loadState = GotData;
+
+    // WebCore keeps the buffers we hand over as part of the resource data, so
+    // small reads are copied into a buffer of the right size. That way a mostly
+    // empty read buffer is not kept alive and can be reused for the next read.
+    if (bytesRead < kInitialReadBufSize / 4) {
+        scoped_refptr<net::IOBuffer> buffer = new net::IOBuffer(bytesRead);
+        memcpy(buffer->data(), m_networkBuffer->data(), bytesRead);
+        m_urlLoader->queueReceivedData(buffer, bytesRead);
+        m_spareNetworkBuffer = m_networkBuffer;
+    } else
+        m_urlLoader->queueReceivedData(m_networkBuffer, bytesRead);
+    m_networkBuffer = 0;
+}
+
 // This is called when there is data available
 
 // Called when the a Read of the response body is completed after an
@@ -559,10 +579,10 @@ void WebRequest::OnReadCompleted(net::URLRequest* request, int bytesRead)
     ASSERT(m_loadState == Response || m_loadState == GotData, "OnReadCompleted in state other than RESPONSE and GOTDATA");
 
     if (request->status().is_success()) {
-        m_loadState = GotData;
-        m_urlLoader->maybeCallOnMainThread(NewRunnableMethod(
-                m_urlLoader.get(), &WebUrlLoaderClient::didReceiveData, m_networkBuffer, bytesRead));
-        m_networkBuffer = 0;
+        // bytesRead == 0 indicates finished
+        if (!bytesRead)
+            return finish(true);
+        didReadData(bytesRead);
 
         // Get the rest of the data
         startReading();
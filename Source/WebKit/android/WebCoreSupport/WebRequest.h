@@ -95,6 +95,7 @@ public:
 private:
     void startReading();
     bool read(int* bytesRead);
+    void didReadData(int bytesRead);
 
     friend class base::RefCountedThreadSafe<WebRequest>;
     virtual ~WebRequest();
@@ -107,6 +108,7 @@ private:
     scoped_refptr<WebUrlLoaderClient> m_urlLoader;
     OwnPtr<net::URLRequest> m_request;
     scoped_refptr<net::IOBuffer> m_networkBuffer;
+    scoped_refptr<net::IOBuffer> m_spareNetworkBuffer;
     scoped_ptr<UrlInterceptResponse> m_interceptResponse;
     std::string m_url;
     std::string m_userAgent;
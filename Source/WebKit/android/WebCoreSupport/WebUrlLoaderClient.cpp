@@ -33,6 +33,7 @@
 #include "ResourceHandle.h"
 #include "ResourceHandleClient.h"
 #include "ResourceResponse.h"
+#include "SharedBuffer.h"
 #include "WebCoreFrameBridge.h"
 #include "WebRequest.h"
 #include "WebResourceRequest.h"
@@ -110,6 +111,7 @@ WebUrlLoaderClient::WebUrlLoaderClient(WebFrame* webFrame, WebCore::ResourceHand
     , m_cancelling(false)
     , m_sync(false)
     , m_finished(false)
+    , m_receivedDataTaskPending(false)
 {
     bool block = webFrame->blockNetworkLoads() && (resourceRequest.url().protocolIs("http") || resourceRequest.url().protocolIs("https"));
     WebResourceRequest webResourceRequest(resourceRequest, block);
@@ -342,6 +344,29 @@ static void RunTask(void* v) {
     OwnPtr<Task> task(static_cast<Task*>(v));
     task->Run();
 }
+
+// Lets a WebCore SharedBuffer keep a network read buffer alive instead of
+// copying its contents.
+class IOBufferDataSegment : public WebCore::SharedBuffer::DataSegment {
+public:
+    static PassRefPtr<IOBufferDataSegment> create(scoped_refptr<net::IOBuffer> buffer, int size)
+    {
+        return adoptRef(new IOBufferDataSegment(buffer, size));
+    }
+
+    virtual const char* data() const { return m_buffer->data(); }
+    virtual unsigned size() const { return m_size; }
+
+private:
+    IOBufferDataSegment(scoped_refptr<net::IOBuffer> buffer, int size)
+        : m_buffer(buffer)
+        , m_size(size)
+    {
+    }
+
+    scoped_refptr<net::IOBuffer> m_buffer;
+    unsigned m_size;
+};
 }
 
 // This is called from the IO thread, and dispatches the callback to the main thread.
@@ -384,18 +409,53 @@ void WebUrlLoaderClient::didReceiveResponse(PassOwnPtr<WebResponse> webResponse)
     }
 }
 
-void WebUrlLoaderClient::didReceiveData(scoped_refptr<net::IOBuffer> buf, int size)
+// This is called from the IO thread.
+void WebUrlLoaderClient::queueReceivedData(scoped_refptr<net::IOBuffer> buf, int size)
+{
+    {
+        AutoLock lock(m_receivedDataLock);
+        m_receivedData.push_back(std::make_pair(buf, size));
+        if (m_receivedDataTaskPending)
+            return;
+        m_receivedDataTaskPending = true;
+    }
+    maybeCallOnMainThread(NewRunnableMethod(this, &WebUrlLoaderClient::didReceiveQueuedData));
+}
+
+void WebUrlLoaderClient::didReceiveQueuedData()
 {
+    ReceivedDataQueue receivedData;
+    {
+        AutoLock lock(m_receivedDataLock);
+        receivedData.swap(m_receivedData);
+        m_receivedDataTaskPending = false;
+    }
+
     if (m_isMainResource && m_isCertMimeType) {
-        m_webFrame->didReceiveData(buf->data(), size);
+        for (ReceivedDataQueue::const_iterator it = receivedData.begin(); it != receivedData.end(); ++it)
+            m_webFrame->didReceiveData(it->first->data(), it->second);
     }
 
-    if (!isActive() || !size)
+    if (!isActive() || receivedData.empty())
         return;
 
+    WebCore::ResourceHandleClient* client = m_resourceHandle->client();
+    if (client->supportsDataSegments()) {
+        Vector<RefPtr<WebCore::SharedBuffer::DataSegment> > segments;
+        segments.reserveCapacity(receivedData.size());
+        for (ReceivedDataQueue::const_iterator it = receivedData.begin(); it != receivedData.end(); ++it)
+            segments.append(IOBufferDataSegment::create(it->first, it->second));
+        client->didReceiveDataSegments(m_resourceHandle.get(), segments);
+        return;
+    }
+
     // didReceiveData will take a copy of the data
-    if (m_resourceHandle && m_resourceHandle->client())
-        m_resourceHandle->client()->didReceiveData(m_resourceHandle.get(), buf->data(), size, size);
+    for (ReceivedDataQueue::const_iterator it = receivedData.begin(); it != receivedData.end(); ++it) {
+        // The client may cancel the load while handling the previous buffer.
+        if (!isActive())
+            return;
+        m_resourceHandle->client()->didReceiveData(m_resourceHandle.get(), it->first->data(), it->second, it->second);
+    }
 }
 
 // For data url's
@@ -81,9 +81,14 @@ public:
     // (For asynchronous calls, we just delegate to WebKit's callOnMainThread.)
     void maybeCallOnMainThread(Task* task);
 
+    // Called by WebRequest on the IO thread for each network buffer that is read.
+    // Buffers that arrive while an earlier batch is still waiting for the main
+    // thread are added to that batch, so WebCore gets one task per batch.
+    void queueReceivedData(scoped_refptr<net::IOBuffer>, int size);
+
     // Called by WebRequest (using maybeCallOnMainThread), should be forwarded to WebCore.
     void didReceiveResponse(PassOwnPtr<WebResponse>);
-    void didReceiveData(scoped_refptr<net::IOBuffer>, int size);
+    void didReceiveQueuedData();
     void didReceiveDataUrl(PassOwnPtr<std::string>);
     void didReceiveAndroidFileData(PassOwnPtr<std::vector<char> >);
     void didFinishLoading();
@@ -126,6 +131,12 @@ private:
 
     // Queue of callbacks to be executed by the main thread. Must only be accessed inside mutex.
     std::deque<Task*> m_queue;
+
+    // Network buffers read on the IO thread that have not been handed to WebCore yet.
+    typedef std::vector<std::pair<scoped_refptr<net::IOBuffer>, int> > ReceivedDataQueue;
+    base::Lock m_receivedDataLock;
+    ReceivedDataQueue m_receivedData; // Guarded by m_receivedDataLock.
+    bool m_receivedDataTaskPending; // Guarded by m_receivedDataLock.
 };
 
 } // namespace android
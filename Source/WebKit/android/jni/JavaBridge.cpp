@@ -47,6 +47,7 @@
 #include <JNIHelp.h>
 #include <JNIUtility.h>
 #include <SkUtils.h>
+#include <cutils/properties.h>
 #include <jni.h>
 #include <utils/misc.h>
 #include <wtf/Platform.h>
@@ -155,6 +156,13 @@ JavaBridge::JavaBridge(JNIEnv* env, jobject obj)
     ALOG_ASSERT(mGetKeyStrengthList, "Could not find method getKeyStrengthList");
     ALOG_ASSERT(mGetSignedPublicKey, "Could not find method getSignedPublicKey");
 
+    // Lets the MemoryCache replacement policy picked with
+    // Tools/android/memorycachesim be tried out on a device.
+    char policy[PROPERTY_VALUE_MAX];
+    property_get("webcore.memorycache.policy", policy, "");
+    if (!strcmp(policy, "gdsf"))
+        WebCore::memoryCache()->setReplacementPolicy(WebCore::MemoryCacheReplacementPolicy::createGreedyDualSizeFrequency());
+
     JavaSharedClient::SetTimerClient(this);
     JavaSharedClient::SetCookieClient(this);
     JavaSharedClient::SetPluginClient(this);
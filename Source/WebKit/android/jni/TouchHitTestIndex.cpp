@@ -0,0 +1,216 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "TouchHitTestIndex.h"
+
+#include "Document.h"
+#include "Frame.h"
+#include "FrameView.h"
+#include "Node.h"
+#include "RenderBox.h"
+#include "RenderInline.h"
+#include "RenderLayer.h"
+#include "RenderObject.h"
+#include "RenderStyle.h"
+#include "RenderText.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace android {
+
+using namespace WebCore;
+
+TouchHitTestIndex::TouchHitTestIndex()
+    : m_document(0)
+    , m_domTreeVersion(0)
+    , m_layoutCount(0)
+{
+}
+
+void TouchHitTestIndex::clear()
+{
+    m_document = 0;
+    m_domTreeVersion = 0;
+    m_layoutCount = 0;
+    m_entries.clear();
+    m_bands.clear();
+    m_unstableRects.clear();
+    m_fixedRects.clear();
+}
+
+IntRect TouchHitTestIndex::absoluteBoundingBox(Node* node)
+{
+    IntRect rect;
+    RenderObject* render = node->renderer();
+    if (!render)
+        return rect;
+    if (render->isRenderInline())
+        rect = toRenderInline(render)->linesVisualOverflowBoundingBox();
+    else if (render->isBox())
+        rect = toRenderBox(render)->visualOverflowRect();
+    else if (render->isText())
+        rect = toRenderText(render)->linesBoundingBox();
+    else {
+        // SVG and other renderers are left out of the index; lookups that
+        // find nothing fall back to the rect-based hit test.
+        return rect;
+    }
+    FloatPoint absPos = render->localToAbsolute(FloatPoint(), false, true);
+    rect.move(absPos.x(), absPos.y());
+    return rect;
+}
+
+bool TouchHitTestIndex::isUpToDate(Frame* mainFrame) const
+{
+    Document* document = mainFrame->document();
+    return m_document == document
+        && m_domTreeVersion == document->domTreeVersion()
+        && m_layoutCount == mainFrame->view()->layoutCount();
+}
+
+// Overflow that the user or a script has scrolled moves its contents without
+// a layout. Boxes that clip without scrollbars and are still at their origin
+// are common enough, for instance as float containers, to be worth indexing.
+static bool mayScrollWithoutLayout(RenderObject* renderer)
+{
+    if (!renderer->isBox() || !renderer->hasOverflowClip())
+        return false;
+    RenderBox* box = toRenderBox(renderer);
+    return box->scrollsOverflow() || (box->layer() && !box->layer()->scrolledContentOffset().isZero());
+}
+
+void TouchHitTestIndex::build(Frame* mainFrame)
+{
+    clear();
+
+    Document* document = mainFrame->document();
+    FrameView* view = mainFrame->view();
+    m_document = document;
+    m_domTreeVersion = document->domTreeVersion();
+    m_layoutCount = view->layoutCount();
+    m_scrollPosition = view->scrollPosition();
+
+    Node* node = document->firstChild();
+    while (node) {
+        RenderObject* renderer = node->renderer();
+        if (!renderer) {
+            node = node->traverseNextSibling();
+            continue;
+        }
+        if (renderer->style()->position() == FixedPosition) {
+            m_fixedRects.append(absoluteBoundingBox(node));
+            node = node->traverseNextSibling();
+            continue;
+        }
+        if (renderer->isWidget() || mayScrollWithoutLayout(renderer)) {
+            m_unstableRects.append(absoluteBoundingBox(node));
+            node = node->traverseNextSibling();
+            continue;
+        }
+        // Sloppy hit testing never looks past the body for a node to
+        // highlight, and does not hit the background of hidden boxes.
+        if (!renderer->isBody() && renderer->style()->visibility() == VISIBLE) {
+            IntRect bounds = absoluteBoundingBox(node);
+            if (!bounds.isEmpty())
+                addEntry(node, bounds);
+        }
+        node = node->traverseNextNode();
+    }
+}
+
+void TouchHitTestIndex::addEntry(Node* node, const IntRect& bounds)
+{
+    unsigned index = m_entries.size();
+    Entry entry;
+    entry.node = node;
+    entry.bounds = bounds;
+    m_entries.append(entry);
+
+    int lastBand = bandForY(bounds.maxY() - 1);
+    if (static_cast<int>(m_bands.size()) <= lastBand)
+        m_bands.grow(lastBand + 1);
+    for (int band = bandForY(bounds.y()); band <= lastBand; ++band)
+        m_bands[band].append(index);
+}
+
+bool TouchHitTestIndex::intersectsUnstableRect(Frame* mainFrame, const IntRect& rect) const
+{
+    for (size_t i = 0; i < m_unstableRects.size(); ++i) {
+        if (m_unstableRects[i].intersects(rect))
+            return true;
+    }
+    if (m_fixedRects.isEmpty())
+        return false;
+    IntSize scrollDelta = mainFrame->view()->scrollPosition() - m_scrollPosition;
+    for (size_t i = 0; i < m_fixedRects.size(); ++i) {
+        IntRect fixedRect = m_fixedRects[i];
+        fixedRect.move(scrollDelta);
+        if (fixedRect.intersects(rect))
+            return true;
+    }
+    return false;
+}
+
+bool TouchHitTestIndex::nodesInRect(Frame* mainFrame, const IntRect& rect, Vector<Node*>& nodes)
+{
+    Document* document = mainFrame->document();
+    if (!document || !mainFrame->view() || !document->renderer())
+        return false;
+
+    // The rect-based hit test would do this first as well.
+    document->updateLayout();
+    if (!isUpToDate(mainFrame))
+        build(mainFrame);
+
+    if (rect.isEmpty() || intersectsUnstableRect(mainFrame, rect))
+        return false;
+
+    int firstBand = bandForY(rect.y());
+    int lastBand = std::min(bandForY(rect.maxY() - 1), static_cast<int>(m_bands.size()) - 1);
+    Vector<unsigned> matches;
+    for (int band = firstBand; band <= lastBand; ++band) {
+        const Vector<unsigned>& bandEntries = m_bands[band];
+        for (size_t i = 0; i < bandEntries.size(); ++i) {
+            const Entry& entry = m_entries[bandEntries[i]];
+            // An entry that spans several bands is only reported from the
+            // first of them that the query covers.
+            if (band != std::max(firstBand, bandForY(entry.bounds.y())))
+                continue;
+            if (entry.bounds.intersects(rect))
+                matches.append(bandEntries[i]);
+        }
+    }
+
+    // Later nodes are more likely to be painted on top, which is the order a
+    // rect-based hit test reports them in.
+    std::sort(matches.begin(), matches.end(), std::greater<unsigned>());
+    for (size_t i = 0; i < matches.size(); ++i)
+        nodes.append(m_entries[matches[i]].node);
+    return true;
+}
+
+} // namespace android
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TouchHitTestIndex_h
+#define TouchHitTestIndex_h
+
+#include "IntPoint.h"
+#include "IntRect.h"
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+class Document;
+class Frame;
+class Node;
+}
+
+namespace android {
+
+// Remembers the absolute bounds of the rendered nodes of the main frame, in
+// horizontal bands, so that the sloppy hit test done for each tap can find the
+// nodes under the finger without walking the whole RenderLayer tree. It is
+// built on the first query after a layout or a DOM mutation, and knows nothing
+// about stacking or clipping, so callers must confirm what they pick with a
+// point hit test.
+class TouchHitTestIndex {
+    WTF_MAKE_NONCOPYABLE(TouchHitTestIndex);
+public:
+    TouchHitTestIndex();
+
+    // Appends the nodes whose bounds intersect |rect|, given in the main
+    // frame's document coordinates, latest in document order first. Returns
+    // false if the index cannot answer for |rect|, because it covers a fixed
+    // positioned, scrollable or embedded object that can move without a
+    // layout. The caller should then do a rect-based hit test instead.
+    bool nodesInRect(WebCore::Frame* mainFrame, const WebCore::IntRect& rect, WTF::Vector<WebCore::Node*>& nodes);
+
+    void clear();
+
+    static WebCore::IntRect absoluteBoundingBox(WebCore::Node*);
+
+private:
+    struct Entry {
+        WebCore::Node* node;
+        WebCore::IntRect bounds;
+    };
+
+    bool isUpToDate(WebCore::Frame*) const;
+    void build(WebCore::Frame*);
+    void addEntry(WebCore::Node*, const WebCore::IntRect&);
+    bool intersectsUnstableRect(WebCore::Frame*, const WebCore::IntRect&) const;
+
+    static int bandForY(int y) { return y > 0 ? y / bandHeight : 0; }
+
+    static const int bandHeight = 256;
+
+    // Only compared against, never dereferenced: the DOM tree versions are
+    // unique across documents.
+    WebCore::Document* m_document;
+    uint64_t m_domTreeVersion;
+    int m_layoutCount;
+
+    WTF::Vector<Entry> m_entries;
+    // Indexes into m_entries of the entries that overlap each band.
+    WTF::Vector<WTF::Vector<unsigned> > m_bands;
+    // The bounds of scrollable and embedded objects, whose contents are not
+    // indexed, and of fixed positioned objects, which move with the page's
+    // scroll position, remembered as it was when the index was built.
+    WTF::Vector<WebCore::IntRect> m_unstableRects;
+    WTF::Vector<WebCore::IntRect> m_fixedRects;
+    WebCore::IntPoint m_scrollPosition;
+};
+
+} // namespace android
+
+#endif // TouchHitTestIndex_h
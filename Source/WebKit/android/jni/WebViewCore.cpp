@@ -79,6 +79,7 @@
 #include "HistoryItem.h"
 #include "HitTestRequest.h"
 #include "HitTestResult.h"
+#include "ImageSource.h"
 #include "InlineTextBox.h"
 #include "KeyboardEvent.h"
 #include "MemoryUsage.h"
@@ -114,6 +115,7 @@
 #include "SelectionController.h"
 #include "SelectText.h"
 #include "Settings.h"
+#include "StorageAreaSync.h"
 #include "SkANP.h"
 #include "SkTemplates.h"
 #include "SkTDArray.h"
@@ -442,6 +444,7 @@ WebViewCore::WebViewCore(JNIEnv* env, jobject javaWebViewCore, WebCore::Frame* m
     , m_pluginInvalTimer(this, &WebViewCore::pluginInvalTimerFired)
     , m_screenOnCounter(0)
     , m_currentNodeDomNavigationAxis(0)
+    , m_touchHitTestIndexEnabled(true)
     , m_deviceMotionAndOrientationManager(this)
     , m_geolocationManager(this)
 #if ENABLE(TOUCH_EVENTS)
@@ -884,7 +887,11 @@ BaseLayerAndroid* WebViewCore::createBaseLayer(GraphicsLayerAndroid* root)
 
     SkSafeUnref(content);
 
-    // We update the layers
+    // We update the layers. This copies every LayerAndroid in the tree: the
+    // UI thread keeps per-collection state (draw transforms, clips, surfaces,
+    // animation results, parent links) in the nodes, so a node can't be
+    // shared between collections. Only the content pictures and animations
+    // are shared by refcount.
     if (root) {
         LayerAndroid* copyLayer = new LayerAndroid(*root->contentLayer());
         base->addChild(copyLayer);
@@ -1140,8 +1147,12 @@ void WebViewCore::setSizeScreenWidthAndScale(int width, int height,
     m_screenWidth = screenWidth;
     m_screenHeight = screenHeight;
     m_textWrapWidth = textWrapWidth;
-    if (scale >= 0) // negative means keep the current scale
+    if (scale >= 0) { // negative means keep the current scale
         m_scale = scale;
+        // Subsampled images must be drawn again to be decoded for the new zoom.
+        if (WebCore::ImageSource::setDrawnSizeScale(m_scale))
+            contentInvalidateAll();
+    }
     m_maxXScroll = screenWidth >> 2;
     m_maxYScroll = m_maxXScroll * height / width;
     // Don't reflow if the diff is small.
@@ -1281,6 +1292,18 @@ void WebViewCore::dumpRenderTree(bool useFile)
             }
         }
     }
+
+    const WebCore::WidthCache::Statistics& widthCacheStatistics = WebCore::WidthCache::statistics();
+    ALOGD("Text width cache: %u hits, %u misses, about %.1fms of measuring saved",
+        widthCacheStatistics.hits, widthCacheStatistics.misses,
+        widthCacheStatistics.estimatedTimeSaved() * 1000);
+
+#if ENABLE(DOM_STORAGE)
+    const WebCore::StorageAreaSync::ImportStatistics& importStatistics = WebCore::StorageAreaSync::importStatistics();
+    ALOGD("Local storage import: blocked %u times for %.1fms (longest %.1fms), %u lookups answered during import",
+        importStatistics.blockedCount, importStatistics.totalBlockedTime * 1000,
+        importStatistics.maxBlockedTime * 1000, importStatistics.lookupsDuringImport);
+#endif
 #endif
 }
 
@@ -1405,25 +1428,6 @@ struct TouchNodeData {
     IntRect mBounds;
 };
 
-// get the bounding box of the Node
-static IntRect getAbsoluteBoundingBox(Node* node) {
-    IntRect rect;
-    RenderObject* render = node->renderer();
-    if (!render)
-        return rect;
-    if (render->isRenderInline())
-        rect = toRenderInline(render)->linesVisualOverflowBoundingBox();
-    else if (render->isBox())
-        rect = toRenderBox(render)->visualOverflowRect();
-    else if (render->isText())
-        rect = toRenderText(render)->linesBoundingBox();
-    else
-        ALOGE("getAbsoluteBoundingBox failed for node %p, name %s", node, render->renderName());
-    FloatPoint absPos = render->localToAbsolute(FloatPoint(), false, true);
-    rect.move(absPos.x(), absPos.y());
-    return rect;
-}
-
 WebCore::Frame* WebViewCore::focusedFrame() const
 {
     return m_mainFrame->page()->focusController()->focusedOrMainFrame();
@@ -1835,135 +1839,103 @@ bool WebViewCore::nodeIsClickableOrFocusable(Node* node)
             || node->hasEventListeners(eventNames().mouseoverEvent);
 }
 
-// get the highlight rectangles for the touch point (x, y) with the slop
-AndroidHitTestResult WebViewCore::hitTestAtPoint(int x, int y, int slop, bool doMoveMouse)
+// Adds the node that needs highlight for a node touched by the fat point, if
+// there is one and it does not duplicate or enclose a node already found.
+static void appendTouchNodeData(Node* touchedNode, Frame* frame, Vector<TouchNodeData>& nodeDataList)
 {
-    if (doMoveMouse)
-        moveMouse(x, y, 0, true);
-    HitTestResult hitTestResult = m_mainFrame->eventHandler()->hitTestResultAtPoint(IntPoint(x, y),
-            false, false, DontHitTestScrollbars, HitTestRequest::Active | HitTestRequest::ReadOnly, IntSize(slop, slop));
-    AndroidHitTestResult androidHitResult(this, hitTestResult);
-    if (!hitTestResult.innerNode() || !hitTestResult.innerNode()->inDocument()) {
-        ALOGE("Should not happen: no in document Node found");
-        return androidHitResult;
-    }
-    const ListHashSet<RefPtr<Node> >& list = hitTestResult.rectBasedTestResult();
-    if (list.isEmpty()) {
-        ALOGE("Should not happen: no rect-based-test nodes found");
-        return androidHitResult;
+    // TODO: it seems reasonable to not search across the frame. Isn't it?
+    // if the node is not in the same frame as the innerNode, skip it
+    if (touchedNode->document()->frame() != frame)
+        return;
+    // traverse up the tree to find the first node that needs highlight
+    bool found = false;
+    Node* eventNode = touchedNode;
+    Node* innerNode = eventNode;
+    while (eventNode) {
+        RenderObject* render = eventNode->renderer();
+        if (render && (render->isBody() || render->isRenderView()))
+            break;
+        if (WebViewCore::nodeIsClickableOrFocusable(eventNode)) {
+            found = true;
+            break;
+        }
+        // the nodes in the rectBasedTestResult() are ordered based on z-index during hit testing.
+        // so do not search for the eventNode across explicit z-index border.
+        // TODO: this is a hard one to call. z-index is quite complicated as its value only
+        // matters when you compare two RenderLayer in the same hierarchy level. e.g. in
+        // the following example, "b" is on the top as its z level is the highest. even "c"
+        // has 100 as z-index, it is still below "d" as its parent has the same z-index as
+        // "d" and logically before "d". Of course "a" is the lowest in the z level.
+        //
+        // z-index:auto "a"
+        //   z-index:2 "b"
+        //   z-index:1
+        //     z-index:100 "c"
+        //   z-index:1 "d"
+        //
+        // If the fat point touches everyone, the order in the list should be "b", "d", "c"
+        // and "a". When we search for the event node for "b", we really don't want "a" as
+        // in the z-order it is behind everything else.
+        if (render && !render->style()->hasAutoZIndex())
+            break;
+        eventNode = eventNode->parentNode();
     }
-    Frame* frame = hitTestResult.innerNode()->document()->frame();
-    Vector<TouchNodeData> nodeDataList;
-    if (hitTestResult.innerNode() != hitTestResult.innerNonSharedNode()
-            && hitTestResult.innerNode()->hasTagName(WebCore::HTMLNames::areaTag)) {
-        HTMLAreaElement* area = static_cast<HTMLAreaElement*>(hitTestResult.innerNode());
-        androidHitResult.hitTestResult().setURLElement(area);
-        androidHitResult.highlightRects().append(area->computeRect(
-                hitTestResult.innerNonSharedNode()->renderer()));
-        return androidHitResult;
+    // didn't find any eventNode, skip it
+    if (!found)
+        return;
+    // first quick check whether it is a duplicated node before computing bounding box
+    Vector<TouchNodeData>::const_iterator nlast = nodeDataList.end();
+    for (Vector<TouchNodeData>::const_iterator n = nodeDataList.begin(); n != nlast; ++n) {
+        // found the same node, skip it
+        if (eventNode == n->mUrlNode)
+            return;
     }
-    ListHashSet<RefPtr<Node> >::const_iterator last = list.end();
-    for (ListHashSet<RefPtr<Node> >::const_iterator it = list.begin(); it != last; ++it) {
-        // TODO: it seems reasonable to not search across the frame. Isn't it?
-        // if the node is not in the same frame as the innerNode, skip it
-        if (it->get()->document()->frame() != frame)
-            continue;
-        // traverse up the tree to find the first node that needs highlight
-        bool found = false;
-        Node* eventNode = it->get();
-        Node* innerNode = eventNode;
-        while (eventNode) {
-            RenderObject* render = eventNode->renderer();
-            if (render && (render->isBody() || render->isRenderView()))
-                break;
-            if (nodeIsClickableOrFocusable(eventNode)) {
-                found = true;
-                break;
-            }
-            // the nodes in the rectBasedTestResult() are ordered based on z-index during hit testing.
-            // so do not search for the eventNode across explicit z-index border.
-            // TODO: this is a hard one to call. z-index is quite complicated as its value only
-            // matters when you compare two RenderLayer in the same hierarchy level. e.g. in
-            // the following example, "b" is on the top as its z level is the highest. even "c"
-            // has 100 as z-index, it is still below "d" as its parent has the same z-index as
-            // "d" and logically before "d". Of course "a" is the lowest in the z level.
-            //
-            // z-index:auto "a"
-            //   z-index:2 "b"
-            //   z-index:1
-            //     z-index:100 "c"
-            //   z-index:1 "d"
-            //
-            // If the fat point touches everyone, the order in the list should be "b", "d", "c"
-            // and "a". When we search for the event node for "b", we really don't want "a" as
-            // in the z-order it is behind everything else.
-            if (render && !render->style()->hasAutoZIndex())
-                break;
-            eventNode = eventNode->parentNode();
-        }
-        // didn't find any eventNode, skip it
-        if (!found)
-            continue;
-        // first quick check whether it is a duplicated node before computing bounding box
-        Vector<TouchNodeData>::const_iterator nlast = nodeDataList.end();
-        for (Vector<TouchNodeData>::const_iterator n = nodeDataList.begin(); n != nlast; ++n) {
-            // found the same node, skip it
-            if (eventNode == n->mUrlNode) {
-                found = false;
-                break;
-            }
-        }
-        if (!found)
-            continue;
-        // next check whether the node is fully covered by or fully covering another node.
-        found = false;
-        IntRect rect = getAbsoluteBoundingBox(eventNode);
-        if (rect.isEmpty()) {
-            // if the node's bounds is empty and it is not a ContainerNode, skip it.
-            if (!eventNode->isContainerNode())
-                continue;
-            // if the node's children are all positioned objects, its bounds can be empty.
-            // Walk through the children to find the bounding box.
-            Node* child = static_cast<const ContainerNode*>(eventNode)->firstChild();
-            while (child) {
-                IntRect childrect;
-                if (child->renderer())
-                    childrect = getAbsoluteBoundingBox(child);
-                if (!childrect.isEmpty()) {
-                    rect.unite(childrect);
-                    child = child->traverseNextSibling(eventNode);
-                } else
-                    child = child->traverseNextNode(eventNode);
-            }
-        }
-        for (int i = nodeDataList.size() - 1; i >= 0; i--) {
-            TouchNodeData n = nodeDataList.at(i);
-            // the new node is enclosing an existing node, skip it
-            if (rect.contains(n.mBounds)) {
-                found = true;
-                break;
-            }
-            // the new node is fully inside an existing node, remove the existing node
-            if (n.mBounds.contains(rect))
-                nodeDataList.remove(i);
+    // next check whether the node is fully covered by or fully covering another node.
+    found = false;
+    IntRect rect = TouchHitTestIndex::absoluteBoundingBox(eventNode);
+    if (rect.isEmpty()) {
+        // if the node's bounds is empty and it is not a ContainerNode, skip it.
+        if (!eventNode->isContainerNode())
+            return;
+        // if the node's children are all positioned objects, its bounds can be empty.
+        // Walk through the children to find the bounding box.
+        Node* child = static_cast<const ContainerNode*>(eventNode)->firstChild();
+        while (child) {
+            IntRect childrect;
+            if (child->renderer())
+                childrect = TouchHitTestIndex::absoluteBoundingBox(child);
+            if (!childrect.isEmpty()) {
+                rect.unite(childrect);
+                child = child->traverseNextSibling(eventNode);
+            } else
+                child = child->traverseNextNode(eventNode);
         }
-        if (!found) {
-            TouchNodeData newNode;
-            newNode.mUrlNode = eventNode;
-            newNode.mBounds = rect;
-            newNode.mInnerNode = innerNode;
-            nodeDataList.append(newNode);
+    }
+    for (int i = nodeDataList.size() - 1; i >= 0; i--) {
+        TouchNodeData n = nodeDataList.at(i);
+        // the new node is enclosing an existing node, skip it
+        if (rect.contains(n.mBounds)) {
+            found = true;
+            break;
         }
+        // the new node is fully inside an existing node, remove the existing node
+        if (n.mBounds.contains(rect))
+            nodeDataList.remove(i);
     }
-    if (!nodeDataList.size()) {
-        androidHitResult.searchContentDetectors();
-        return androidHitResult;
+    if (!found) {
+        TouchNodeData newNode;
+        newNode.mUrlNode = eventNode;
+        newNode.mBounds = rect;
+        newNode.mInnerNode = innerNode;
+        nodeDataList.append(newNode);
     }
-    // finally select the node with the largest overlap with the fat point
+}
+
+// select the node with the largest overlap with the fat point
+static TouchNodeData findLargestOverlap(const Vector<TouchNodeData>& nodeDataList, const IntRect& testRect)
+{
     TouchNodeData final;
     final.mUrlNode = 0;
-    IntPoint docPos = frame->view()->windowToContents(m_mousePos);
-    IntRect testRect(docPos.x() - slop, docPos.y() - slop, 2 * slop + 1, 2 * slop + 1);
     int area = 0;
     Vector<TouchNodeData>::const_iterator nlast = nodeDataList.end();
     for (Vector<TouchNodeData>::const_iterator n = nodeDataList.begin(); n != nlast; ++n) {
@@ -1975,6 +1947,110 @@ AndroidHitTestResult WebViewCore::hitTestAtPoint(int x, int y, int slop, bool do
             area = a;
         }
     }
+    return final;
+}
+
+bool WebViewCore::findTouchNodeWithIndex(int x, int y, int slop,
+    HitTestResult& hitTestResult, TouchNodeData& final)
+{
+    if (!m_touchHitTestIndexEnabled)
+        return false;
+    hitTestResult = m_mainFrame->eventHandler()->hitTestResultAtPoint(IntPoint(x, y),
+            false, false, DontHitTestScrollbars, HitTestRequest::Active | HitTestRequest::ReadOnly);
+    Node* innerNode = hitTestResult.innerNode();
+    // the index only covers the main frame, and knows nothing about image maps
+    if (!innerNode || !innerNode->inDocument() || innerNode->document()->frame() != m_mainFrame)
+        return false;
+    if (innerNode != hitTestResult.innerNonSharedNode() && innerNode->hasTagName(HTMLNames::areaTag))
+        return false;
+
+    Vector<Node*> touchedNodes;
+    IntRect touchRect(x - slop, y - slop, 2 * slop + 1, 2 * slop + 1);
+    if (!m_touchHitTestIndex.nodesInRect(m_mainFrame, touchRect, touchedNodes))
+        return false;
+    Vector<TouchNodeData> nodeDataList;
+    for (size_t i = 0; i < touchedNodes.size(); ++i)
+        appendTouchNodeData(touchedNodes[i], m_mainFrame, nodeDataList);
+    // The index stores untransformed layout rects and knows nothing about
+    // inline SVG, so an empty answer is not trusted: use the rect-based test.
+    if (!nodeDataList.size())
+        return false;
+
+    // Whatever is clickable under the touch point itself must be among the
+    // candidates, otherwise the index has missed it.
+    Vector<TouchNodeData> pointNodeData;
+    appendTouchNodeData(innerNode, m_mainFrame, pointNodeData);
+    if (pointNodeData.size()) {
+        bool pointNodeFound = false;
+        for (size_t i = 0; i < nodeDataList.size() && !pointNodeFound; ++i)
+            pointNodeFound = nodeDataList[i].mUrlNode == pointNodeData[0].mUrlNode;
+        if (!pointNodeFound)
+            return false;
+    }
+
+    IntPoint docPos = m_mainFrame->view()->windowToContents(m_mousePos);
+    IntRect testRect(docPos.x() - slop, docPos.y() - slop, 2 * slop + 1, 2 * slop + 1);
+    final = findLargestOverlap(nodeDataList, testRect);
+
+    // The index does not know what is painted on top, so check that nothing
+    // covers the chosen node where the fat point touches it.
+    IntRect overlap = final.mBounds;
+    overlap.intersect(testRect);
+    if (overlap.isEmpty())
+        return false;
+    HitTestResult overlapResult = m_mainFrame->eventHandler()->hitTestResultAtPoint(overlap.center(),
+            false, false, DontHitTestScrollbars, HitTestRequest::Active | HitTestRequest::ReadOnly);
+    for (Node* node = overlapResult.innerNode(); node; node = node->parentOrHostNode()) {
+        if (node == final.mUrlNode)
+            return true;
+    }
+    return false;
+}
+
+void WebViewCore::setTouchHitTestIndexEnabled(bool enabled)
+{
+    m_touchHitTestIndexEnabled = enabled;
+    m_touchHitTestIndex.clear();
+}
+
+// get the highlight rectangles for the touch point (x, y) with the slop
+AndroidHitTestResult WebViewCore::hitTestAtPoint(int x, int y, int slop, bool doMoveMouse)
+{
+    if (doMoveMouse)
+        moveMouse(x, y, 0, true);
+    HitTestResult hitTestResult;
+    TouchNodeData final;
+    if (!findTouchNodeWithIndex(x, y, slop, hitTestResult, final)) {
+        hitTestResult = m_mainFrame->eventHandler()->hitTestResultAtPoint(IntPoint(x, y),
+                false, false, DontHitTestScrollbars, HitTestRequest::Active | HitTestRequest::ReadOnly, IntSize(slop, slop));
+        if (!hitTestResult.innerNode() || !hitTestResult.innerNode()->inDocument()) {
+            ALOGE("Should not happen: no in document Node found");
+            return AndroidHitTestResult(this, hitTestResult);
+        }
+        const ListHashSet<RefPtr<Node> >& list = hitTestResult.rectBasedTestResult();
+        if (list.isEmpty()) {
+            ALOGE("Should not happen: no rect-based-test nodes found");
+            return AndroidHitTestResult(this, hitTestResult);
+        }
+        Frame* frame = hitTestResult.innerNode()->document()->frame();
+        if (hitTestResult.innerNode() != hitTestResult.innerNonSharedNode()
+                && hitTestResult.innerNode()->hasTagName(WebCore::HTMLNames::areaTag)) {
+            AndroidHitTestResult androidHitResult(this, hitTestResult);
+            HTMLAreaElement* area = static_cast<HTMLAreaElement*>(hitTestResult.innerNode());
+            androidHitResult.hitTestResult().setURLElement(area);
+            androidHitResult.highlightRects().append(area->computeRect(
+                    hitTestResult.innerNonSharedNode()->renderer()));
+            return androidHitResult;
+        }
+        Vector<TouchNodeData> nodeDataList;
+        ListHashSet<RefPtr<Node> >::const_iterator last = list.end();
+        for (ListHashSet<RefPtr<Node> >::const_iterator it = list.begin(); it != last; ++it)
+            appendTouchNodeData(it->get(), frame, nodeDataList);
+        IntPoint docPos = frame->view()->windowToContents(m_mousePos);
+        IntRect testRect(docPos.x() - slop, docPos.y() - slop, 2 * slop + 1, 2 * slop + 1);
+        final = findLargestOverlap(nodeDataList, testRect);
+    }
+    AndroidHitTestResult androidHitResult(this, hitTestResult);
     // now get the node's highlight rectangles in the page coordinate system
     if (final.mUrlNode) {
         // Update innerNode and innerNonSharedNode
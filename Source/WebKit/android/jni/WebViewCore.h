@@ -41,6 +41,7 @@
 #include "SkRegion.h"
 #include "Text.h"
 #include "Timer.h"
+#include "TouchHitTestIndex.h"
 #include "WebCoreRefObject.h"
 #include "WebCoreJni.h"
 #include "WebRequestContext.h"
@@ -107,6 +108,7 @@ namespace android {
 
     class ListBoxReply;
     class AndroidHitTestResult;
+    struct TouchNodeData;
 
     class WebCoreReply : public WebCoreRefObject {
     public:
@@ -498,6 +500,9 @@ namespace android {
         // This does a sloppy hit test
         AndroidHitTestResult hitTestAtPoint(int x, int y, int slop, bool doMoveMouse = false);
         static bool nodeIsClickableOrFocusable(WebCore::Node* node);
+        // Lets the debug server compare hitTestAtPoint with and without
+        // m_touchHitTestIndex.
+        void setTouchHitTestIndexEnabled(bool);
 
         // Open a file chooser for selecting a file to upload
         void openFileChooser(PassRefPtr<WebCore::FileChooser> );
@@ -631,6 +636,10 @@ namespace android {
         WebCore::HTMLElement* retrieveElement(int x, int y,
             const WebCore::QualifiedName& );
         WebCore::HTMLImageElement* retrieveImageElement(int x, int y);
+        // Finds the node to highlight for a touch with m_touchHitTestIndex.
+        // Returns false if the rect-based hit test has to be done instead.
+        bool findTouchNodeWithIndex(int x, int y, int slop,
+            WebCore::HitTestResult&, TouchNodeData&);
         // below are members responsible for accessibility support
         WTF::String modifySelectionTextNavigationAxis(WebCore::DOMSelection* selection,
                                                  int direction, int granularity);
@@ -792,6 +801,8 @@ namespace android {
 
         int m_screenOnCounter;
         WebCore::Node* m_currentNodeDomNavigationAxis;
+        TouchHitTestIndex m_touchHitTestIndex;
+        bool m_touchHitTestIndexEnabled;
         DeviceMotionAndOrientationManager m_deviceMotionAndOrientationManager;
         GeolocationManager m_geolocationManager;
 
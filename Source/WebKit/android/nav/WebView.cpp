@@ -31,6 +31,7 @@
 #include "AndroidLog.h"
 #include "BaseLayerAndroid.h"
 #include "BaseRenderer.h"
+#include "BitmapAllocatorAndroid.h"
 #include "DrawExtra.h"
 #include "DumpLayer.h"
 #include "Frame.h"
@@ -1176,6 +1177,10 @@ static void nativeOnTrimMemory(JNIEnv *env, jobject obj, jint level)
         bool freeAllTextures = (level > TRIM_MEMORY_UI_HIDDEN), glTextures = true;
         tilesManager->discardTextures(freeAllTextures, glTextures);
     }
+
+    // Unlocked decoded images are decoded again when they are next drawn.
+    if (level >= TRIM_MEMORY_UI_HIDDEN)
+        WebCore::BitmapAllocatorAndroid::purgeUnlockedPixels();
 }
 
 static void nativeDumpDisplayTree(JNIEnv* env, jobject jwebview, jstring jurl)
@@ -26,15 +26,20 @@
 #define LOG_TAG "wds"
 #include "config.h"
 
+#include "AndroidHitTestResult.h"
 #include "AndroidLog.h"
 #include "Command.h"
 #include "Connection.h"
 #include "DebugServer.h"
 #include "Frame.h"
+#include "FrameView.h"
+#include "IntPoint.h"
 #include "RenderTreeAsText.h"
 #include "RenderView.h"
 #include "WebViewCore.h"
+#include <stdio.h>
 #include <utils/Log.h>
+#include <wtf/CurrentTime.h>
 #include <wtf/text/CString.h>
 
 #if ENABLE(WDS)
@@ -73,6 +78,57 @@ static bool callDumpDomTree(const Frame* frame, const Connection* conn) {
     return true;
 }
 
+// Tap coordinates recorded against a saved page, one "x y" pair in document
+// coordinates per line.
+#define TAPS_FILE "/sdcard/webcoreTaps.txt"
+
+static const int s_tapSlop = 24;
+
+static void loadTaps(Frame* frame, Vector<IntPoint>& taps) {
+    FILE* f = fopen(TAPS_FILE, "r");
+    if (f) {
+        int x, y;
+        while (fscanf(f, "%d %d", &x, &y) == 2)
+            taps.append(IntPoint(x, y));
+        fclose(f);
+        return;
+    }
+    // Without a recording, tap a grid over the whole document.
+    IntSize size = frame->view()->contentsSize();
+    for (int y = s_tapSlop; y < size.height(); y += 97) {
+        for (int x = s_tapSlop; x < size.width(); x += 61)
+            taps.append(IntPoint(x, y));
+    }
+}
+
+static double replayTaps(WebViewCore* core, const Vector<IntPoint>& taps) {
+    double start = WTF::currentTime();
+    for (size_t i = 0; i < taps.size(); ++i)
+        core->hitTestAtPoint(taps[i].x(), taps[i].y(), s_tapSlop, true);
+    return (WTF::currentTime() - start) * 1000 / taps.size();
+}
+
+static bool callReplayTaps(const Frame* frame, const Connection* conn) {
+    WebViewCore* core = WebViewCore::getWebViewCore(frame->view());
+    Vector<IntPoint> taps;
+    loadTaps(core->mainFrame(), taps);
+    if (taps.isEmpty())
+        return false;
+
+    core->setTouchHitTestIndexEnabled(false);
+    double withoutIndex = replayTaps(core, taps);
+    core->setTouchHitTestIndexEnabled(true);
+    double firstPass = replayTaps(core, taps);
+    double secondPass = replayTaps(core, taps);
+
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%u taps: %.3fms per tap without the index, "
+            "%.3fms on the first pass with it, %.3fms after\n",
+            static_cast<unsigned>(taps.size()), withoutIndex, firstPass, secondPass);
+    conn->write(buf);
+    return true;
+}
+
 class WebCoreHandler : public Handler {
 public:
     virtual void post(TargetThreadFunction func, void* v) const {
@@ -128,6 +184,8 @@ void Command::Init() {
                 callDumpDomTree, s_webcoreHandler));
     s_commands->append(new Command("DDRT", "Dump Render Tree",
                 callDumpRenderTree, s_webcoreHandler));
+    s_commands->append(new Command("TAPS", "Replay Touch Hit Tests",
+                callReplayTaps, s_webcoreHandler));
 }
 
 Command* Command::Find(const Connection* conn) {
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+// The other FFTFrame backends are thin wrappers around vecLib, MKL and FFTW.
+#if ENABLE(WEB_AUDIO) && USE(WEBAUDIO_BUILTIN_FFT)
+
+#include "FFTFrame.h"
+
+#include <gtest/gtest.h>
+#include <math.h>
+#include <stdio.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/MathExtras.h>
+#include <wtf/Vector.h>
+
+using namespace WebCore;
+
+namespace {
+
+class FFTFrameTest : public testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        FFTFrame::initialize();
+    }
+
+    static void fillWithNoise(Vector<float>& data)
+    {
+        unsigned seed = 1;
+        for (size_t i = 0; i < data.size(); ++i) {
+            seed = seed * 1103515245 + 12345;
+            data[i] = static_cast<float>((seed >> 16) & 0x7fff) / 0x7fff - 0.5f;
+        }
+    }
+};
+
+// The frequency domain data is scaled by 2, with the Nyquist component packed
+// in the imaginary part of the DC component, like vecLib on the Mac.
+TEST_F(FFTFrameTest, ForwardMatchesDFT)
+{
+    for (unsigned fftSize = 2; fftSize <= 1024; fftSize *= 2) {
+        Vector<float> data(fftSize);
+        fillWithNoise(data);
+
+        FFTFrame frame(fftSize);
+        frame.doFFT(data.data());
+
+        double maxError = 0;
+        double maxMagnitude = 0;
+        for (unsigned k = 0; k <= fftSize / 2; ++k) {
+            double real = 0;
+            double imag = 0;
+            for (unsigned j = 0; j < fftSize; ++j) {
+                double phase = -2 * piDouble * k * j / fftSize;
+                real += 2 * data[j] * cos(phase);
+                imag += 2 * data[j] * sin(phase);
+            }
+
+            double frameReal;
+            double frameImag = 0;
+            if (!k)
+                frameReal = frame.realData()[0];
+            else if (k == fftSize / 2)
+                frameReal = frame.imagData()[0];
+            else {
+                frameReal = frame.realData()[k];
+                frameImag = frame.imagData()[k];
+            }
+
+            maxError = std::max(maxError, std::max(fabs(frameReal - real), fabs(frameImag - imag)));
+            maxMagnitude = std::max(maxMagnitude, sqrt(real * real + imag * imag));
+        }
+        EXPECT_LT(maxError, 1e-5 * maxMagnitude) << "fftSize " << fftSize;
+    }
+}
+
+TEST_F(FFTFrameTest, InverseRestoresInput)
+{
+    for (unsigned fftSize = 2; fftSize <= 32768; fftSize *= 2) {
+        Vector<float> data(fftSize);
+        fillWithNoise(data);
+        Vector<float> result(fftSize);
+
+        FFTFrame frame(fftSize);
+        frame.doFFT(data.data());
+        frame.doInverseFFT(result.data());
+
+        for (unsigned i = 0; i < fftSize; ++i)
+            ASSERT_NEAR(data[i], result[i], 1e-5) << "fftSize " << fftSize << " index " << i;
+    }
+}
+
+TEST_F(FFTFrameTest, MultiplyConvolves)
+{
+    const unsigned fftSize = 256;
+    Vector<float> impulse(fftSize, 0);
+    impulse[3] = 1;
+    Vector<float> data(fftSize);
+    fillWithNoise(data);
+    // Zero pad so that the circular convolution is a linear one.
+    for (unsigned i = fftSize / 2; i < fftSize; ++i)
+        data[i] = 0;
+
+    FFTFrame kernel(fftSize);
+    kernel.doFFT(impulse.data());
+    FFTFrame frame(fftSize);
+    frame.doFFT(data.data());
+    frame.multiply(kernel);
+
+    Vector<float> result(fftSize);
+    frame.doInverseFFT(result.data());
+
+    // Convolving with a delayed impulse delays the signal.
+    for (unsigned i = 0; i < fftSize; ++i)
+        EXPECT_NEAR(i >= 3 ? data[i - 3] : 0, result[i], 1e-5) << "index " << i;
+}
+
+// Measures doFFT / doInverseFFT throughput at the sizes used by FFTConvolver
+// (HRTFPanner) and the stages of ReverbConvolver. Disabled by default; run it
+// with --gtest_also_run_disabled_tests --gtest_filter=FFTFrameTest.*.
+TEST_F(FFTFrameTest, DISABLED_Throughput)
+{
+    for (unsigned fftSize = 256; fftSize <= 32768; fftSize *= 2) {
+        Vector<float> data(fftSize);
+        fillWithNoise(data);
+        FFTFrame frame(fftSize);
+
+        // About the same amount of work for every size.
+        unsigned iterations = (1 << 25) / fftSize;
+
+        double start = currentTime();
+        for (unsigned i = 0; i < iterations; ++i)
+            frame.doFFT(data.data());
+        double forwardTime = currentTime() - start;
+
+        start = currentTime();
+        for (unsigned i = 0; i < iterations; ++i) {
+            // doInverseFFT may consume the frequency domain data.
+            frame.doInverseFFT(data.data());
+            frame.doFFT(data.data());
+        }
+        double inverseTime = currentTime() - start - forwardTime;
+
+        printf("fftSize %5u: doFFT %8.2f us, doInverseFFT %8.2f us, %8.1f Msamples/s\n",
+            fftSize,
+            1e6 * forwardTime / iterations,
+            1e6 * inverseTime / iterations,
+            fftSize * iterations / forwardTime / 1e6);
+    }
+}
+
+} // namespace
+
+#endif // ENABLE(WEB_AUDIO) && USE(WEBAUDIO_BUILTIN_FFT)
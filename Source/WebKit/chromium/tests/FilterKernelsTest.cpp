@@ -0,0 +1,198 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#if ENABLE(FILTERS)
+
+#include "FEColorMatrix.h"
+#include "FEComposite.h"
+#include "FEGaussianBlur.h"
+#include "FEMorphology.h"
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <wtf/Vector.h>
+
+using namespace WebCore;
+
+namespace {
+
+// Checks the SSE2 and NEON filter kernels against the scalar code they
+// replace. On other CPUs both sides are the scalar code.
+
+// Covers images narrower than a SIMD register and widths that leave a tail.
+const int widths[] = { 1, 2, 3, 4, 5, 7, 8, 9, 16, 17, 33 };
+const int heights[] = { 1, 2, 5, 12 };
+
+class FilterKernelsTest : public testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        m_seed = 1;
+    }
+
+    unsigned random()
+    {
+        m_seed = m_seed * 1103515245 + 12345;
+        return (m_seed >> 16) & 0x7fff;
+    }
+
+    // Fills an image with premultiplied pixels, or with any bytes at all.
+    void fill(Vector<unsigned char>& pixels, size_t size, bool premultiplied)
+    {
+        pixels.resize(size);
+        for (size_t i = 0; i < size; i += 4) {
+            unsigned char alpha = random() % 256;
+            for (size_t channel = 0; channel < 3; ++channel)
+                pixels[i + channel] = random() % (premultiplied ? alpha + 1 : 256);
+            pixels[i + 3] = alpha;
+        }
+    }
+
+    static int maxDifference(const Vector<unsigned char>& a, const Vector<unsigned char>& b)
+    {
+        int difference = 0;
+        for (size_t i = 0; i < a.size(); ++i)
+            difference = std::max(difference, abs(a[i] - b[i]));
+        return difference;
+    }
+
+    unsigned m_seed;
+};
+
+TEST_F(FilterKernelsTest, boxBlur)
+{
+    // The three passes of a blur with an odd and an even kernel size.
+    const struct {
+        unsigned dx;
+        int dxLeft;
+        int dxRight;
+    } kernels[] = { { 5, 2, 3 }, { 6, 2, 4 }, { 6, 3, 3 }, { 7, 3, 4 }, { 40, 19, 21 } };
+
+    for (size_t w = 0; w < WTF_ARRAY_LENGTH(widths); ++w) {
+        for (size_t h = 0; h < WTF_ARRAY_LENGTH(heights); ++h) {
+            for (size_t k = 0; k < WTF_ARRAY_LENGTH(kernels); ++k) {
+                for (int vertical = 0; vertical < 2; ++vertical) {
+                    int width = widths[w];
+                    int height = heights[h];
+                    int stride = vertical ? width * 4 : 4;
+                    int strideLine = vertical ? 4 : width * 4;
+                    int effectWidth = vertical ? height : width;
+                    int effectHeight = vertical ? width : height;
+
+                    Vector<unsigned char> source;
+                    fill(source, width * height * 4, true);
+                    Vector<unsigned char> expected(source.size());
+                    Vector<unsigned char> actual(source.size());
+                    FEGaussianBlur::boxBlurScalar(source.data(), expected.data(), kernels[k].dx, kernels[k].dxLeft, kernels[k].dxRight,
+                                                  stride, strideLine, effectWidth, 0, effectHeight, false);
+                    FEGaussianBlur::boxBlur(source.data(), actual.data(), kernels[k].dx, kernels[k].dxLeft, kernels[k].dxRight,
+                                            stride, strideLine, effectWidth, 0, effectHeight, false);
+                    ASSERT_EQ(0, maxDifference(expected, actual)) << "width " << width << " height " << height << " kernel " << kernels[k].dx << " vertical " << vertical;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(FilterKernelsTest, morphology)
+{
+    const int radii[] = { 0, 1, 2, 3, 6 };
+
+    for (size_t w = 0; w < WTF_ARRAY_LENGTH(widths); ++w) {
+        for (size_t h = 0; h < WTF_ARRAY_LENGTH(heights); ++h) {
+            for (size_t r = 0; r < WTF_ARRAY_LENGTH(radii); ++r) {
+                for (int erode = 0; erode < 2; ++erode) {
+                    int width = widths[w];
+                    int height = heights[h];
+                    int radiusX = std::min(width - 1, radii[r]);
+                    int radiusY = std::min(height - 1, radii[(r + 1) % WTF_ARRAY_LENGTH(radii)]);
+                    MorphologyOperatorType type = erode ? FEMORPHOLOGY_OPERATOR_ERODE : FEMORPHOLOGY_OPERATOR_DILATE;
+
+                    Vector<unsigned char> source;
+                    fill(source, width * height * 4, true);
+                    Vector<unsigned char> expected(source.size());
+                    Vector<unsigned char> actual(source.size());
+                    FEMorphology::platformApplyScalar(source.data(), expected.data(), type, width, height, radiusX, radiusY, 0, height);
+                    // Split the rows the way parallel jobs would.
+                    FEMorphology::platformApply(source.data(), actual.data(), type, width, height, radiusX, radiusY, 0, height / 2);
+                    FEMorphology::platformApply(source.data(), actual.data(), type, width, height, radiusX, radiusY, height / 2, height);
+                    ASSERT_EQ(0, maxDifference(expected, actual)) << "width " << width << " height " << height << " radius " << radiusX << "x" << radiusY << " erode " << erode;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(FilterKernelsTest, colorMatrix)
+{
+    const ColorMatrixType types[] = { FECOLORMATRIX_TYPE_MATRIX, FECOLORMATRIX_TYPE_SATURATE, FECOLORMATRIX_TYPE_HUEROTATE, FECOLORMATRIX_TYPE_LUMINANCETOALPHA };
+
+    for (size_t t = 0; t < WTF_ARRAY_LENGTH(types); ++t) {
+        for (int run = 0; run < 40; ++run) {
+            // Every other run uses values that may not fit in the fixed point
+            // matrix, so that both the fixed point and the double code are covered.
+            float range = run % 2 ? 20 : 2;
+            Vector<float> values(types[t] == FECOLORMATRIX_TYPE_MATRIX ? 20 : 1);
+            for (size_t i = 0; i < values.size(); ++i)
+                values[i] = (static_cast<float>(random() % 2000) / 1000 - 1) * range / 2;
+            if (types[t] == FECOLORMATRIX_TYPE_HUEROTATE)
+                values[0] = static_cast<float>(random() % 720) - 360;
+
+            unsigned pixelCount = 1 + random() % 100;
+            Vector<unsigned char> expected;
+            fill(expected, pixelCount * 4, false);
+            Vector<unsigned char> actual = expected;
+            FEColorMatrix::calculateScalar(expected.data(), pixelCount, types[t], values);
+            FEColorMatrix::calculate(actual.data(), pixelCount, types[t], values);
+            ASSERT_EQ(0, maxDifference(expected, actual)) << "type " << types[t] << " run " << run;
+        }
+    }
+}
+
+TEST_F(FilterKernelsTest, compositeArithmetic)
+{
+    for (int run = 0; run < 100; ++run) {
+        float k[4];
+        // Zero coefficients take different paths.
+        for (int i = 0; i < 4; ++i)
+            k[i] = random() % 3 ? static_cast<float>(random() % 4000) / 1000 - 2 : 0;
+
+        unsigned length = 4 * (1 + random() % 100);
+        Vector<unsigned char> source;
+        fill(source, length, true);
+        Vector<unsigned char> expected;
+        fill(expected, length, true);
+        Vector<unsigned char> actual = expected;
+        FEComposite::computeArithmeticScalar(source.data(), expected.data(), length, k[0], k[1], k[2], k[3]);
+        FEComposite::computeArithmetic(source.data(), actual.data(), length, k[0], k[1], k[2], k[3]);
+        ASSERT_EQ(0, maxDifference(expected, actual)) << "k " << k[0] << " " << k[1] << " " << k[2] << " " << k[3];
+    }
+}
+
+} // namespace
+
+#endif // ENABLE(FILTERS)
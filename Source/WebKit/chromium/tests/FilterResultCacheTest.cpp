@@ -0,0 +1,192 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#if ENABLE(FILTERS)
+
+#include "FEGaussianBlur.h"
+#include "FETurbulence.h"
+#include "Filter.h"
+#include "FilterResultCache.h"
+#include "ImageBuffer.h"
+#include "SourceGraphic.h"
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <wtf/ByteArray.h>
+
+using namespace WebCore;
+
+namespace {
+
+const int size = 64;
+
+class TestFilter : public Filter {
+public:
+    static PassRefPtr<TestFilter> create() { return adoptRef(new TestFilter); }
+
+    virtual FloatRect sourceImageRect() const { return FloatRect(0, 0, size, size); }
+    virtual FloatRect filterRegion() const { return FloatRect(0, 0, size, size); }
+    virtual bool effectBoundingBoxMode() const { return false; }
+
+private:
+    TestFilter() { setFilterResolution(FloatSize(1, 1)); }
+};
+
+class FilterResultCacheTest : public testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        cache()->evictAll();
+        m_hits = cache()->statistics().hits;
+        m_misses = cache()->statistics().misses;
+    }
+
+    static FilterResultCache* cache() { return FilterResultCache::shared(); }
+
+    unsigned hits() const { return cache()->statistics().hits - m_hits; }
+    unsigned misses() const { return cache()->statistics().misses - m_misses; }
+
+    // Builds turbulence blurred by |deviation|, the way a new filter graph is
+    // built for every repaint of a filtered element.
+    static PassRefPtr<FilterEffect> createGraph(Filter* filter, float deviation)
+    {
+        RefPtr<FilterEffect> turbulence = FETurbulence::create(filter, FETURBULENCE_TYPE_TURBULENCE, 0.05f, 0.05f, 2, 0, false);
+        RefPtr<FilterEffect> blur = FEGaussianBlur::create(filter, deviation, deviation);
+        blur->inputEffects().append(turbulence);
+        FilterEffect* effects[] = { turbulence.get(), blur.get() };
+        for (size_t i = 0; i < WTF_ARRAY_LENGTH(effects); ++i) {
+            effects[i]->setMaxEffectRect(FloatRect(0, 0, size, size));
+            effects[i]->setFilterPrimitiveSubregion(FloatRect(0, 0, size, size));
+        }
+        return blur.release();
+    }
+
+    static PassRefPtr<FilterEffect> createSourceGraphic(Filter* filter)
+    {
+        RefPtr<FilterEffect> source = SourceGraphic::create(filter);
+        source->setMaxEffectRect(FloatRect(0, 0, size, size));
+        source->setFilterPrimitiveSubregion(FloatRect(0, 0, size, size));
+        return source.release();
+    }
+
+    static PassRefPtr<ByteArray> result(FilterEffect* effect)
+    {
+        return effect->asUnmultipliedImage(IntRect(IntPoint(), effect->absolutePaintRect().size()));
+    }
+
+private:
+    unsigned m_hits;
+    unsigned m_misses;
+};
+
+TEST_F(FilterResultCacheTest, ReusesUnchangedGraph)
+{
+    RefPtr<Filter> filter = TestFilter::create();
+    RefPtr<FilterEffect> first = createGraph(filter.get(), 2);
+    cache()->apply(first.get());
+    EXPECT_EQ(0u, hits());
+    EXPECT_EQ(2u, misses());
+
+    RefPtr<FilterEffect> second = createGraph(filter.get(), 2);
+    cache()->apply(second.get());
+    EXPECT_EQ(2u, hits());
+    EXPECT_EQ(2u, misses());
+
+    EXPECT_EQ(first->absolutePaintRect(), second->absolutePaintRect());
+    RefPtr<ByteArray> expected = result(first.get());
+    RefPtr<ByteArray> actual = result(second.get());
+    ASSERT_EQ(expected->length(), actual->length());
+    EXPECT_EQ(0, memcmp(expected->data(), actual->data(), expected->length()));
+}
+
+TEST_F(FilterResultCacheTest, ReappliesChangedEffectsOnly)
+{
+    RefPtr<Filter> filter = TestFilter::create();
+    RefPtr<FilterEffect> first = createGraph(filter.get(), 2);
+    cache()->apply(first.get());
+
+    RefPtr<FilterEffect> second = createGraph(filter.get(), 3);
+    cache()->apply(second.get());
+    // The turbulence is shared, the blur is not.
+    EXPECT_EQ(1u, hits());
+    EXPECT_EQ(3u, misses());
+
+    RefPtr<FilterEffect> uncached = createGraph(filter.get(), 3);
+    uncached->apply();
+    RefPtr<ByteArray> expected = result(uncached.get());
+    RefPtr<ByteArray> actual = result(second.get());
+    ASSERT_EQ(expected->length(), actual->length());
+    EXPECT_EQ(0, memcmp(expected->data(), actual->data(), expected->length()));
+}
+
+TEST_F(FilterResultCacheTest, KeysSourceOnSourceImageIdentifier)
+{
+    RefPtr<Filter> filter = TestFilter::create();
+    filter->setSourceImage(ImageBuffer::create(IntSize(size, size)));
+
+    // Without an identifier the source is not known to be unchanged.
+    RefPtr<FilterEffect> unidentified = createSourceGraphic(filter.get());
+    cache()->apply(unidentified.get());
+    EXPECT_EQ(0u, hits());
+    EXPECT_EQ(0u, misses());
+
+    filter->setSourceImageIdentifier(1);
+    RefPtr<FilterEffect> first = createSourceGraphic(filter.get());
+    cache()->apply(first.get());
+    RefPtr<FilterEffect> second = createSourceGraphic(filter.get());
+    cache()->apply(second.get());
+    EXPECT_EQ(1u, hits());
+    EXPECT_EQ(1u, misses());
+
+    filter->setSourceImageIdentifier(2);
+    RefPtr<FilterEffect> changed = createSourceGraphic(filter.get());
+    cache()->apply(changed.get());
+    EXPECT_EQ(1u, hits());
+    EXPECT_EQ(2u, misses());
+}
+
+TEST_F(FilterResultCacheTest, EvictsToCapacity)
+{
+    RefPtr<Filter> filter = TestFilter::create();
+    RefPtr<FilterEffect> effect = createGraph(filter.get(), 2);
+    cache()->apply(effect.get());
+    EXPECT_GT(cache()->size(), 0u);
+
+    size_t capacity = cache()->capacity();
+
+    // Room for one result only.
+    cache()->setCapacity(size * size * 4);
+    EXPECT_LE(cache()->size(), static_cast<size_t>(size * size * 4));
+
+    cache()->setCapacity(0);
+    EXPECT_EQ(0u, cache()->size());
+    cache()->setCapacity(capacity);
+}
+
+} // namespace
+
+#endif // ENABLE(FILTERS)
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#if ENABLE(WEB_AUDIO)
+
+#include "VectorMath.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <math.h>
+#include <wtf/Vector.h>
+
+using namespace WebCore;
+using namespace WebCore::VectorMath;
+
+namespace {
+
+// Covers empty vectors, vectors shorter than a SIMD register, and lengths
+// that leave a tail after the vectorized part.
+const size_t lengths[] = { 0, 1, 3, 4, 5, 7, 8, 15, 16, 17, 31, 128, 129 };
+// Offsets from a 16-byte aligned address, to exercise the unaligned heads.
+const size_t offsets[] = { 0, 1, 2, 3 };
+const int strides[] = { 1, 2, 3 };
+
+const size_t maxLength = 129;
+const int maxStride = 3;
+const size_t bufferSize = 4 + maxLength * maxStride + 4;
+
+class VectorMathTest : public testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        fill(m_source1, 1);
+        fill(m_source2, 2);
+        fill(m_destination, 3);
+    }
+
+    static void fill(Vector<float>& buffer, unsigned seed)
+    {
+        buffer.resize(bufferSize);
+        for (size_t i = 0; i < buffer.size(); ++i) {
+            seed = seed * 1103515245 + 12345;
+            buffer[i] = static_cast<float>((seed >> 16) & 0x7fff) / 0x4000 - 1;
+        }
+    }
+
+    // Returns a pointer offset by the given number of floats from a 16-byte
+    // aligned address inside the buffer.
+    static float* at(Vector<float>& buffer, size_t offset)
+    {
+        size_t address = reinterpret_cast<size_t>(buffer.data());
+        size_t misalignment = (address & 0x0F) / sizeof(float);
+        return buffer.data() + (misalignment ? 4 - misalignment : 0) + offset;
+    }
+
+    Vector<float> m_source1;
+    Vector<float> m_source2;
+    Vector<float> m_destination;
+};
+
+TEST_F(VectorMathTest, vsmul)
+{
+    const float scale = 0.7f;
+    for (size_t l = 0; l < WTF_ARRAY_LENGTH(lengths); ++l) {
+        for (size_t o = 0; o < WTF_ARRAY_LENGTH(offsets); ++o) {
+            for (size_t s = 0; s < WTF_ARRAY_LENGTH(strides); ++s) {
+                size_t length = lengths[l];
+                int stride = strides[s];
+                const float* source = at(m_source1, offsets[o]);
+                Vector<float> expected = m_destination;
+                float* expectedP = at(expected, offsets[(o + 1) % 4]);
+                for (size_t i = 0; i < length; ++i)
+                    expectedP[i * stride] = scale * source[i * stride];
+
+                float* destination = at(m_destination, offsets[(o + 1) % 4]);
+                vsmul(source, stride, &scale, destination, stride, length);
+                for (size_t i = 0; i < bufferSize; ++i)
+                    ASSERT_EQ(expected[i], m_destination[i]) << "length " << length << " offset " << offsets[o] << " stride " << stride;
+            }
+        }
+    }
+}
+
+TEST_F(VectorMathTest, vadd)
+{
+    for (size_t l = 0; l < WTF_ARRAY_LENGTH(lengths); ++l) {
+        for (size_t o = 0; o < WTF_ARRAY_LENGTH(offsets); ++o) {
+            for (size_t s = 0; s < WTF_ARRAY_LENGTH(strides); ++s) {
+                size_t length = lengths[l];
+                int stride = strides[s];
+                const float* source1 = at(m_source1, offsets[o]);
+                const float* source2 = at(m_source2, offsets[(o + 2) % 4]);
+                Vector<float> expected = m_destination;
+                float* expectedP = at(expected, offsets[(o + 1) % 4]);
+                for (size_t i = 0; i < length; ++i)
+                    expectedP[i * stride] = source1[i * stride] + source2[i * stride];
+
+                float* destination = at(m_destination, offsets[(o + 1) % 4]);
+                vadd(source1, stride, source2, stride, destination, stride, length);
+                for (size_t i = 0; i < bufferSize; ++i)
+                    ASSERT_EQ(expected[i], m_destination[i]) << "length " << length << " offset " << offsets[o] << " stride " << stride;
+            }
+        }
+    }
+}
+
+TEST_F(VectorMathTest, vmul)
+{
+    for (size_t l = 0; l < WTF_ARRAY_LENGTH(lengths); ++l) {
+        for (size_t o = 0; o < WTF_ARRAY_LENGTH(offsets); ++o) {
+            for (size_t s = 0; s < WTF_ARRAY_LENGTH(strides); ++s) {
+                size_t length = lengths[l];
+                int stride = strides[s];
+                const float* source1 = at(m_source1, offsets[o]);
+                const float* source2 = at(m_source2, offsets[o]);
+                Vector<float> expected = m_destination;
+                float* expectedP = at(expected, offsets[(o + 3) % 4]);
+                for (size_t i = 0; i < length; ++i)
+                    expectedP[i * stride] = source1[i * stride] * source2[i * stride];
+
+                float* destination = at(m_destination, offsets[(o + 3) % 4]);
+                vmul(source1, stride, source2, stride, destination, stride, length);
+                for (size_t i = 0; i < bufferSize; ++i)
+                    ASSERT_EQ(expected[i], m_destination[i]) << "length " << length << " offset " << offsets[o] << " stride " << stride;
+            }
+        }
+    }
+}
+
+TEST_F(VectorMathTest, vsma)
+{
+    const float scale = -1.3f;
+    for (size_t l = 0; l < WTF_ARRAY_LENGTH(lengths); ++l) {
+        for (size_t o = 0; o < WTF_ARRAY_LENGTH(offsets); ++o) {
+            for (size_t s = 0; s < WTF_ARRAY_LENGTH(strides); ++s) {
+                size_t length = lengths[l];
+                int stride = strides[s];
+                const float* source = at(m_source1, offsets[o]);
+                Vector<float> expected = m_destination;
+                float* expectedP = at(expected, offsets[(o + 1) % 4]);
+                for (size_t i = 0; i < length; ++i)
+                    expectedP[i * stride] += scale * source[i * stride];
+
+                float* destination = at(m_destination, offsets[(o + 1) % 4]);
+                vsma(source, stride, &scale, destination, stride, length);
+                // A fused multiply-add may round differently.
+                for (size_t i = 0; i < bufferSize; ++i)
+                    ASSERT_NEAR(expected[i], m_destination[i], 1e-6) << "length " << length << " offset " << offsets[o] << " stride " << stride;
+            }
+        }
+    }
+}
+
+TEST_F(VectorMathTest, vmaxmgv)
+{
+    for (size_t l = 0; l < WTF_ARRAY_LENGTH(lengths); ++l) {
+        for (size_t o = 0; o < WTF_ARRAY_LENGTH(offsets); ++o) {
+            for (size_t s = 0; s < WTF_ARRAY_LENGTH(strides); ++s) {
+                size_t length = lengths[l];
+                int stride = strides[s];
+                const float* source = at(m_source1, offsets[o]);
+                float expected = 0;
+                for (size_t i = 0; i < length; ++i)
+                    expected = std::max(expected, fabsf(source[i * stride]));
+
+                float max = -1;
+                vmaxmgv(source, stride, &max, length);
+                ASSERT_EQ(expected, max) << "length " << length << " offset " << offsets[o] << " stride " << stride;
+            }
+        }
+    }
+}
+
+} // namespace
+
+#endif // ENABLE(WEB_AUDIO)
@@ -0,0 +1,36 @@
+# Copyright (C) 2012 The Android Open Source Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+LOCAL_PATH := $(call my-dir)
+include $(CLEAR_VARS)
+
+WEBKIT_SOURCE := $(LOCAL_PATH)/../../../Source
+
+LOCAL_SRC_FILES := \
+	memorycachesim.cpp \
+	../../../Source/JavaScriptCore/wtf/Assertions.cpp \
+	../../../Source/JavaScriptCore/wtf/FastMalloc.cpp \
+	../../../Source/WebCore/loader/cache/MemoryCacheReplacementPolicy.cpp
+
+LOCAL_C_INCLUDES := \
+	$(LOCAL_PATH) \
+	$(WEBKIT_SOURCE)/JavaScriptCore \
+	$(WEBKIT_SOURCE)/JavaScriptCore/wtf \
+	$(WEBKIT_SOURCE)/WebCore/loader/cache
+
+LOCAL_CFLAGS := -DNDEBUG -DUSE_SYSTEM_MALLOC=1
+
+LOCAL_MODULE := memorycachesim
+
+include $(BUILD_HOST_EXECUTABLE)
@@ -0,0 +1,300 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Replays a MemoryCache trace against each replacement policy and reports
+// how many requests and bytes each one would have served from the cache.
+//
+// Record a trace by setting TRACE_MEMORY_CACHE to 1 in MemoryCache.cpp and
+// saving the output of logcat, then run:
+//
+//     memorycachesim <trace file> <capacity in KB> [<capacity in KB> ...]
+//
+// The simulated cache does not know which resources are in use by a page, so
+// every resource can be evicted; it models the dead resource part of the
+// cache, which is what the policy controls.
+//
+// tests/run-tests.sh replays the traces in tests/ and checks the reports.
+
+#include "config.h"
+#include "MemoryCacheReplacementPolicy.h"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <stdlib.h>
+#include <string.h>
+#include <wtf/OwnPtr.h>
+
+using namespace std;
+using WebCore::MemoryCacheReplacementPolicy;
+
+static const char* kTracePrefix = "MemoryCacheTrace: ";
+static const double kTargetPrunePercentage = .95; // Same as MemoryCache.
+
+struct TraceEvent {
+    string event;
+    string url;
+    unsigned encodedSize;
+    unsigned decodedSize;
+};
+
+struct Resource {
+    unsigned size;
+    unsigned accessCount;
+};
+
+// The last sizes traced for a URL. MemoryCache traces "add" before the
+// resource has loaded, so the sizes only arrive with the "size" events that
+// follow, and are kept to account for later requests after an eviction.
+struct KnownSize {
+    unsigned encodedSize;
+    unsigned decodedSize;
+    // The last request was made before any size was known, and is accounted
+    // for when the first one arrives.
+    bool requestPending;
+    bool pendingRequestHit;
+};
+
+struct Result {
+    unsigned long long requests;
+    unsigned long long hits;
+    unsigned long long bytesRequested;
+    unsigned long long bytesSaved;
+    unsigned long long bytesMissed;
+};
+
+static bool readTrace(const char* path, vector<TraceEvent>& events)
+{
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return false;
+    }
+    char line[4096];
+    while (fgets(line, sizeof(line), file)) {
+        const char* trace = strstr(line, kTracePrefix);
+        if (!trace)
+            continue;
+        char event[16];
+        char url[sizeof(line)];
+        TraceEvent traceEvent;
+        if (sscanf(trace + strlen(kTracePrefix), "%15s %4095s %u %u", event, url, &traceEvent.encodedSize, &traceEvent.decodedSize) != 4)
+            continue;
+        traceEvent.event = event;
+        traceEvent.url = url;
+        events.push_back(traceEvent);
+    }
+    fclose(file);
+    return true;
+}
+
+class Simulator {
+public:
+    Simulator(MemoryCacheReplacementPolicy* policy, unsigned capacity)
+        : m_policy(policy)
+        , m_capacity(capacity)
+        , m_size(0)
+    {
+        memset(&m_result, 0, sizeof(m_result));
+    }
+
+    ~Simulator()
+    {
+        for (map<string, Resource*>::iterator it = m_resources.begin(); it != m_resources.end(); ++it)
+            delete it->second;
+    }
+
+    void replay(const TraceEvent& event)
+    {
+        if (event.event == "add" || event.event == "access")
+            request(event);
+        else if (event.event == "size")
+            resize(event);
+        else if (event.event == "remove")
+            remove(event.url);
+        // "evict" records what the traced cache decided, which is what we are
+        // trying to replace.
+    }
+
+    const Result& result() const { return m_result; }
+
+private:
+    void request(const TraceEvent& event)
+    {
+        KnownSize& knownSize = noteSize(event);
+        m_result.requests++;
+
+        map<string, Resource*>::iterator it = m_resources.find(event.url);
+        Resource* resource;
+        bool hit = it != m_resources.end();
+        if (hit) {
+            resource = it->second;
+            m_result.hits++;
+        } else {
+            resource = new Resource;
+            resource->size = 0;
+            resource->accessCount = 0;
+            m_resources[event.url] = resource;
+        }
+
+        knownSize.requestPending = !knownSize.encodedSize;
+        knownSize.pendingRequestHit = hit;
+        if (!knownSize.requestPending)
+            accountBytes(knownSize.encodedSize, hit);
+
+        resource->accessCount++;
+        update(resource, knownSize);
+        prune();
+    }
+
+    void resize(const TraceEvent& event)
+    {
+        KnownSize& knownSize = noteSize(event);
+        if (knownSize.requestPending && knownSize.encodedSize) {
+            knownSize.requestPending = false;
+            accountBytes(knownSize.encodedSize, knownSize.pendingRequestHit);
+        }
+
+        map<string, Resource*>::iterator it = m_resources.find(event.url);
+        if (it == m_resources.end())
+            return;
+        update(it->second, knownSize);
+        prune();
+    }
+
+    KnownSize& noteSize(const TraceEvent& event)
+    {
+        map<string, KnownSize>::iterator it = m_knownSizes.find(event.url);
+        if (it == m_knownSizes.end()) {
+            KnownSize knownSize = { 0, 0, false, false };
+            it = m_knownSizes.insert(make_pair(event.url, knownSize)).first;
+        }
+        // Events are traced with whatever the resource holds at the time,
+        // which is nothing before it loads or after its data was purged.
+        if (event.encodedSize) {
+            it->second.encodedSize = event.encodedSize;
+            it->second.decodedSize = event.decodedSize;
+        }
+        return it->second;
+    }
+
+    void accountBytes(unsigned encodedSize, bool hit)
+    {
+        m_result.bytesRequested += encodedSize;
+        if (hit)
+            m_result.bytesSaved += encodedSize;
+        else
+            m_result.bytesMissed += encodedSize;
+    }
+
+    void update(Resource* resource, const KnownSize& knownSize)
+    {
+        unsigned size = knownSize.encodedSize + knownSize.decodedSize;
+        m_size -= resource->size;
+        m_size += size;
+        resource->size = size;
+        m_policy->resourceUpdated(resource, size,
+            MemoryCacheReplacementPolicy::retrievalCost(knownSize.encodedSize, knownSize.decodedSize), resource->accessCount);
+    }
+
+    void remove(const string& url)
+    {
+        map<string, Resource*>::iterator it = m_resources.find(url);
+        if (it == m_resources.end())
+            return;
+        m_policy->resourceRemoved(it->second);
+        m_size -= it->second->size;
+        delete it->second;
+        m_resources.erase(it);
+    }
+
+    void prune()
+    {
+        if (m_size <= m_capacity)
+            return;
+
+        unsigned long long targetSize = static_cast<unsigned long long>(m_capacity * kTargetPrunePercentage);
+        WTF::Vector<MemoryCacheReplacementPolicy::ResourceID> candidates;
+        map<const void*, string> urls;
+        for (map<string, Resource*>::iterator it = m_resources.begin(); it != m_resources.end(); ++it) {
+            candidates.append(it->second);
+            urls[it->second] = it->first;
+        }
+        m_policy->sortForEviction(candidates);
+
+        for (size_t i = 0; i < candidates.size() && m_size > targetSize; ++i) {
+            m_policy->resourceEvicted(candidates[i]);
+            remove(urls[candidates[i]]);
+        }
+    }
+
+    MemoryCacheReplacementPolicy* m_policy;
+    unsigned long long m_capacity;
+    unsigned long long m_size;
+    map<string, Resource*> m_resources;
+    map<string, KnownSize> m_knownSizes;
+    Result m_result;
+};
+
+static void simulate(MemoryCacheReplacementPolicy* policy, unsigned capacity, const vector<TraceEvent>& events)
+{
+    Simulator simulator(policy, capacity);
+    for (size_t i = 0; i < events.size(); ++i)
+        simulator.replay(events[i]);
+
+    const Result& result = simulator.result();
+    printf("%-6s %8uKB  requests %8llu  hit ratio %6.2f%%  bytes saved %12llu (%6.2f%%)  bytes missed %12llu\n",
+        policy->name(), capacity / 1024, result.requests,
+        result.requests ? 100.0 * result.hits / result.requests : 0,
+        result.bytesSaved,
+        result.bytesRequested ? 100.0 * result.bytesSaved / result.bytesRequested : 0,
+        result.bytesMissed);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <trace file> <capacity in KB> [<capacity in KB> ...]\n", argv[0]);
+        return 1;
+    }
+
+    vector<TraceEvent> events;
+    if (!readTrace(argv[1], events))
+        return 1;
+    if (events.empty()) {
+        fprintf(stderr, "No MemoryCache trace found in %s\n", argv[1]);
+        return 1;
+    }
+
+    for (int i = 2; i < argc; ++i) {
+        unsigned capacity = strtoul(argv[i], 0, 10) * 1024;
+        OwnPtr<MemoryCacheReplacementPolicy> lru = MemoryCacheReplacementPolicy::createLRU();
+        simulate(lru.get(), capacity, events);
+        OwnPtr<MemoryCacheReplacementPolicy> gdsf = MemoryCacheReplacementPolicy::createGreedyDualSizeFrequency();
+        simulate(gdsf.get(), capacity, events);
+    }
+    return 0;
+}
@@ -0,0 +1,36 @@
+#!/bin/sh
+#
+# Copyright (C) 2012 The Android Open Source Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Replays every trace in this directory with a large and a small cache and
+# compares the report with <trace name>-expected.txt.
+#
+# Usage: run-tests.sh <path to memorycachesim>
+
+SIMULATOR=${1:-memorycachesim}
+TESTS=$(dirname "$0")
+FAILED=0
+
+for TRACE in "$TESTS"/*.trace; do
+    EXPECTED="${TRACE%.trace}-expected.txt"
+    if "$SIMULATOR" "$TRACE" 1024 10 | diff -u "$EXPECTED" -; then
+        echo "PASS $(basename "$TRACE")"
+    else
+        echo "FAIL $(basename "$TRACE")"
+        FAILED=1
+    fi
+done
+
+exit $FAILED